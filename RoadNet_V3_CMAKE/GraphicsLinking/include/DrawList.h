@@ -0,0 +1,66 @@
+// DrawList.h - batched 2D quads, lines and disks
+
+#ifndef DRAW_LIST_HDR
+#define DRAW_LIST_HDR
+
+#include <glad.h>
+#include <vector>
+#include "VecMat.h"
+
+class SoftTarget;
+
+// DrawList Class
+//	primitives accumulate in CPU-side vertex arrays; Flush copies them into the shared VertexStream (StreamBuffer.h)
+//	and issues one draw for all solid quads, one per line width, and one for all disks
+//	within a primitive type submission order is kept; across types, quads are drawn first, then lines, then disks
+//	disks are instanced: a quad per disk, sized in pixels, shaded from the distance to its center, so any number
+//	of disks of any size is one draw, not bound by the driver's point size limit
+
+struct DrawListVertex {
+	vec3 position;
+	vec4 color;
+	DrawListVertex(vec3 p = vec3(), vec4 c = vec4()) : position(p), color(c) { }
+};
+
+struct DrawListDisk {
+	vec3 center;
+	float diameter; // pixels
+	vec4 color;
+	float ring;     // 1 if ring, else 0
+	DrawListDisk(vec3 p, float d, vec4 c, float r) : center(p), diameter(d), color(c), ring(r) { }
+};
+
+class DrawList {
+	struct LineBatch {
+		float width = 1;
+		std::vector<DrawListVertex> vertices;
+	};
+	std::vector<DrawListVertex> triangles;
+	std::vector<DrawListDisk> disks;
+	std::vector<LineBatch> lines;
+	int nLineBatches = 0; // lines[0..nLineBatches) in use, kept allocated between flushes
+	GLuint vao = 0, diskVao = 0;
+	int streamGeneration = 0, diskGeneration = 0; // VertexStream generation the vao attributes point into
+	std::vector<DrawListVertex> &LineVertices(float width);
+	int FlushVertices(mat4 view);
+	void FlushDisks(mat4 view);
+	void FlushSoft(SoftTarget &soft, mat4 view);
+public:
+	void Quad(vec3 p1, vec3 p2, vec3 p3, vec3 p4, bool solid, vec3 color, float opacity = 1, float lineWidth = 1);
+	void Quad(float x1, float y1, float x2, float y2, float x3, float y3, float x4, float y4, bool solid, vec3 color, float opacity = 1, float lineWidth = 1);
+	void Rectangle(float x, float y, float w, float h, vec3 color, float opacity = 1);
+	void Line(vec3 p1, vec3 p2, float width, vec3 col1, vec3 col2, float opacity = 1);
+	void Line(vec2 p1, vec2 p2, float width, vec3 col, float opacity = 1);
+	void Disk(vec3 p, float diameter, vec3 color, float opacity = 1, bool ring = false);
+	void Disk(vec2 p, float diameter, vec3 color, float opacity = 1, bool ring = false);
+	int Flush();
+		// draw with the view set by the last UseDrawShader(mat4), then clear; return number of draw calls
+		// (0 when drawing into a software target, see SoftRaster.h)
+	int Flush(mat4 view);
+	void Clear();
+	bool Empty() const;
+	void Release();
+	~DrawList() { Release(); }
+};
+
+#endif
@@ -0,0 +1,69 @@
+// GLState.h - cached uniform/attribute locations and CPU-side copy of bound GL state
+
+#ifndef GL_STATE_HDR
+#define GL_STATE_HDR
+
+#include <glad.h>
+
+// GL State
+//	every program, vertex array, buffer, texture and viewport change made through these routines is remembered,
+//	so a call that would not change anything is skipped and the current value is read back without glGet*
+//	code that calls glUseProgram, glBindTexture, glViewport etc. directly must call InvalidateGLState() afterwards
+//	single context, main thread only
+
+#define GL_STATE_TEXTURE_UNITS 32
+	// texture units tracked; binds on higher units are always issued
+#define GL_STATE_UNIFORM_BYTES 64
+	// largest uniform value (a mat4) compared against the last one set; larger arrays are always issued
+
+struct GLStateCounters {
+	int programs = 0, programsSkipped = 0;      // glUseProgram
+	int uniforms = 0, uniformsSkipped = 0;      // glUniform*
+	int binds = 0, bindsSkipped = 0;            // glBindVertexArray, glBindBuffer, glActiveTexture, glBindTexture
+	int viewports = 0, viewportsSkipped = 0;    // glViewport
+	int lookups = 0, lookupsCached = 0;         // glGetUniformLocation/glGetAttribLocation, and lookups answered from cache
+	int queries = 0;                            // glGet* round trips to learn state not yet known
+	int Issued() const { return programs+uniforms+binds+viewports; }
+	int Skipped() const { return programsSkipped+uniformsSkipped+bindsSkipped+viewportsSkipped; }
+};
+
+GLStateCounters &GLStats();
+void ResetGLStats();
+	// counters accumulate until reset; reset once per frame for per-frame figures
+
+void InvalidateGLState();
+	// forget all tracked bindings and the viewport (locations and uniform values are kept)
+
+// Locations
+GLint UniformLocation(int program, const char *name);
+GLint AttribLocation(int program, const char *name);
+	// -1 if no such active uniform/attribute; misses are cached too
+void ForgetProgram(int program);
+	// drop cached locations and uniform values, call when a program is deleted or relinked
+
+// Uniform Values
+bool UniformChanged(int program, GLint location, const void *value, int nBytes);
+	// true if value differs from the last one recorded for (program, location), which it then becomes
+
+// Bindings
+void UseProgram(int program);
+int BoundProgram();
+void BindVertexArray(GLuint vao);
+void BindBuffer(GLenum target, GLuint buffer);
+	// GL_ARRAY_BUFFER and the pixel pack/unpack buffers are tracked, other targets pass through
+void ActiveTexture(GLenum unit);
+void BindTexture(GLenum target, GLuint texture);
+	// GL_TEXTURE_2D on the active unit is tracked, other targets pass through
+void BindTexture(GLuint unit, GLenum target, GLuint texture);
+	// select unit then bind
+
+// Deletion (clears any tracked binding of the deleted names, which GL resets to 0)
+void DeleteTextures(int n, const GLuint *textures);
+void DeleteBuffers(int n, const GLuint *buffers);
+void DeleteVertexArrays(int n, const GLuint *vaos);
+
+// Viewport
+void SetViewport(int x, int y, int width, int height);
+void GetViewport(int vp[4]);
+
+#endif // GL_STATE_HDR
@@ -53,6 +53,7 @@ GLuint LinkProgramViaFile(const char *computeShaderFile);
 
 // Miscellany
 int CurrentProgram();
+	// as last set through UseProgram (GLState.h)
 void DeleteProgram(int program);
 
 // Binary Read/Write
@@ -61,6 +62,7 @@ bool ReadProgramBinary(GLuint program, const char *filename);
 GLuint ReadProgramBinary(const char *filename);
 
 // Uniforms
+//	locations are cached per program and a value equal to the last one set is not sent again (see GLState.h)
 void SetReport(bool report);
 	// if report, print any unknown uniforms or attributes
 bool SetUniform(int program, const char *name, bool val);
@@ -71,6 +73,7 @@ bool SetUniformv(int program, const char *name, int count, int *v);
 bool SetUniform(int program, const char *name, float val);
 bool SetUniformv(int program, const char *name, int count, float *v);
 bool SetUniform(int program, const char *name, vec2 v);
+bool SetUniform(int program, const char *name, int2 v);
 bool SetUniform(int program, const char *name, vec3 v);
 bool SetUniform(int program, const char *name, vec4 v);
 bool SetUniform(int program, const char *name, vec3 *v);
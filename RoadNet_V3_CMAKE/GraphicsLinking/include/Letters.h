@@ -3,11 +3,43 @@
 #ifndef LETTERS_HDR
 #define LETTERS_HDR
 
+#include <glad.h>
+#include <vector>
 #include "VecMat.h"
 
+#define LETTERS_LAYOUT_CACHE 256
+	// strings whose layout is kept; the cache is emptied when it grows past this
+
 void Letters(int x, int y, const char *s, vec3 color, float ptSize);
 void Letters(vec3 p, mat4 m, const char *s, vec3 color, float ptSize);
 
 // s is any string but only letters, numerals, space, period, or dash, plus-sign, or slash are printed
 
+// TextBatch Class
+//	strings added in screen coordinates, drawn together as one textured triangle list from a single glyph atlas
+//	a string's layout is cached by content, so unchanged strings cost only a copy per frame
+
+struct TextBatchVertex {
+	vec2 point, uv;
+	vec3 color;
+	TextBatchVertex(vec2 p, vec2 t, vec3 c) : point(p), uv(t), color(c) { }
+};
+
+class TextBatch {
+	std::vector<TextBatchVertex> vertices;
+	GLuint vao = 0;
+	int streamGeneration = 0;
+public:
+	void Add(int x, int y, const char *s, vec3 color, float ptSize);
+	int Flush(mat4 view);
+		// draw and clear all added strings; return number of draw calls (0 or 1)
+	void Clear() { vertices.clear(); }
+	bool Empty() { return vertices.empty(); }
+	void Release();
+	~TextBatch() { Release(); }
+};
+
+void LettersLayoutStats(int &hits, int &misses);
+	// layouts reused from the cache and laid out anew, since start
+
 #endif
@@ -0,0 +1,45 @@
+// NullGL.h - glad function table of counting stubs, to measure what a frame asks of the driver without a GPU
+
+#ifndef NULL_GL_HDR
+#define NULL_GL_HDR
+
+#include <glad.h>
+#include <stddef.h>
+
+// Null GL Driver
+//	LoadNullGL fills the glad function table with stubs that render nothing; they hand out names, keep buffer
+//	contents (so mapped and read-back memory is real), answer the queries this code makes, and count each call
+//	no window or GL context is needed, and code above glad (GLState, StreamBuffer, Draw, ...) runs unchanged
+//	entry points the code does not use are left NULL, so calling one fails at once rather than silently
+//	writes into a persistently mapped buffer are not GL calls and are not seen here (see StreamBuffer::BytesMapped)
+//	single thread, like the GL context it replaces
+
+struct NullGLCounters {
+	int calls = 0;                  // every stubbed entry point
+	int draws = 0;                  // glDraw*, glMultiDrawArrays
+	long long vertices = 0;         // vertices drawn, times instances
+	int bufferUploads = 0;          // glBufferData/glBufferStorage with data, glBufferSubData, glMapBufferRange
+	size_t bufferBytes = 0;         // bytes given to those; a persistent map counts once, when made
+	int textureUploads = 0;         // glTexImage*, glTexSubImage*
+	size_t textureBytes = 0;
+	int uniforms = 0;               // glUniform*
+	int stateChanges = 0;           // binds, glUseProgram, glEnable/Disable, blend, viewport, attribute setup
+	int queries = 0;                // glGet*, glIsEnabled
+};
+
+struct NullGLCall {
+	const char *name;
+	int count;
+};
+
+int LoadNullGL();
+	// replace the glad function table, return nonzero on success; call once, instead of InitGLFW
+
+NullGLCounters &NullGLStats();
+void ResetNullGLStats();
+	// counters accumulate until reset; reset once per frame for per-frame figures
+
+int NullGLCalls(const NullGLCall **calls);
+	// per entry point counts since LoadNullGL (not reset by ResetNullGLStats), return number of entry points
+
+#endif // NULL_GL_HDR
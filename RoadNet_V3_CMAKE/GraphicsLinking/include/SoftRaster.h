@@ -0,0 +1,78 @@
+// SoftRaster.h - CPU rasterizer for the Draw.h primitives, into an RGBA8 framebuffer
+
+#ifndef SOFT_RASTER_HDR
+#define SOFT_RASTER_HDR
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "VecMat.h"
+
+// SoftTarget Class
+//	when made current by SetSoftTarget, Disk, Line, Quad, LineStrip, DrawList, Letters/Text and SavePng draw into
+//	and read from this framebuffer instead of OpenGL, so frames can be made without a GPU or a GL context
+//	primitives are queued, in pixel space, as they are drawn; Resolve (or Pixels) bins them by SOFT_TILE square
+//	tiles and rasterizes the tiles on several threads, each tile applying its primitives in submission order; the
+//	helper threads are started by the first Resolve that needs them and kept until the target is destroyed
+//	triangle vertices snap to 1/256 pixel and edges are tested in integers with a top-left rule, so a pixel center
+//	on an edge shared by two triangles is filled by exactly one of them
+//	solid spans are filled 4 pixels at a time (SSE2 where available); line and disk edges are antialiased from
+//	their distance to the pixel center, like the GPU disk shader
+//	pixel rows run bottom to top, as in OpenGL; Pixels() is RGBA, 4 bytes per pixel, row 0 at the bottom
+
+#define SOFT_TILE 64
+
+class SoftTarget {
+public:
+	enum CommandType { Clear_, Triangle_, Line_, Disk_, Glyph_ };
+	struct Command {
+		CommandType type = Clear_;
+		vec2 p[3];
+		vec2 uv[3];
+		vec4 color, color2;
+		float width = 1;
+		bool ring = false;
+		const unsigned char *alpha = NULL; // glyph alpha map
+		int alphaW = 0, alphaH = 0;
+		int x0 = 0, y0 = 0, x1 = 0, y1 = 0; // pixel bounds, x1 and y1 exclusive
+	};
+	SoftTarget() { }
+	SoftTarget(const SoftTarget &) = delete;
+	SoftTarget &operator=(const SoftTarget &) = delete;
+	~SoftTarget();
+	void Resize(int width, int height);
+	int Width() const { return width; }
+	int Height() const { return height; }
+	void SetThreads(int n);
+		// 0 (default): one per hardware thread
+	void SetView(mat4 view);
+		// transform applied to the points of primitives added hereafter, as the view uniform is on the GPU
+	void Clear(vec3 color, float opacity = 1);
+	void Triangle(vec3 p1, vec3 p2, vec3 p3, vec4 color);
+	void Quad(vec3 p1, vec3 p2, vec3 p3, vec3 p4, vec4 color);
+	void Line(vec3 p1, vec3 p2, float width, vec4 col1, vec4 col2);
+	void Disk(vec3 p, float diameter, vec4 color, bool ring = false);
+	void Glyph(vec3 p1, vec3 p2, vec3 p3, vec2 uv1, vec2 uv2, vec2 uv3, vec3 color, const unsigned char *alpha, int w, int h);
+		// triangle whose opacity is 1 minus the single-channel alpha map (w by h, nearest texel) at the interpolated uv
+	int Queued() const { return (int) commands.size(); }
+	void Resolve();
+		// rasterize and drop the queued primitives
+	const unsigned char *Pixels();
+		// resolve, then the framebuffer
+private:
+	int width = 0, height = 0, nThreads = 0;
+	mat4 view;
+	std::vector<unsigned char> pixels;
+	std::vector<Command> commands;
+	struct Workers;
+	Workers *workers = NULL;
+	vec2 Pixel(vec3 p);
+	void Bound(Command &c, vec2 lo, vec2 hi);
+	void Rasterize(const Command &c, int tx0, int ty0, int tx1, int ty1);
+};
+
+SoftTarget *CurrentSoftTarget();
+void SetSoftTarget(SoftTarget *target);
+	// NULL (default) to draw with OpenGL again
+
+#endif
@@ -29,10 +29,11 @@ public:
 	float frameDuration = 1.5f;
 	time_t change;
 	GLuint textureName = 0, matName = 0;
+	bool ownsTexture = true; // false if textureName is shared (atlas region, loader placeholder) and freed by its owner
 	mat4 ptTransform, uvTransform;
 	bool Intersect(Sprite &s);
 	void UpdateTransform();
-	void Initialize(GLuint texName, float z = 0);
+	void Initialize(GLuint texName, float z = 0, bool owns = true);
 	void Initialize(string imageFile, float z = 0);
 	void Initialize(string imageFile, string matFile, float z = 0);
 	void Initialize(vector<string> &imageFiles, string matFile, float z = 0);
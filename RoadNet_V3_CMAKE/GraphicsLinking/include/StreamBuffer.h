@@ -0,0 +1,55 @@
+// StreamBuffer.h - persistently mapped ring of vertex memory for geometry rebuilt every frame
+
+#ifndef STREAM_BUFFER_HDR
+#define STREAM_BUFFER_HDR
+
+#include <glad.h>
+#include <stddef.h>
+
+// StreamBuffer Class
+//	one GL buffer split into STREAM_SEGMENTS segments; each frame writes into the next segment, which is fenced at
+//	EndFrame, so the CPU writes while the GPU still reads the previous frames' segments and waits only if it gets
+//	STREAM_SEGMENTS frames ahead
+//	with GL 4.4 the buffer is created by glBufferStorage and mapped once, persistent and coherent, and vertices are
+//	written straight into it; otherwise each span is mapped unsynchronized and the buffer is orphaned on wrap
+//	a span larger than a segment grows the buffer, which bumps Generation() (vertex arrays that hold the buffer must
+//	re-point their attributes)
+
+#define STREAM_SEGMENTS 3
+#define STREAM_SEGMENT_BYTES (1 << 20)
+
+class StreamBuffer {
+	GLuint buffer = 0;
+	GLbitfield persistentFlags = 0;     // 0 if mapped per span
+	char *mapped = NULL;                // whole buffer, persistent path only
+	size_t segmentBytes = STREAM_SEGMENT_BYTES;
+	int segment = 0;                    // segment being written
+	size_t head = 0;                    // next free byte in that segment
+	GLsync fences[STREAM_SEGMENTS] = {};
+	int generation = 0, stalls = 0;
+	size_t bytesMapped = 0;
+	bool spanMapped = false;
+	void Create();
+	void NextSegment();
+public:
+	void *Map(size_t bytes, size_t align, GLintptr &offset);
+		// bind as GL_ARRAY_BUFFER and reserve bytes at an offset that is a multiple of align (eg, the vertex stride,
+		// so offset/stride can be the first vertex of a draw); write the vertices then call Unmap before drawing
+	void Unmap();
+	void EndFrame();
+		// fence this frame's writes and move to the next segment; call once per frame, after the last draw
+	GLuint Buffer() { return buffer; }
+	int Generation() { return generation; }
+	int Stalls() { return stalls; }
+		// times Map waited on the GPU to free a segment
+	size_t BytesMapped() { return bytesMapped; }
+		// bytes reserved by Map so far, the vertex data streamed to the GPU whether or not the mapping is persistent
+	bool Persistent() { return persistentFlags != 0; }
+	void Release();
+	~StreamBuffer() { Release(); }
+};
+
+StreamBuffer &VertexStream();
+	// ring shared by Draw, DrawList, Text and Letters
+
+#endif
@@ -7,6 +7,7 @@
 #include "glad.h"
 #include "GLFW/glfw3.h"
 #include "GLXtras.h"
+#include "Letters.h"
 
 class Character {
 public:
@@ -40,6 +41,9 @@ void Text(int x, int y, vec3 color, float scale, const char *format, ...);
 void Text(float x, float y, vec3 color, float scale, const char *format, ...);
 	// position null-terminated text at pixel (x, y)
 
+void Text(TextBatch &batch, int x, int y, vec3 color, float scale, const char *format, ...);
+	// add text at pixel (x, y) to batch, drawn when the batch is flushed
+
 void Text(vec3 p, mat4 m, vec3 color, float scale, const char *format, ...);
 	// position text on screen per point p transformed by m
 
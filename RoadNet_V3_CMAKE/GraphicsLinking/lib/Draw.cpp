@@ -1,27 +1,43 @@
 // Draw.cpp - various draw operations (c) 2019-2022 Jules Bloomenthal
 
 #include <glad.h>
-#include <gl/glu.h>
 #include "Draw.h"
+#include "DrawList.h"
+#include "GLState.h"
 #include "GLXtras.h"
+#include "SoftRaster.h"
+#include "StreamBuffer.h"
+#include <algorithm>
 #include <float.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <vector>
 
 // Screen Mode
 
+static void DrawViewport(int vp[4]) {
+	// a software target stands in for the GL viewport
+	if (SoftTarget *soft = CurrentSoftTarget()) {
+		vp[0] = vp[1] = 0;
+		vp[2] = soft->Width();
+		vp[3] = soft->Height();
+	}
+	else
+		GetViewport(vp);
+}
+
 void ViewportSize(int &width, int &height) {
 	int vp[4];
-	glGetIntegerv(GL_VIEWPORT, vp);
+	DrawViewport(vp);
 	width = vp[2];
 	height = vp[3];
 }
 
 vec4 VP() {
-	vec4 vp;
-	glGetFloatv(GL_VIEWPORT, (float *) &vp);
-	return vp;
+	int vp[4];
+	DrawViewport(vp);
+	return vec4((float) vp[0], (float) vp[1], (float) vp[2], (float) vp[3]);
 }
 
 int VPw() {
@@ -36,16 +52,14 @@ int VPh() {
 
 mat4 Viewport() {
 	// map +/-1 space to screen space viewport
-	float vp[4];
-	glGetFloatv(GL_VIEWPORT, vp);
+	vec4 vp = VP();
 	float x = vp[0], y = vp[1], w = vp[2], h = vp[3];
 	return mat4(vec4(w/2,0,0,x+w/2), vec4(0,h/2,0,y+h/2), vec4(0,0,1,0), vec4(0,0,0,1));
 }
 
 mat4 ScreenMode() {
 	// map pixel space (xorigin, yorigin)-(xorigin+width,yorigin+height) to NDC (clip) space (-1,-1)-(1,1)
-	float vp[4];
-	glGetFloatv(GL_VIEWPORT, vp);
+	vec4 vp = VP();
 	float x = vp[0], y = vp[1], w = vp[2], h = vp[3];
 	return Translate(-1, -1, 0)*Scale(2/w, 2/h, 1)*Translate(-x, -y, 0);
 }
@@ -59,7 +73,7 @@ vec2 ScreenPoint(vec3 p, mat4 m, int vp[4], float *zscreen) {
 
 vec2 ScreenPoint(vec3 p, mat4 m, float *zscreen) {
 	int vp[4];
-	glGetIntegerv(GL_VIEWPORT, vp);
+	DrawViewport(vp);
 	return ScreenPoint(p, m, vp, zscreen);
 }
 
@@ -108,48 +122,42 @@ float ScreenD(int x, int y, vec3 p, mat4 m, float *zscreen) {
 	return sqrt(ScreenDSq(x, y, p, m, zscreen));
 }
 
+static bool UnProject(float xscreen, float yscreen, float zscreen, mat4 &inverse, int vp[4], vec3 &p) {
+	// as gluUnProject: window to normalized device coordinates, then by the inverse of persp*modelview
+	vec4 ndc(2*(xscreen-vp[0])/vp[2]-1, 2*(yscreen-vp[1])/vp[3]-1, 2*zscreen-1, 1);
+	vec4 q(dot(inverse[0], ndc), dot(inverse[1], ndc), dot(inverse[2], ndc), dot(inverse[3], ndc));
+	if (q.w == 0)
+		return false;
+	p = vec3(q.x, q.y, q.z)/q.w;
+	return true;
+}
+
+static void UnProjectPair(float xscreen, float yscreen, mat4 modelview, mat4 persp, vec3 &a, vec3 &b) {
+	// un-project two screen points of differing depth
+	int vp[4];
+	DrawViewport(vp);
+	mat4 m = persp*modelview, inverse;
+	bool ok = InverseMatrix4x4(&m[0][0], &inverse[0][0]);
+	if (!ok || !UnProject(xscreen, yscreen, .25f, inverse, vp, a) || !UnProject(xscreen, yscreen, .50f, inverse, vp, b))
+		printf("UnProject false\n");
+}
+
 void ScreenRay(float xscreen, float yscreen, mat4 modelview, mat4 persp, vec3 &p, vec3 &v) {
 	// compute ray from p in direction v; p is transformed eyepoint, xscreen, yscreen determine v
-	int vp[4];
-	glGetIntegerv(GL_VIEWPORT, vp);
 	// origin of ray is always eye (translated origin)
 	p = vec3(modelview[0][3], modelview[1][3], modelview[2][3]);
-	// create transposes for gluUnproject
-	double tpersp[4][4], tmodelview[4][4], a[3], b[3];
-	for (int i = 0; i < 4; i++)
-		for (int j = 0; j < 4; j++) {
-			tmodelview[i][j] = modelview[j][i];
-			tpersp[i][j] = persp[j][i];
-		}
 	// un-project two screen points of differing depth to determine v
-	if (gluUnProject(xscreen, yscreen, .25, (const double*) tmodelview, (const double*) tpersp, vp, &a[0], &a[1], &a[2]) == GL_FALSE)
-		printf("UnProject false\n");
-	if (gluUnProject(xscreen, yscreen, .50, (const double*) tmodelview, (const double*) tpersp, vp, &b[0], &b[1], &b[2]) == GL_FALSE)
-		printf("UnProject false\n");
-	v = normalize(vec3((float) (b[0]-a[0]), (float) (b[1]-a[1]), (float) (b[2]-a[2])));
+	vec3 a, b;
+	UnProjectPair(xscreen, yscreen, modelview, persp, a, b);
+	v = normalize(b-a);
 }
 
 void ScreenLine(float xscreen, float yscreen, mat4 modelview, mat4 persp, vec3 &p1, vec3 &p2) {
 	// compute 3D world space line, given by p1 and p2, that transforms
 	// to a line perpendicular to the screen at (xscreen, yscreen)
-	double tpersp[4][4], tmodelview[4][4], a[3], b[3];
-	// get viewport
-	int vp[4];
-	glGetIntegerv(GL_VIEWPORT, vp);
-	// create transposes
-	for (int i = 0; i < 4; i++)
-		for (int j = 0; j < 4; j++) {
-			tmodelview[i][j] = modelview[j][i];
-			tpersp[i][j] = persp[j][i];
-		}
-	if (gluUnProject(xscreen, yscreen, .25, (const double*) tmodelview, (const double*) tpersp, vp, &a[0], &a[1], &a[2]) == GL_FALSE)
-		printf("UnProject false\n");
-	if (gluUnProject(xscreen, yscreen, .50, (const double*) tmodelview, (const double*) tpersp, vp, &b[0], &b[1], &b[2]) == GL_FALSE)
-		printf("UnProject false\n");
+	UnProjectPair(xscreen, yscreen, modelview, persp, p1, p2);
 		// alternatively, a second point can be determined by transforming the origin by the inverse of modelview
 		// this would yield in world space the camera location, through which all view lines pass
-	p1 = vec3(static_cast<float>(a[0]), static_cast<float>(a[1]), static_cast<float>(a[2]));
-	p2 = vec3(static_cast<float>(b[0]), static_cast<float>(b[1]), static_cast<float>(b[2]));
 }
 
 bool FrontFacing(vec3 base, vec3 vec, mat4 view) {
@@ -223,11 +231,10 @@ const char *drawPShader = R"(
 )";
 
 int UseDrawShader() {
-	int was = 0;
-	glGetIntegerv(GL_CURRENT_PROGRAM, &was);
+	int was = BoundProgram();
 	bool init = !drawShader;
 	if (init) drawShader = LinkProgramViaCode(&drawVShader, &drawPShader);
-	glUseProgram(drawShader);
+	UseProgram(drawShader);
 	if (init) SetUniform(drawShader, "view", mat4());
 	return was;
 }
@@ -239,82 +246,23 @@ int UseDrawShader(mat4 viewMatrix) {
 	return was;
 }
 
-// Disks
+// Disks and Lines
+//	each call is a one-primitive DrawList flushed at once; append to a DrawList instead to share one draw
 
-GLuint diskVBO = 0, diskVAO = 0;
+DrawList immediateDraws;
 
 void Disk(vec2 p, float diameter, vec3 color, float opacity, bool ring) {
 	Disk(vec3(p), diameter, color, opacity, ring);
 }
 
 void Disk(vec3 p, float diameter, vec3 color, float opacity, bool ring) {
-	// diameter should be >= 0, <= 20
-	UseDrawShader();
-	// create buffer for single vertex (x,y,z,r,g,b)
-	if (!diskVBO) {
-		glGenVertexArrays(1, &diskVAO);
-		glGenBuffers(1, &diskVBO);
-		glBindVertexArray(diskVAO);
-		glBindBuffer(GL_ARRAY_BUFFER, diskVBO);
-		glBufferData(GL_ARRAY_BUFFER, 2*sizeof(vec3), NULL, GL_STATIC_DRAW);
-	}
-	glBindVertexArray(diskVAO);
-	glBindBuffer(GL_ARRAY_BUFFER, diskVBO); // set active buffer
-	// allocate buffer memory and load location and color data
-	glBufferSubData(GL_ARRAY_BUFFER, 0, 3*sizeof(float), &p.x);
-	glBufferSubData(GL_ARRAY_BUFFER, 3*sizeof(float), 3*sizeof(float), &color.x);
-	// connect shader inputs
-	VertexAttribPointer(drawShader, "position", 3, 0, (void *) 0);
-	VertexAttribPointer(drawShader, "color", 3, 0, (void *) sizeof(vec3));
-	// draw
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-	SetUniform(drawShader, "opacity", opacity);
-	SetUniform(drawShader, "ring", ring);
-	glPointSize(diameter);
-#ifdef GL_POINT_SMOOTH
-	glEnable(GL_POINT_SMOOTH);
-#endif
-#if !defined(GL_POINT_SMOOTH) && defined(GL_POINT_SPRITE)
-	glEnable(GL_POINT_SPRITE);
-#endif
-#if !defined(GL_POINT_SMOOTH) && !defined(GL_POINT_SPRITE)
-	glEnable(0x8861); // same as GL_POINT_SMOOTH [this is a 4.5 core bug]
-	SetUniform(drawShader, "fadeToCenter", true); // needed if GL_POINT_SMOOTH and GL_POINT_SPRITE fail
-#endif
-	glDrawArrays(GL_POINTS, 0, 1);
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	immediateDraws.Disk(p, diameter, color, opacity, ring);
+	immediateDraws.Flush();
 }
 
-// Lines
-
-GLuint lineVBO = 0, lineVAO = 0;
-
 void Line(vec3 p1, vec3 p2, float width, vec3 col1, vec3 col2, float opacity) {
-	UseDrawShader();
-	// create a vertex buffer for the array
-	vec3 data[] = {p1, p2, col1, col2};
-	if (!lineVBO) {
-		glGenVertexArrays(1, &lineVAO);
-		glGenBuffers(1, &lineVBO);
-		glBindVertexArray(lineVAO);
-		glBindBuffer(GL_ARRAY_BUFFER, lineVBO);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(data), NULL, GL_STATIC_DRAW);
-	}
-	// set active vertex buffer, load location and color data
-	glBindVertexArray(lineVAO);
-	glBindBuffer(GL_ARRAY_BUFFER, lineVBO);
-	glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(data), (void *) data);
-	// connect shader inputs, set uniforms
-	VertexAttribPointer(drawShader, "position", 3, 0, (void *) 0);
-	VertexAttribPointer(drawShader, "color", 3, 0, (void *) (2*sizeof(vec3)));
-	SetUniform(drawShader, "fadeToCenter", false);  // gl_PointCoord fails for lines (instead, use GL_LINE_SMOOTH)
-	SetUniform(drawShader, "opacity", opacity);
-	// draw
-	glLineWidth(width);
-	glDrawArrays(GL_LINES, 0, 2);
-	// cleanup
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	immediateDraws.Line(p1, p2, width, col1, col2, opacity);
+	immediateDraws.Flush();
 }
 
 void Line(vec3 p1, vec3 p2, float width, vec3 col, float opacity) {
@@ -343,8 +291,9 @@ void LineDash(vec3 p1, vec3 p2, float width, vec3 col1, vec3 col2, float opacity
 	vec3 seg = (p2-p1)/nDashes, dash = percentDash*seg;
 	for (int i = 0; i < (int) nDashes; i++) {
 		vec3 start = p1+(float)i*seg;
-		Line(start, start+dash, width, col1, col2, opacity);
+		immediateDraws.Line(start, start+dash, width, col1, col2, opacity);
 	}
+	immediateDraws.Flush();
 }
 
 void LineDot(vec3 p1, vec3 p2, mat4 view, float width, vec3 col, float opacity, int pixelSpacing) {
@@ -353,27 +302,30 @@ void LineDot(vec3 p1, vec3 p2, mat4 view, float width, vec3 col, float opacity,
 	int nDots = (int) (totalLen/(float)pixelSpacing);
 	vec3 d = (p2-p1)/(float)nDots;
 	for (int i = 0; i < nDots; i++)
-		Disk(p1+(float)i*d, width, col);
+		immediateDraws.Disk(p1+(float)i*d, width, col);
+	immediateDraws.Flush();
 }
 
-GLuint lineStripVBO = 0, lineStripVAO = 0;
+GLuint lineStripVAO = 0;
 
 void LineStrip(int nPoints, vec3 *points, vec3 &color, float opacity, float width) {
+	if (SoftTarget *soft = CurrentSoftTarget()) {
+		soft->SetView(drawView);
+		for (int i = 1; i < nPoints; i++)
+			soft->Line(points[i-1], points[i], width, vec4(color, opacity), vec4(color, opacity));
+		return;
+	}
 	int pSize = nPoints*sizeof(vec3);
-	if (!lineStripVBO) {
+	if (!lineStripVAO)
 		glGenVertexArrays(1, &lineStripVAO);
-		glGenBuffers(1, &lineStripVBO);
-		glBindVertexArray(lineStripVAO);
-		glBindBuffer(GL_ARRAY_BUFFER, lineStripVBO);
-		glBufferData(GL_ARRAY_BUFFER, 2*pSize, NULL, GL_STATIC_DRAW);
-	}
-	glBindVertexArray(lineStripVAO);
-	glBindBuffer(GL_ARRAY_BUFFER, lineStripVBO);
-	std::vector<vec3> colors(nPoints, color);
-	glBufferSubData(GL_ARRAY_BUFFER, 0, pSize, points);
-	glBufferSubData(GL_ARRAY_BUFFER, pSize, pSize, colors.data());
-	VertexAttribPointer(drawShader, "position", 3, 0, (void *) 0);
-	VertexAttribPointer(drawShader, "color", 3, 0, (void *) pSize);
+	BindVertexArray(lineStripVAO);
+	GLintptr offset = 0;
+	vec3 *v = (vec3 *) VertexStream().Map(2*pSize, sizeof(vec3), offset);
+	std::copy(points, points+nPoints, v);
+	std::fill(v+nPoints, v+2*nPoints, color);
+	VertexStream().Unmap();
+	VertexAttribPointer(drawShader, "position", 3, 0, (void *) offset);
+	VertexAttribPointer(drawShader, "color", 3, 0, (void *) (offset+pSize));
 	SetUniform(drawShader, "fadeToCenter", false);
 	SetUniform(drawShader, "opacity", opacity);
 	glLineWidth(width);
@@ -382,40 +334,34 @@ void LineStrip(int nPoints, vec3 *points, vec3 &color, float opacity, float widt
 
 // Quads
 
-GLuint quadVBO = 0, quadVAO = 0;
+GLuint quadVAO = 0;
 
 void QuadInner(vec3 p1, vec3 p2, vec3 p3, vec3 p4, bool solid, vec3 col, float opacity, float lineWidth, bool texture = false, GLuint textureName = 0, GLuint textureUnit = 0) {
-#ifndef GL_QUADS
-	Triangle(p1, p2, p3, col, col, col, opacity, !solid, col, lineWidth);
-	Triangle(p1, p3, p4, col, col, col, opacity, !solid, col, lineWidth);
-#else
+	if (!texture) {
+		immediateDraws.Quad(p1, p2, p3, p4, solid, col, opacity, lineWidth);
+		immediateDraws.Flush();
+		return;
+	}
+	// textured quads keep their own path; their texture is on the GPU only, so a software target skips them
+	if (CurrentSoftTarget())
+		return;
 	vec3 data[] = { p1, p2, p3, p4, col, col, col, col };
 	UseDrawShader();
-	if (quadVBO == 0) {
+	if (quadVAO == 0)
 		glGenVertexArrays(1, &quadVAO);
-		glGenBuffers(1, &quadVBO);
-		glBindVertexArray(quadVAO);
-		glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(data), NULL, GL_STATIC_DRAW);
-	}
-	glBindVertexArray(quadVAO);
-	glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
-	glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(data), data);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(data), data, GL_STATIC_DRAW);
-	VertexAttribPointer(drawShader, "position", 3, 0, (void *) 0);
-	VertexAttribPointer(drawShader, "color", 3, 0, (void *) (4*sizeof(vec3)));
+	BindVertexArray(quadVAO);
+	GLintptr offset = 0;
+	memcpy(VertexStream().Map(sizeof(data), sizeof(vec3), offset), data, sizeof(data));
+	VertexStream().Unmap();
+	VertexAttribPointer(drawShader, "position", 3, 0, (void *) offset);
+	VertexAttribPointer(drawShader, "color", 3, 0, (void *) (offset+4*sizeof(vec3)));
 	SetUniform(drawShader, "opacity", opacity);
 	SetUniform(drawShader, "fadeToCenter", false);
 	SetUniform(drawShader, "useTexture", texture);
-	if (texture) {
-		glActiveTexture(GL_TEXTURE0+textureUnit);
-		glBindTexture(GL_TEXTURE_2D, textureName);
-		SetUniform(drawShader, "textureImage", textureUnit);
-	}
-	glLineWidth(lineWidth);
-	glDrawArrays(solid? GL_QUADS : GL_LINE_LOOP, 0, 4);
+	BindTexture(textureUnit, GL_TEXTURE_2D, textureName);
+	SetUniform(drawShader, "textureImage", textureUnit);
+	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
 	SetUniform(drawShader, "useTexture", false);
-#endif
 }
 
 void Quad(vec3 p1, vec3 p2, vec3 p3, vec3 p4, bool solid, vec3 col, float opacity, float lineWidth) {
@@ -565,7 +511,7 @@ void Cylinder(vec3 p1, vec3 p2, float r1, float r2, mat4 modelview, mat4 persp,
 	if (!cylinderShader)
 		cylinderShader = LinkProgramViaCode(&vShader, &tcShader, &teShader, NULL, &pShader);
 	//	cylinderShader = LinkProgramViaCode(&vShader, NULL, &teShader, NULL, &pShader);
-	glUseProgram(cylinderShader);
+	UseProgram(cylinderShader);
 	SetUniform(cylinderShader, "modelview", modelview);
 	SetUniform(cylinderShader, "persp", persp);
 	SetUniform(cylinderShader, "color", color);
@@ -584,7 +530,7 @@ void Cylinder(vec3 p1, vec3 p2, float r1, float r2, mat4 modelview, mat4 persp,
 
 // Triangles with optional outline
 
-GLuint triShader = 0, triVBO = 0, triVAO = 0;
+GLuint triShader = 0, triVAO = 0;
 
 // vertex shader
 const char *triVShaderCode = R"(
@@ -660,7 +606,7 @@ const char *triPShaderCode = R"(
 	bool init = triShader == 0;
 	if (init)
 		triShader = LinkProgramViaCode(&triVShaderCode, NULL, NULL, &triGShaderCode, &triPShaderCode);
-	glUseProgram(triShader);
+	UseProgram(triShader);
 	if (init)
 		SetUniform(triShader, "view", mat4());
 	glEnable(GL_BLEND);
@@ -677,19 +623,14 @@ void Triangle(vec3 p1, vec3 p2, vec3 p3, vec3 c1, vec3 c2, vec3 c3,
 			  float opacity, bool outline, vec4 outlineCol, float outlineWidth, float transition) {
 	vec3 data[] = { p1, p2, p3, c1, c2, c3 };
 	UseTriangleShader();
-	if (triVBO == 0) {
+	if (triVAO == 0)
 		glGenVertexArrays(1, &triVAO);
-		glGenBuffers(1, &triVBO);
-		glBindVertexArray(triVAO);
-		glBindBuffer(GL_ARRAY_BUFFER, triVBO);
-		glBufferData(GL_ARRAY_BUFFER, 3*sizeof(vec3), NULL, GL_STATIC_DRAW);
-	}
-	glBindVertexArray(triVAO);
-	glBindBuffer(GL_ARRAY_BUFFER, triVBO);
-	glBufferSubData(GL_ARRAY_BUFFER, 0, 3*sizeof(vec3), data);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(data), data, GL_STATIC_DRAW);
-	VertexAttribPointer(triShader, "point", 3, 0, (void *) 0);
-	VertexAttribPointer(triShader, "color", 3, 0, (void *) (3*sizeof(vec3)));
+	BindVertexArray(triVAO);
+	GLintptr offset = 0;
+	memcpy(VertexStream().Map(sizeof(data), sizeof(vec3), offset), data, sizeof(data));
+	VertexStream().Unmap();
+	VertexAttribPointer(triShader, "point", 3, 0, (void *) offset);
+	VertexAttribPointer(triShader, "color", 3, 0, (void *) (offset+3*sizeof(vec3)));
 	SetUniform(triShader, "viewptM", Viewport()); // **** ????
 	SetUniform(triShader, "opacity", opacity);
 	SetUniform(triShader, "outlineOn", outline? 1 : 0);
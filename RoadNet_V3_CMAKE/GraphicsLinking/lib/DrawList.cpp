@@ -0,0 +1,302 @@
+// DrawList.cpp - batched 2D quads, lines and disks
+
+#include <glad.h>
+#include "DrawList.h"
+#include "GLState.h"
+#include "GLXtras.h"
+#include "SoftRaster.h"
+#include "StreamBuffer.h"
+#include <algorithm>
+#include <stddef.h>
+
+extern mat4 drawView; // set by UseDrawShader(mat4), see Draw.cpp
+
+// DrawList Shader
+//	same look as the Draw.cpp shader, but color and opacity are per vertex so one draw can mix them
+
+int drawListShader = 0;
+
+const char *drawListVShader = R"(
+	#version 410 core
+	in vec3 position;
+	in vec4 color;
+	out vec4 vColor;
+	uniform mat4 view;
+	void main() {
+		gl_Position = view*vec4(position, 1);
+		vColor = color;
+	}
+)";
+
+const char *drawListPShader = R"(
+	#version 410 core
+	in vec4 vColor;
+	out vec4 pColor;
+	void main() {
+		pColor = vColor;
+	}
+)";
+
+static int UseDrawListShader() {
+	if (!drawListShader)
+		drawListShader = LinkProgramViaCode(&drawListVShader, &drawListPShader);
+	UseProgram(drawListShader);
+	return drawListShader;
+}
+
+// Disk Shader
+//	one instance per disk: the vertex id picks a corner of a quad one pixel larger than the disk around the
+//	projected center; the fragment's distance from the center, in pixels, gives one pixel of antialiased edge
+
+int diskShader = 0;
+
+const char *diskVShader = R"(
+	#version 410 core
+	in vec4 centerDiameter;
+	in vec4 color;
+	in float ring;
+	out vec4 vColor;
+	out vec2 vPixel;
+	out float vRadius;
+	out float vRing;
+	uniform mat4 view;
+	uniform vec2 pixelToClip; // 2/viewport size
+	void main() {
+		vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1)*2-1;
+		vRadius = .5*centerDiameter.w;
+		vPixel = corner*(vRadius+1);
+		vec4 c = view*vec4(centerDiameter.xyz, 1);
+		gl_Position = c+vec4(vPixel*pixelToClip*c.w, 0, 0);
+		vColor = color;
+		vRing = ring;
+	}
+)";
+
+const char *diskPShader = R"(
+	#version 410 core
+	in vec4 vColor;
+	in vec2 vPixel;
+	in float vRadius;
+	in float vRing;
+	out vec4 pColor;
+	void main() {
+		float d = length(vPixel);
+		float o = vColor.a*clamp(vRadius-d+.5, 0, 1);
+		if (vRing > .5)
+			o *= clamp(d-.8*vRadius+.5, 0, 1);
+		if (o <= 0)
+			discard;
+		pColor = vec4(vColor.rgb, o);
+	}
+)";
+
+static int UseDiskShader() {
+	if (!diskShader)
+		diskShader = LinkProgramViaCode(&diskVShader, &diskPShader);
+	UseProgram(diskShader);
+	return diskShader;
+}
+
+// Appending
+
+std::vector<DrawListVertex> &DrawList::LineVertices(float width) {
+	for (int i = 0; i < nLineBatches; i++)
+		if (lines[i].width == width)
+			return lines[i].vertices;
+	if (nLineBatches == (int) lines.size())
+		lines.emplace_back();
+	LineBatch &b = lines[nLineBatches++];
+	b.width = width;
+	b.vertices.clear();
+	return b.vertices;
+}
+
+void DrawList::Quad(vec3 p1, vec3 p2, vec3 p3, vec3 p4, bool solid, vec3 color, float opacity, float lineWidth) {
+	vec4 c(color, opacity);
+	if (solid) {
+		DrawListVertex v1(p1, c), v2(p2, c), v3(p3, c), v4(p4, c);
+		DrawListVertex quad[] = {v1, v2, v3, v1, v3, v4};
+		triangles.insert(triangles.end(), quad, quad+6);
+	}
+	else {
+		std::vector<DrawListVertex> &v = LineVertices(lineWidth);
+		vec3 corners[] = {p1, p2, p3, p4};
+		for (int i = 0; i < 4; i++) {
+			v.emplace_back(corners[i], c);
+			v.emplace_back(corners[(i+1)%4], c);
+		}
+	}
+}
+
+void DrawList::Quad(float x1, float y1, float x2, float y2, float x3, float y3, float x4, float y4, bool solid, vec3 color, float opacity, float lineWidth) {
+	Quad(vec3(x1, y1, 0), vec3(x2, y2, 0), vec3(x3, y3, 0), vec3(x4, y4, 0), solid, color, opacity, lineWidth);
+}
+
+void DrawList::Rectangle(float x, float y, float w, float h, vec3 color, float opacity) {
+	Quad(x, y, x, y+h, x+w, y+h, x+w, y, true, color, opacity);
+}
+
+void DrawList::Line(vec3 p1, vec3 p2, float width, vec3 col1, vec3 col2, float opacity) {
+	std::vector<DrawListVertex> &v = LineVertices(width);
+	v.emplace_back(p1, vec4(col1, opacity));
+	v.emplace_back(p2, vec4(col2, opacity));
+}
+
+void DrawList::Line(vec2 p1, vec2 p2, float width, vec3 col, float opacity) {
+	Line(vec3(p1), vec3(p2), width, col, col, opacity);
+}
+
+void DrawList::Disk(vec3 p, float diameter, vec3 color, float opacity, bool ring) {
+	disks.emplace_back(p, diameter, vec4(color, opacity), ring? 1.f : 0.f);
+}
+
+void DrawList::Disk(vec2 p, float diameter, vec3 color, float opacity, bool ring) {
+	Disk(vec3(p), diameter, color, opacity, ring);
+}
+
+// Flushing
+
+int DrawList::Flush() {
+	return Flush(drawView);
+}
+
+int DrawList::Flush(mat4 view) {
+	if (Empty())
+		return 0;
+	if (SoftTarget *soft = CurrentSoftTarget()) {
+		FlushSoft(*soft, view);
+		Clear();
+		return 0;
+	}
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	int nDraws = FlushVertices(view);
+	if (!disks.empty()) {
+		FlushDisks(view);
+		nDraws++;
+	}
+	Clear();
+	return nDraws;
+}
+
+int DrawList::FlushVertices(mat4 view) {
+	// copy quads and lines into the stream: triangles, then each line width
+	size_t nVertices = triangles.size();
+	for (int i = 0; i < nLineBatches; i++)
+		nVertices += lines[i].vertices.size();
+	if (!nVertices)
+		return 0;
+	GLsizei stride = sizeof(DrawListVertex);
+	StreamBuffer &stream = VertexStream();
+	GLintptr offset = 0;
+	DrawListVertex *v = (DrawListVertex *) stream.Map(nVertices*stride, stride, offset);
+	v = std::copy(triangles.begin(), triangles.end(), v);
+	for (int i = 0; i < nLineBatches; i++)
+		v = std::copy(lines[i].vertices.begin(), lines[i].vertices.end(), v);
+	stream.Unmap();
+	UseDrawListShader();
+	if (!vao)
+		glGenVertexArrays(1, &vao);
+	BindVertexArray(vao);
+	if (streamGeneration != stream.Generation()) {
+		// attributes point at the start of the stream, each flush draws from its own first vertex
+		BindBuffer(GL_ARRAY_BUFFER, stream.Buffer());
+		VertexAttribPointer(drawListShader, "position", 3, stride, (void *) offsetof(DrawListVertex, position));
+		VertexAttribPointer(drawListShader, "color", 4, stride, (void *) offsetof(DrawListVertex, color));
+		streamGeneration = stream.Generation();
+	}
+	SetUniform(drawListShader, "view", view);
+	int nDraws = 0, first = (int) (offset/stride);
+	if (!triangles.empty()) {
+		glDrawArrays(GL_TRIANGLES, first, (GLsizei) triangles.size());
+		first += (int) triangles.size();
+		nDraws++;
+	}
+	for (int i = 0; i < nLineBatches; i++) {
+		int n = (int) lines[i].vertices.size();
+		if (!n)
+			continue;
+		glLineWidth(lines[i].width);
+		glDrawArrays(GL_LINES, first, n);
+		first += n;
+		nDraws++;
+	}
+	return nDraws;
+}
+
+void DrawList::FlushDisks(mat4 view) {
+	GLsizei stride = sizeof(DrawListDisk);
+	StreamBuffer &stream = VertexStream();
+	GLintptr offset = 0;
+	std::copy(disks.begin(), disks.end(), (DrawListDisk *) stream.Map(disks.size()*stride, stride, offset));
+	stream.Unmap();
+	UseDiskShader();
+	if (!diskVao)
+		glGenVertexArrays(1, &diskVao);
+	BindVertexArray(diskVao);
+	// without base instance (before GL 4.2) the instance attributes are re-pointed at each flush's records
+	bool baseInstance = glDrawArraysInstancedBaseInstance != NULL;
+	GLintptr base = baseInstance? 0 : offset;
+	if (diskGeneration != stream.Generation() || !baseInstance) {
+		BindBuffer(GL_ARRAY_BUFFER, stream.Buffer());
+		const char *names[] = {"centerDiameter", "color", "ring"};
+		int sizes[] = {4, 4, 1};
+		size_t offsets[] = {offsetof(DrawListDisk, center), offsetof(DrawListDisk, color), offsetof(DrawListDisk, ring)};
+		for (int i = 0; i < 3; i++) {
+			GLint id = AttribLocation(diskShader, names[i]);
+			if (id < 0)
+				continue;
+			glEnableVertexAttribArray(id);
+			glVertexAttribPointer(id, sizes[i], GL_FLOAT, GL_FALSE, stride, (void *) (base+offsets[i]));
+			glVertexAttribDivisor(id, 1);
+		}
+		diskGeneration = stream.Generation();
+	}
+	int vp[4];
+	GetViewport(vp);
+	SetUniform(diskShader, "view", view);
+	SetUniform(diskShader, "pixelToClip", vec2(2.f/vp[2], 2.f/vp[3]));
+	GLsizei nDisks = (GLsizei) disks.size();
+	if (baseInstance)
+		glDrawArraysInstancedBaseInstance(GL_TRIANGLE_STRIP, 0, 4, nDisks, (GLuint) (offset/stride));
+	else
+		glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, nDisks);
+}
+
+void DrawList::FlushSoft(SoftTarget &soft, mat4 view) {
+	// same order as the GL path: triangles, lines by width, disks
+	soft.SetView(view);
+	for (size_t i = 0; i+2 < triangles.size(); i += 3)
+		soft.Triangle(triangles[i].position, triangles[i+1].position, triangles[i+2].position, triangles[i].color);
+	for (int b = 0; b < nLineBatches; b++) {
+		std::vector<DrawListVertex> &v = lines[b].vertices;
+		for (size_t i = 0; i+1 < v.size(); i += 2)
+			soft.Line(v[i].position, v[i+1].position, lines[b].width, v[i].color, v[i+1].color);
+	}
+	for (const DrawListDisk &d : disks)
+		soft.Disk(d.center, d.diameter, d.color, d.ring > .5f);
+}
+
+void DrawList::Clear() {
+	triangles.clear();
+	disks.clear();
+	for (int i = 0; i < nLineBatches; i++)
+		lines[i].vertices.clear();
+	nLineBatches = 0;
+}
+
+bool DrawList::Empty() const {
+	if (!triangles.empty() || !disks.empty())
+		return false;
+	for (int i = 0; i < nLineBatches; i++)
+		if (!lines[i].vertices.empty())
+			return false;
+	return true;
+}
+
+void DrawList::Release() {
+	if (vao) DeleteVertexArrays(1, &vao);
+	if (diskVao) DeleteVertexArrays(1, &diskVao);
+	vao = diskVao = 0;
+	streamGeneration = diskGeneration = 0;
+}
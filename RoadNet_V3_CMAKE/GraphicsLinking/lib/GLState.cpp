@@ -0,0 +1,236 @@
+// GLState.cpp - cached uniform/attribute locations and CPU-side copy of bound GL state
+
+#include <glad.h>
+#include "GLState.h"
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <unordered_map>
+
+namespace {
+
+const GLuint unknown = 0xFFFFFFFF; // binding not yet seen, or invalidated: next change is always issued
+
+GLStateCounters counters;
+
+// Locations
+//	keyed by a hash of (kind, program, name); the name is kept to catch the rare collision, which is then looked up uncached
+
+struct Location {
+	int program;
+	std::string name;
+	GLint location;
+};
+
+std::unordered_map<uint64_t, Location> locations;
+
+uint64_t LocationKey(char kind, int program, const char *name) {
+	uint64_t h = 14695981039346656037ull; // FNV-1a
+	h = (h^(uint64_t) kind)*1099511628211ull;
+	h = (h^(uint64_t) (uint32_t) program)*1099511628211ull;
+	for (const char *c = name; *c; c++)
+		h = (h^(uint64_t) (unsigned char) *c)*1099511628211ull;
+	return h;
+}
+
+GLint Lookup(char kind, int program, const char *name) {
+	uint64_t key = LocationKey(kind, program, name);
+	auto it = locations.find(key);
+	if (it != locations.end() && it->second.program == program && it->second.name == name) {
+		counters.lookupsCached++;
+		return it->second.location;
+	}
+	counters.lookups++;
+	GLint location = kind == 'u'? glGetUniformLocation(program, name) : glGetAttribLocation(program, name);
+	if (it == locations.end())
+		locations.emplace(key, Location{program, name, location});
+	return location;
+}
+
+// Uniform Values
+
+struct UniformValue {
+	int nBytes = 0;
+	unsigned char bytes[GL_STATE_UNIFORM_BYTES];
+};
+
+std::unordered_map<uint64_t, UniformValue> uniformValues;
+
+uint64_t UniformKey(int program, GLint location) {
+	return ((uint64_t) (uint32_t) program << 32) | (uint32_t) location;
+}
+
+// Bindings
+
+int program = -1;
+GLuint vertexArray = unknown, arrayBuffer = unknown, packBuffer = unknown, unpackBuffer = unknown;
+GLuint activeUnit = unknown, textures[GL_STATE_TEXTURE_UNITS];
+int viewport[4];
+bool viewportKnown = false;
+
+GLuint *TrackedBuffer(GLenum target) {
+	switch (target) {
+		case GL_ARRAY_BUFFER: return &arrayBuffer;
+		case GL_PIXEL_PACK_BUFFER: return &packBuffer;
+		case GL_PIXEL_UNPACK_BUFFER: return &unpackBuffer;
+	}
+	return NULL;
+}
+
+GLuint *TrackedTexture(GLenum target) {
+	return target == GL_TEXTURE_2D && activeUnit < GL_STATE_TEXTURE_UNITS? &textures[activeUnit] : NULL;
+}
+
+// Bind Tracked
+//	issue bind only if *tracked (when tracked at all) differs from name
+
+template<typename Bind>
+void BindTracked(GLuint *tracked, GLuint name, Bind bind) {
+	if (tracked && *tracked == name) {
+		counters.bindsSkipped++;
+		return;
+	}
+	bind();
+	counters.binds++;
+	if (tracked)
+		*tracked = name;
+}
+
+struct Initializer {
+	Initializer() { InvalidateGLState(); }
+} initializer;
+
+} // end namespace
+
+GLStateCounters &GLStats() { return counters; }
+
+void ResetGLStats() { counters = GLStateCounters(); }
+
+void InvalidateGLState() {
+	program = -1;
+	vertexArray = arrayBuffer = packBuffer = unpackBuffer = activeUnit = unknown;
+	for (int i = 0; i < GL_STATE_TEXTURE_UNITS; i++)
+		textures[i] = unknown;
+	viewportKnown = false;
+}
+
+// Locations
+
+GLint UniformLocation(int program, const char *name) { return Lookup('u', program, name); }
+
+GLint AttribLocation(int program, const char *name) { return Lookup('a', program, name); }
+
+void ForgetProgram(int p) {
+	for (auto it = locations.begin(); it != locations.end();)
+		it = it->second.program == p? locations.erase(it) : ++it;
+	for (auto it = uniformValues.begin(); it != uniformValues.end();)
+		it = (int) (it->first >> 32) == p? uniformValues.erase(it) : ++it;
+	if (program == p)
+		program = -1;
+}
+
+// Uniform Values
+
+bool UniformChanged(int program, GLint location, const void *value, int nBytes) {
+	uint64_t key = UniformKey(program, location);
+	if (nBytes > GL_STATE_UNIFORM_BYTES) {
+		uniformValues.erase(key);
+		counters.uniforms++;
+		return true;
+	}
+	UniformValue &v = uniformValues[key];
+	if (v.nBytes == nBytes && !memcmp(v.bytes, value, nBytes)) {
+		counters.uniformsSkipped++;
+		return false;
+	}
+	v.nBytes = nBytes;
+	memcpy(v.bytes, value, nBytes);
+	counters.uniforms++;
+	return true;
+}
+
+// Bindings
+
+void UseProgram(int p) {
+	if (program == p) {
+		counters.programsSkipped++;
+		return;
+	}
+	glUseProgram(p);
+	counters.programs++;
+	program = p;
+}
+
+int BoundProgram() {
+	if (program < 0) {
+		glGetIntegerv(GL_CURRENT_PROGRAM, &program);
+		counters.queries++;
+	}
+	return program;
+}
+
+void BindVertexArray(GLuint vao) {
+	BindTracked(&vertexArray, vao, [vao]() { glBindVertexArray(vao); });
+}
+
+void BindBuffer(GLenum target, GLuint buffer) {
+	BindTracked(TrackedBuffer(target), buffer, [target, buffer]() { glBindBuffer(target, buffer); });
+}
+
+void ActiveTexture(GLenum unit) {
+	BindTracked(&activeUnit, unit-GL_TEXTURE0, [unit]() { glActiveTexture(unit); });
+}
+
+void BindTexture(GLenum target, GLuint texture) {
+	BindTracked(TrackedTexture(target), texture, [target, texture]() { glBindTexture(target, texture); });
+}
+
+void BindTexture(GLuint unit, GLenum target, GLuint texture) {
+	ActiveTexture(GL_TEXTURE0+unit);
+	BindTexture(target, texture);
+}
+
+// Deletion
+
+void DeleteTextures(int n, const GLuint *names) {
+	for (int i = 0; i < n; i++)
+		for (GLuint &t : textures)
+			if (t == names[i]) t = 0;
+	glDeleteTextures(n, names);
+}
+
+void DeleteBuffers(int n, const GLuint *names) {
+	for (int i = 0; i < n; i++)
+		for (GLuint *b : {&arrayBuffer, &packBuffer, &unpackBuffer})
+			if (*b == names[i]) *b = 0;
+	glDeleteBuffers(n, names);
+}
+
+void DeleteVertexArrays(int n, const GLuint *names) {
+	for (int i = 0; i < n; i++)
+		if (vertexArray == names[i]) vertexArray = 0;
+	glDeleteVertexArrays(n, names);
+}
+
+// Viewport
+
+void SetViewport(int x, int y, int width, int height) {
+	if (viewportKnown && viewport[0] == x && viewport[1] == y && viewport[2] == width && viewport[3] == height) {
+		counters.viewportsSkipped++;
+		return;
+	}
+	glViewport(x, y, width, height);
+	counters.viewports++;
+	viewport[0] = x; viewport[1] = y; viewport[2] = width; viewport[3] = height;
+	viewportKnown = true;
+}
+
+void GetViewport(int vp[4]) {
+	if (!viewportKnown) {
+		glGetIntegerv(GL_VIEWPORT, viewport);
+		counters.queries++;
+		viewportKnown = true;
+	}
+	for (int i = 0; i < 4; i++)
+		vp[i] = viewport[i];
+}
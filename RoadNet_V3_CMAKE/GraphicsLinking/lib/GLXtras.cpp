@@ -1,8 +1,8 @@
 // GLXtras.cpp - GLSL support (c) 2019-2022 Jules Bloomenthal
 
 #include <glad.h>
-#include <gl/glu.h>
 #include "GLXtras.h"
+#include "GLState.h"
 #include <stdio.h>
 #include <string.h>
 #include <time.h>
@@ -10,97 +10,22 @@
 
 namespace {
 
-GLFWwindow *w = NULL;
-
-bool GetKey(int button) { return glfwGetKey(w, button) == GLFW_PRESS; }
-
-MouseMoveCallback mmcb = NULL;
-MouseButtonCallback mbcb = NULL;
-MouseWheelCallback mwcb = NULL;
-ResizeCallback rcb = NULL;
-KeyboardCallback kcb = NULL;
-
-double InvertY(GLFWwindow *w, double y) {
-	// given y wrt upper left, return wrt lower left
-	int h;
-	glfwGetFramebufferSize(w, NULL, &h);
-	return h-y;
-}
-
-void MouseButton(GLFWwindow *w, int butn, int action, int mods) {
-	vec2 v = MouseCoords();
-	mbcb(v.x, v.y, butn == GLFW_MOUSE_BUTTON_LEFT, action == GLFW_PRESS);
-}
-
-void MouseMove(GLFWwindow *w, double x, double y) {
-	bool leftDown = glfwGetMouseButton(w, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS;
-	bool rightDown = glfwGetMouseButton(w, GLFW_MOUSE_BUTTON_RIGHT) == GLFW_PRESS;
-	mmcb((float) x, (float) InvertY(w, y), leftDown, rightDown);
-}
-
-void MouseWheel(GLFWwindow *w, double ignore, double spin) { mwcb((float) spin); }
-
-void Resize(GLFWwindow *w, int width, int height) { rcb(width, height); }
-
-void Keyboard(GLFWwindow *w, int key, int scancode, int action, int mods) {
-	kcb(key, action == GLFW_PRESS, mods & GLFW_MOD_SHIFT, mods & GLFW_MOD_CONTROL);
+const char *ErrorString(GLenum n) {
+	// as gluErrorString, without linking GLU
+	switch (n) {
+		case GL_INVALID_ENUM: return "invalid enumerant";
+		case GL_INVALID_VALUE: return "invalid value";
+		case GL_INVALID_OPERATION: return "invalid operation";
+		case GL_INVALID_FRAMEBUFFER_OPERATION: return "invalid framebuffer operation";
+		case GL_OUT_OF_MEMORY: return "out of memory";
+		case GL_STACK_OVERFLOW: return "stack overflow";
+		case GL_STACK_UNDERFLOW: return "stack underflow";
+	}
+	return "unknown error";
 }
 
 } // end namespace
 
-GLFWwindow *InitGLFW(int x, int y, int width, int height, const char *title, bool aa) {
-	glfwInit();
-	if (aa) glfwWindowHint(GLFW_SAMPLES, 4);
-	#ifdef __APPLE__
-		glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-		glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-		glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-		glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
-	#endif
-	w = glfwCreateWindow(width, height, title, NULL, NULL);
-	glfwSetWindowPos(w, x, y);
-	glfwMakeContextCurrent(w);
-	glfwSwapInterval(1);
-	gladLoadGLLoader((GLADloadproc) glfwGetProcAddress);
-	return w;
-}
-
-vec2 MouseCoords() {
-	// return mouse coords wrt lower left
-	double x, y;
-	glfwGetCursorPos(w, &x, &y);
-	return vec2((float) x, (float) InvertY(w, y));
-}
-
-bool Shift() { return GetKey(GLFW_KEY_LEFT_SHIFT) || GetKey(GLFW_KEY_RIGHT_SHIFT); }
-
-bool Control() { return GetKey(GLFW_KEY_LEFT_CONTROL) || GetKey(GLFW_KEY_RIGHT_CONTROL); }
-
-void RegisterMouseButton(MouseButtonCallback cb) {
-	mbcb = cb;
-	glfwSetMouseButtonCallback(w, MouseButton);
-}
-
-void RegisterMouseMove(MouseMoveCallback cb) {
-	mmcb = cb;
-	glfwSetCursorPosCallback(w, MouseMove);
-}
-
-void RegisterMouseWheel(MouseWheelCallback cb) {
-	mwcb = cb;
-	glfwSetScrollCallback(w, MouseWheel);
-}
-
-void RegisterResize(ResizeCallback cb) {
-	rcb = cb;
-	glfwSetFramebufferSizeCallback(w, Resize);
-}
-
-void RegisterKeyboard(KeyboardCallback cb) {
-	kcb = cb;
-	glfwSetKeyCallback(w, Keyboard);
-}
-
 // Print OpenGL, GLSL Details
 
 int PrintGLErrors(const char *title) {
@@ -111,7 +36,7 @@ int PrintGLErrors(const char *title) {
 		GLenum n = glGetError();
 		if (n == GL_NO_ERROR)
 			break;
-		sprintf(buf+strlen(buf), "%s%s", !nErrors++? "" : ", ", gluErrorString(n));
+		sprintf(buf+strlen(buf), "%s%s", !nErrors++? "" : ", ", ErrorString(n));
 			// do not call Debug() while looping through errors, so accumulate in buf
 	}
 	if (nErrors) {
@@ -281,6 +206,7 @@ void LinkProgramViaCode(GLuint computeProgram, const char **computeCode) {
 	GLuint computeShader = CompileShaderViaCode(computeCode, GL_COMPUTE_SHADER);
 	glAttachShader(computeProgram, computeShader);
 	glLinkProgram(computeProgram);
+	ForgetProgram(computeProgram); // linking resets uniforms
 	glDetachShader(computeProgram, computeShader);
 	glDeleteShader(computeShader);
 	GLint status;
@@ -301,6 +227,7 @@ GLuint LinkProgramViaFile(const char *computeShaderFile) {
 	GLuint program = glCreateProgram();
 	glAttachShader(program, cshader);
 	glLinkProgram(program);
+	ForgetProgram(program); // name may be reused from a program deleted directly
 	GLint status;
 	glGetProgramiv(program, GL_LINK_STATUS, &status);
 	if (status == GL_FALSE) PrintProgramLog(program);
@@ -325,6 +252,7 @@ GLuint LinkProgram(GLuint vshader, GLuint tcshader, GLuint teshader, GLuint gsha
 		glAttachShader(program, pshader);
 		// link and verify
 		glLinkProgram(program);
+		ForgetProgram(program); // name may be reused from a program deleted directly
 		GLint status;
 		glGetProgramiv(program, GL_LINK_STATUS, &status);
 		if (status == GL_FALSE) PrintProgramLog(program);
@@ -341,9 +269,7 @@ GLuint LinkProgramViaFile(const char *vertexShaderFile, const char *pixelShaderF
 // Miscellany
 
 int CurrentProgram() {
-	int program = 0;
-	glGetIntegerv(GL_CURRENT_PROGRAM, &program);
-	return program;
+	return BoundProgram(); // tracked, no glGet once known
 }
 
 void DeleteProgram(int program) {
@@ -353,6 +279,7 @@ void DeleteProgram(int program) {
 	glGetAttachedShaders(program, nShaders, NULL, shaderNames);
 	for (int i = 0; i < nShaders; i++)
 		glDeleteShader(shaderNames[i]);
+	ForgetProgram(program);
 	glDeleteProgram(program);
 }
 
@@ -386,6 +313,7 @@ bool ReadProgramBinary(GLuint program, const char *filename) {
 		fread((char *) &data[0], 1, sizeBinary, in);
 		fclose(in);
 		glProgramBinary(program, binaryFormat, &data[0], sizeBinary);
+		ForgetProgram(program);
 		return true;
 	}
 	return false;
@@ -415,138 +343,164 @@ bool Bad(const char *name) {
 }
 
 bool SetUniform(int program, const char *name, bool val) {
-	GLint id = glGetUniformLocation(program, name);
+	GLint id = UniformLocation(program, name);
 	if (id < 0)
 		return Bad(name);
-	glUniform1ui(id, val? 1 : 0);
+	GLuint u = val? 1 : 0;
+	if (UniformChanged(program, id, &u, sizeof(u)))
+		glUniform1ui(id, u);
 	return true;
 }
 
 bool SetUniform(int program, const char *name, int val) {
-	GLint id = glGetUniformLocation(program, name);
+	GLint id = UniformLocation(program, name);
 	if (id < 0)
 		return Bad(name);
-	glUniform1i(id, val);
+	if (UniformChanged(program, id, &val, sizeof(val)))
+		glUniform1i(id, val);
 	return true;
 }
 
 // following might confuse some compilers
 bool SetUniform(int program, const char *name, GLuint val) {
-	GLint id = glGetUniformLocation(program, name);
+	GLint id = UniformLocation(program, name);
 	if (id < 0)
 		return Bad(name);
-	glUniform1ui(id, val);
+	if (UniformChanged(program, id, &val, sizeof(val)))
+		glUniform1ui(id, val);
 	return true;
 }
 
 bool SetUniformv(int program, const char *name, int count, int *v) {
-	GLint id = glGetUniformLocation(program, name);
+	GLint id = UniformLocation(program, name);
 	if (id < 0)
 		return Bad(name);
-	glUniform1iv(id, count, v);
+	if (UniformChanged(program, id, v, count*sizeof(int)))
+		glUniform1iv(id, count, v);
 	return true;
 }
 
 bool SetUniform(int program, const char *name, float val) {
-	GLint id = glGetUniformLocation(program, name);
+	GLint id = UniformLocation(program, name);
 	if (id < 0)
 		return Bad(name);
-	glUniform1f(id, val);
+	if (UniformChanged(program, id, &val, sizeof(val)))
+		glUniform1f(id, val);
 	return true;
 }
 
 bool SetUniformv(int program, const char *name, int count, float *v) {
-	GLint id = glGetUniformLocation(program, name);
+	GLint id = UniformLocation(program, name);
 	if (id < 0)
 		return Bad(name);
-	glUniform1fv(id, count, v);
+	if (UniformChanged(program, id, v, count*sizeof(float)))
+		glUniform1fv(id, count, v);
 	return true;
 }
 
 bool SetUniform(int program, const char *name, vec2 v) {
-	GLint id = glGetUniformLocation(program, name);
+	GLint id = UniformLocation(program, name);
+	if (id < 0)
+		return Bad(name);
+	if (UniformChanged(program, id, &v, sizeof(v)))
+		glUniform2f(id, v.x, v.y);
+	return true;
+}
+
+bool SetUniform(int program, const char *name, int2 v) {
+	GLint id = UniformLocation(program, name);
 	if (id < 0)
 		return Bad(name);
-	glUniform2f(id, v.x, v.y);
+	if (UniformChanged(program, id, &v, sizeof(v)))
+		glUniform2i(id, v.i1, v.i2);
 	return true;
 }
 
 bool SetUniform(int program, const char *name, vec3 v) {
-	GLint id = glGetUniformLocation(program, name);
+	GLint id = UniformLocation(program, name);
 	if (id < 0)
 		return Bad(name);
-	glUniform3f(id, v.x, v.y, v.z);
+	if (UniformChanged(program, id, &v, sizeof(v)))
+		glUniform3f(id, v.x, v.y, v.z);
 	return true;
 }
 
 bool SetUniform(int program, const char *name, vec4 v) {
-	GLint id = glGetUniformLocation(program, name);
+	GLint id = UniformLocation(program, name);
 	if (id < 0)
 		return Bad(name);
-	glUniform4f(id, v.x, v.y, v.z, v.w);
+	if (UniformChanged(program, id, &v, sizeof(v)))
+		glUniform4f(id, v.x, v.y, v.z, v.w);
 	return true;
 }
 
 bool SetUniform(int program, const char *name, vec3 *v) {
-	GLint id = glGetUniformLocation(program, name);
+	GLint id = UniformLocation(program, name);
 	if (id < 0)
 		return Bad(name);
-	glUniform3fv(id, 1, (float *) v);
+	if (UniformChanged(program, id, v, sizeof(*v)))
+		glUniform3fv(id, 1, (float *) v);
 	return true;
 }
 
 bool SetUniform(int program, const char *name, vec4 *v) {
-	GLint id = glGetUniformLocation(program, name);
+	GLint id = UniformLocation(program, name);
 	if (id < 0)
 		return Bad(name);
-	glUniform4fv(id, 1, (float *) v);
+	if (UniformChanged(program, id, v, sizeof(*v)))
+		glUniform4fv(id, 1, (float *) v);
 	return true;
 }
 
 bool SetUniform3(int program, const char *name, float *v) {
-	GLint id = glGetUniformLocation(program, name);
+	GLint id = UniformLocation(program, name);
 	if (id < 0)
 		return Bad(name);
-	glUniform3fv(id, 1, v);
+	if (UniformChanged(program, id, v, 3*sizeof(float)))
+		glUniform3fv(id, 1, v);
 	return true;
 }
 
 bool SetUniform2v(int program, const char *name, int count, float *v) {
-	GLint id = glGetUniformLocation(program, name);
+	GLint id = UniformLocation(program, name);
 	if (id < 0)
 		return Bad(name);
-	glUniform2fv(id, count, v);
+	if (UniformChanged(program, id, v, 2*count*sizeof(float)))
+		glUniform2fv(id, count, v);
 	return true;
 }
 
 bool SetUniform3v(int program, const char *name, int count, float *v) {
-	GLint id = glGetUniformLocation(program, name);
+	GLint id = UniformLocation(program, name);
 	if (id < 0)
 		return Bad(name);
-	glUniform3fv(id, count, v);
+	if (UniformChanged(program, id, v, 3*count*sizeof(float)))
+		glUniform3fv(id, count, v);
 	return true;
 }
 
 bool SetUniform4v(int program, const char *name, int count, float *v) {
-	GLint id = glGetUniformLocation(program, name);
+	GLint id = UniformLocation(program, name);
 	if (id < 0)
 		return Bad(name);
-	glUniform4fv(id, count, v);
+	if (UniformChanged(program, id, v, 4*count*sizeof(float)))
+		glUniform4fv(id, count, v);
 	return true;
 }
 
 bool SetUniform(int program, const char *name, mat4 m) {
-	GLint id = glGetUniformLocation(program, name);
+	GLint id = UniformLocation(program, name);
 	if (id < 0)
 		return Bad(name);
-	glUniformMatrix4fv(id, 1, true, (float *) &m[0][0]);
+	if (UniformChanged(program, id, &m, sizeof(m)))
+		glUniformMatrix4fv(id, 1, true, (float *) &m[0][0]);
 	return true;
 }
 
 // Attribute Access
 
 void DisableVertexAttribute(int program, const char *name) {
-	GLint id = glGetAttribLocation(program, name);
+	GLint id = AttribLocation(program, name);
 	if (id < 0 && squawk)
 		printf("cant find attribute %s\n", name);
 	if (id >= 0)
@@ -554,7 +508,7 @@ void DisableVertexAttribute(int program, const char *name) {
 }
 
 int EnableVertexAttribute(int program, const char *name) {
-	GLint id = glGetAttribLocation(program, name);
+	GLint id = AttribLocation(program, name);
 	if (id < 0 && squawk)
 		printf("cant find attribute %s\n", name);
 	if (id >= 0)
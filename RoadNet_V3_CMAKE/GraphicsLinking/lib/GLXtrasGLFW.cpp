@@ -0,0 +1,100 @@
+// GLXtrasGLFW.cpp - GLFW window and input support (c) 2019-2022 Jules Bloomenthal
+//	kept apart from GLXtras.cpp so windowless tools link without GLFW
+
+#include <glad.h>
+#include "GLXtras.h"
+#include "GLState.h"
+
+namespace {
+
+GLFWwindow *w = NULL;
+
+bool GetKey(int button) { return glfwGetKey(w, button) == GLFW_PRESS; }
+
+MouseMoveCallback mmcb = NULL;
+MouseButtonCallback mbcb = NULL;
+MouseWheelCallback mwcb = NULL;
+ResizeCallback rcb = NULL;
+KeyboardCallback kcb = NULL;
+
+double InvertY(GLFWwindow *w, double y) {
+	// given y wrt upper left, return wrt lower left
+	int h;
+	glfwGetFramebufferSize(w, NULL, &h);
+	return h-y;
+}
+
+void MouseButton(GLFWwindow *w, int butn, int action, int mods) {
+	vec2 v = MouseCoords();
+	mbcb(v.x, v.y, butn == GLFW_MOUSE_BUTTON_LEFT, action == GLFW_PRESS);
+}
+
+void MouseMove(GLFWwindow *w, double x, double y) {
+	bool leftDown = glfwGetMouseButton(w, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS;
+	bool rightDown = glfwGetMouseButton(w, GLFW_MOUSE_BUTTON_RIGHT) == GLFW_PRESS;
+	mmcb((float) x, (float) InvertY(w, y), leftDown, rightDown);
+}
+
+void MouseWheel(GLFWwindow *w, double ignore, double spin) { mwcb((float) spin); }
+
+void Resize(GLFWwindow *w, int width, int height) { rcb(width, height); }
+
+void Keyboard(GLFWwindow *w, int key, int scancode, int action, int mods) {
+	kcb(key, action == GLFW_PRESS, mods & GLFW_MOD_SHIFT, mods & GLFW_MOD_CONTROL);
+}
+
+} // end namespace
+
+GLFWwindow *InitGLFW(int x, int y, int width, int height, const char *title, bool aa) {
+	glfwInit();
+	if (aa) glfwWindowHint(GLFW_SAMPLES, 4);
+	#ifdef __APPLE__
+		glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+		glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+		glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+		glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+	#endif
+	w = glfwCreateWindow(width, height, title, NULL, NULL);
+	glfwSetWindowPos(w, x, y);
+	glfwMakeContextCurrent(w);
+	glfwSwapInterval(1);
+	gladLoadGLLoader((GLADloadproc) glfwGetProcAddress);
+	InvalidateGLState(); // new context
+	return w;
+}
+
+vec2 MouseCoords() {
+	// return mouse coords wrt lower left
+	double x, y;
+	glfwGetCursorPos(w, &x, &y);
+	return vec2((float) x, (float) InvertY(w, y));
+}
+
+bool Shift() { return GetKey(GLFW_KEY_LEFT_SHIFT) || GetKey(GLFW_KEY_RIGHT_SHIFT); }
+
+bool Control() { return GetKey(GLFW_KEY_LEFT_CONTROL) || GetKey(GLFW_KEY_RIGHT_CONTROL); }
+
+void RegisterMouseButton(MouseButtonCallback cb) {
+	mbcb = cb;
+	glfwSetMouseButtonCallback(w, MouseButton);
+}
+
+void RegisterMouseMove(MouseMoveCallback cb) {
+	mmcb = cb;
+	glfwSetCursorPosCallback(w, MouseMove);
+}
+
+void RegisterMouseWheel(MouseWheelCallback cb) {
+	mwcb = cb;
+	glfwSetScrollCallback(w, MouseWheel);
+}
+
+void RegisterResize(ResizeCallback cb) {
+	rcb = cb;
+	glfwSetFramebufferSizeCallback(w, Resize);
+}
+
+void RegisterKeyboard(KeyboardCallback cb) {
+	kcb = cb;
+	glfwSetKeyCallback(w, Keyboard);
+}
@@ -1,7 +1,9 @@
 // IO.cpp (c) 2019-2022 Jules Bloomenthal
 
 #include "Draw.h"
+#include "GLState.h"
 #include "IO.h"
+#include "SoftRaster.h"
 #include <fstream>
 #include <string.h>
 
@@ -14,8 +16,8 @@ using std::ifstream;
 
 #define STB_IMAGE_IMPLEMENTATION
 #define STB_IMAGE_WRITE_IMPLEMENTATION
-#include "stb_image.h"
-#include "stb_image_write.h"
+#include "STB_Image.h"
+#include "STB_Image_Write.h"
 
 void LoadTexture(unsigned char *pixels, int width, int height, int bpp, unsigned int textureName, bool bgr, bool mipmap) {
 	unsigned char *temp = pixels;
@@ -28,7 +30,7 @@ void LoadTexture(unsigned char *pixels, int width, int height, int bpp, unsigned
 				for (int k = 0; k < 3; k++)
 					*t++ = *p++;
 	}
-	glBindTexture(GL_TEXTURE_2D, textureName);      // bind current texture to textureName
+	BindTexture(GL_TEXTURE_2D, textureName);        // bind current texture to textureName
 	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);          // accommodate width not multiple of 4
 	// specify target, format, dimension, transfer data
 	if (bpp == 4)
@@ -44,7 +46,7 @@ void LoadTexture(unsigned char *pixels, int width, int height, int bpp, unsigned
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 	// if (bpp == 4) delete [] temp;
-	glBindTexture(GL_TEXTURE_2D, 0); // **** ???
+	BindTexture(GL_TEXTURE_2D, 0); // **** ???
 }
 
 GLuint LoadTexture(unsigned char *pixels, int width, int height, int bpp, bool bgr, bool mipmap) {
@@ -89,6 +91,13 @@ unsigned char *GetData(int &width, int &height) {
 }
 
 void SavePng(const char *filename) {
+	if (SoftTarget *soft = CurrentSoftTarget()) {
+		// RGBA, bottom row first: write top down by starting at the last row with a negative stride
+		int width = soft->Width(), height = soft->Height();
+		const unsigned char *pixels = soft->Pixels();
+		stbi_write_png(filename, width, height, 4, pixels+4*width*(height-1), -4*width);
+		return;
+	}
 	int width, height;
 	unsigned char *cPixels = GetData(width, height);
 	stbi_write_png(filename, width, height, 3, cPixels, width*3);
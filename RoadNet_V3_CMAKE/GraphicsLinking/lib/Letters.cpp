@@ -3,16 +3,25 @@
 
 #include <glad.h>
 #include "Draw.h"
+#include "GLState.h"
 #include "GLXtras.h"
 #include "Misc.h"
 #include "IO.h"
 #include "Letters.h"
+#include "SoftRaster.h"
+#include "StreamBuffer.h"
+#include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
+#include <string.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace {
 
 // images are 13 lines, each with 284 grayscale values; a value is represented as two hexadecimal characters
-const char *lowerCaseImage = "\
+constexpr char lowerCaseImage[] = "\
 FFFFFFFFFFFFFFFFFFD8000000D8FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF3B00007AFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFB90000000000FFFFFFFFFFFFFFFFFFFFFFFF3B00005CFFFFFFFFFFFFFFFFFFFFFF0000D8FFFFFFFFFFFFFFFFD80000D8FFFFFF9B000000FFFFFFFFFFFFFFFFD8000000009BFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF5C1DFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF\
 FFFFFFFFFFFFFFFFFFD8000000D8FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF3B00007AFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFD8000000000000B9FFFFFFFFFFFFFFFFFFFFFF3B00005CFFFFFFFFFFFFFFFFFFFFFF0000D8FFFFFFFFFFFFFFFFD80000D8FFFFFF9B000000FFFFFFFFFFFFFFFFD8000000009BFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF1D00FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF\
 FFFFFFFFFFFFFFFFFFFFFF3B00D8FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF9B007AFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF9B007AFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFB9005CFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF1D00FFFFFFFFFFFFFFFFFFFFFF7A009BFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF1D00FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF\
@@ -27,7 +36,7 @@ FF1D000000B90000009D000000D800000000D8FFFFFFFFFF1D000000001DFFFFFFFF9B000000009B
 FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF1D00D8FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF1D00B9FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF3B00D8FFFFFFFFFFFFFFFFFFFFFFFFFFFF9B007AFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF9B003BFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF\
 FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF7A00000000003BFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF9B00000000001DFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFD800000000009BFFFFFFFFFFFFFFFFFFFF7A0000000000FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF5C00000000005CFFFFFFFFFFFFFFFFFFFFFFFFFFFF";
 
-const char *upperCaseImage = "\
+constexpr char upperCaseImage[] = "\
 FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF\
 7A000000009BFFFFFFFF3B00000000000000FFFFFFFFFFFF5C0000009B5C1DFF1D000000000000B9FFFFFF3B00000000000000005CFFD80000000000000000009BFFFFFF5C0000009B5C3BFFB90000001DFF00000000B9FF7A00000000000000B9FFFFFFFF9B000000000000005C000000B9FF7A0000003B9B00000000001DFFFFFFD8000000D8FFFFFF9B0000000000009BFFD8000000005CFFFFFF5C0000007AFFFFFFFF1D0000000000005CFFFFFFFFFF5C0000007AFFFFFF3B0000000000001DFFFFFFFFFFFF3B000000B900B9FFB9000000000000000000D81D00003BFFFFFF0000000000000000B9FF9B00000000000000007AFF5C000000003B0000007AFF5C0000005C3B0000009BFF9B0000005CFF9B00000000000000B9\
 7A000000001DFFFFFFFF3B0000000000000000D8FFFFFF0000000000000000FF1D000000000000007AFFFF3B00000000000000005CFFD80000000000000000009BFFFF1D00000000000000FFB90000001DFF00000000B9FF7A00000000000000B9FFFFFFFF9B000000000000005C000000B9FF7A0000003B9B00000000001DFFFFFFD80000005CFFFFFF3B00000000000000FFD8000000005CFFFF0000000000001DFFFFFF1D000000000000003BFFFFFF0000000000001DFFFF3B0000000000000000FFFFFFFF1D0000000000009BFFB9000000000000000000D81D00003BFFFFFF0000000000000000B9FF9B00000000000000007AFF5C000000003B0000007AFF5C0000005C3B0000007AFF9B0000005CFF9B00000000000000B9\
@@ -43,7 +52,7 @@ D80000000000001DFFFFFFB9005CFFFFFFB90000D8B9007AFFFFFFFFFFFFFFFFFF3B00D8FFFFFFFF
 FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF1D000000D8D800B9FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF";
 
 // next 10 lines each with 82 grayscale values, each value represented as two hexadecimal characters
-const char *numberImage = "\
+constexpr char numberImage[] = "\
 FFEC7A110034C3FFFFDD98340047FFFFFFFFA723002389FFFFFF000000117AFFFFFFFFFFC3000089FFFF890000000000FFFFFFFFA734000089FF89000000000000C3FFDD57000023A7FFFFEC69110034B5FF\
 FF470000000011DDFF5700000047FFFFFF980000000000B5FFFF000000000098FFFFFFFF23000089FFFF890000000000FFFFFF690000000089FF89000000000000C3FF340000000000D0FF470000000000DD\
 D00011DDFF690069FF987AB50047FFFFFFEC47DDFF89007AFFFFFFFFFF980047FFFFFF89007A0089FFFF8900C3FFFFFFFFFFC30023B5FFFFFFFFFFFFFFFFEC1123FFFF0034ECFFA700C3DD0023DDFF890089\
@@ -55,15 +64,61 @@ B50034DDEC57007AFFFFFFC30047FFFFFFFF690089FFFFFFFFFFFFFFFFDD2300DD47000000000000
 FF340000000011DDFF47000000000047FF98000000000000FFC3000000000047FFFFFFFFFFC30089FFFF470000000011DDFFDD000000000047FFFFEC1111ECFFFFFFEC110000000000C3FF470000000069FF\
 FFEC69000057D0FFFF47000000000047FF89000000000000FFC30000003489ECFFFFFFFFFFC30089FFFF4700001169DDFFFFFFB534001169ECFFFF890089FFFFFFFFFFC334000034B5FFFF4700003498FFFF";
 
-// transform 2D vertex by view, separate uv from vec4
+// atlas rows: lower case, upper case and numerals stacked, one blank row between each, then a block of ink
+// that punctuation quads sample; blank rows keep linear filtering from bleeding across sections
+constexpr int letterRows = 13, numberRows = 10;
+constexpr int letterWidth = (int) (sizeof(lowerCaseImage)-1)/2/letterRows, numberWidth = (int) (sizeof(numberImage)-1)/2/numberRows;
+constexpr int atlasLowerRow = 0, atlasUpperRow = 14, atlasNumberRow = 28, atlasInkRow = 39, atlasHeight = 43;
+constexpr int atlasWidth = letterWidth > numberWidth? letterWidth : numberWidth;
+
+static_assert(sizeof(upperCaseImage) == sizeof(lowerCaseImage), "upper and lower case images differ in size");
+static_assert(letterWidth*letterRows*2 == sizeof(lowerCaseImage)-1 && numberWidth*numberRows*2 == sizeof(numberImage)-1,
+			  "glyph image is not a whole number of rows");
+
+// Atlas Pixels
+//	decoded by the compiler: the program holds the single-channel atlas, ready to upload, and not the hex
+
+struct AtlasPixels {
+	unsigned char p[atlasWidth*atlasHeight] = {};
+};
+
+constexpr int HexDigit(char c) { return c < 58? c-'0' : 10+c-'A'; }
+
+constexpr void HexImage(AtlasPixels &a, const char *image, int width, int height, int row) {
+	// decode height lines of width two-digit hexadecimal values into the atlas, starting at row
+	for (int j = 0; j < height; j++)
+		for (int i = 0; i < width; i++, image += 2)
+			a.p[(row+j)*atlasWidth+i] = (unsigned char) (16*HexDigit(image[0])+HexDigit(image[1]));
+}
+
+constexpr AtlasPixels DecodeAtlas() {
+	AtlasPixels a;
+	for (unsigned char &v : a.p)
+		v = 255; // white is transparent
+	HexImage(a, lowerCaseImage, letterWidth, letterRows, atlasLowerRow);
+	HexImage(a, upperCaseImage, letterWidth, letterRows, atlasUpperRow);
+	HexImage(a, numberImage, numberWidth, numberRows, atlasNumberRow);
+	for (int j = atlasInkRow; j < atlasHeight; j++)
+		for (int i = 0; i < 4; i++)
+			a.p[j*atlasWidth+i] = 0;
+	return a;
+}
+
+constexpr AtlasPixels atlasPixels = DecodeAtlas();
+
+// transform 2D vertex by view; color per vertex so strings of any color share one draw
 const char *vertexShader = R"(
 	#version 130
-	in vec4 point;
+	in vec2 point;
+	in vec2 uv;
+	in vec3 color;
 	out vec2 vUv;
+	out vec3 vColor;
 	uniform mat4 view;
 	void main() {
-		gl_Position = view*vec4(point.xy, 0, 1);
-		vUv = point.zw;
+		gl_Position = view*vec4(point, 0, 1);
+		vUv = uv;
+		vColor = color;
 	}
 )";
 
@@ -71,159 +126,205 @@ const char *vertexShader = R"(
 const char *pixelShader = R"(
 	#version 130
 	in vec2 vUv;
+	in vec3 vColor;
 	out vec4 pColor;
 	uniform sampler2D textureImage;
-	uniform vec3 color;
 	void main() {
 		float a = texture(textureImage, vUv).r;
-		pColor = vec4(color, 1-a);
+		pColor = vec4(vColor, 1-a);
 	}
 )";
 
-GLuint shaderProgram = 0, vBufferId = 0;
-GLuint textureNameLower = 0, textureNameUpper = 0, textureNameNumber = 0;
-int textureUnitLower = 2, textureUnitUpper = 3, textureUnitNumber = 4; // this dies if GLUint?!
+GLuint shaderProgram = 0, atlasName = 0;
 
-} // end namespace
+void MakeAtlas() {
+	glGenTextures(1, &atlasName);
+	BindTexture(GL_TEXTURE_2D, atlasName);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, atlasWidth, atlasHeight, 0, GL_RED, GL_UNSIGNED_BYTE, atlasPixels.p);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+}
 
-int MakeLetterTexture(unsigned char *image) {//, int textureUnit) {
-	// create and load texture raster
-	int nchars = strlen(lowerCaseImage), npixels = nchars/2, height = 13, width = npixels/height;
-	unsigned char *pixels = new unsigned char[3*npixels], *p = pixels, *n = (unsigned char *) image;
-	for (int i = 0; i < npixels; i++) {
-		char c1 = *n++, c2 = *n++;
-		int k1 = c1 < 58? c1-'0' : 10+c1-'A', k2 = c2 < 58? c2-'0' : 10+c2-'A', b = 16*k1+k2;
-		for (int k = 0; k < 3; k++)
-			*p++ = (unsigned char) b;
-	}
-	int textureName = LoadTexture(pixels, width, height, 3);//, textureUnit);
-	delete [] pixels;
-	return textureName;
+// Layout
+//	a string's quads relative to its origin, kept by content hash so unchanged strings are not laid out again
+
+struct LetterVertex {
+	vec2 point, uv;
+	LetterVertex(vec2 p, vec2 t) : point(p), uv(t) { }
+};
+
+struct Layout {
+	std::string text;
+	float ptSize = 0;
+	std::vector<LetterVertex> vertices;
+};
+
+std::unordered_map<uint64_t, Layout> layouts;
+int layoutHits = 0, layoutMisses = 0;
+
+void Glyph(std::vector<LetterVertex> &v, vec2 p, float w, float h, float u0, float u1, int row, int rows) {
+	// quad from p to p+(w,h); image top (v0) at the quad top
+	float v0 = (float) row/atlasHeight, v1 = (float) (row+rows)/atlasHeight;
+	LetterVertex a(p, vec2(u0, v1)), b(p+vec2(w, 0.f), vec2(u1, v1)), c(p+vec2(w, h), vec2(u1, v0)), d(p+vec2(0.f, h), vec2(u0, v0));
+	LetterVertex quad[] = {a, b, c, a, c, d};
+	v.insert(v.end(), quad, quad+6);
+}
+
+void Stroke(std::vector<LetterVertex> &v, vec2 p1, vec2 p2, float width) {
+	// line of given width as a quad of solid ink
+	vec2 d = p2-p1, n = length(d) > 0? normalize(vec2(-d.y, d.x))*(width/2) : vec2(width/2, 0.f);
+	vec2 ink(2.f/atlasWidth, (atlasInkRow+2.f)/atlasHeight);
+	LetterVertex a(p1-n, ink), b(p2-n, ink), c(p2+n, ink), e(p1+n, ink);
+	LetterVertex quad[] = {a, b, c, a, c, e};
+	v.insert(v.end(), quad, quad+6);
 }
 
-int MakeNumberTexture(unsigned char *image) {//, int textureUnit) {
-	// create and load texture raster
-	int nchars = strlen(numberImage), npixels = nchars/2, height = 10, width = npixels/height;
-	unsigned char *pixels = new unsigned char[3*npixels], *p = pixels, *n = (unsigned char *) image;
-	for (int i = 0; i < npixels; i++) {
-		char c1 = *n++, c2 = *n++;
-		int k1 = c1 < 58? c1-'0' : 10+c1-'A', k2 = c2 < 58? c2-'0' : 10+c2-'A', b = 16*k1+k2;
-		for (int k = 0; k < 3; k++)
-			*p++ = (unsigned char) b;
+void Punctuation(std::vector<LetterVertex> &v, float x, char c, float ptSize) {
+	// 32(space), 40((), 41()), 43(+), 45(-), 46(.), 47(/), 61(=), 94(^) as strokes of solid ink
+	float lineWidth = ptSize/3, size = (float) (int) ptSize, h = (float) (int) (ptSize*.5f);
+	auto P = [x](float px, float py) { return vec2(x+px, py); };
+	if (c == 40 || c == 41) {
+		float side = c == 40? 2 : size-2;
+		vec2 p1 = P(h, size+1), p2 = P(side, (float) (int) (.75f*ptSize)), p3 = P(side, (float) (int) (.25f*ptSize)), p4 = P(h, -1);
+		Stroke(v, p1, p2, lineWidth); Stroke(v, p2, p3, lineWidth); Stroke(v, p3, p4, lineWidth);
+	}
+	if (c == 61) {
+		Stroke(v, P(1, h+3), P(h+6, h+3), lineWidth);
+		Stroke(v, P(1, h-3), P(h+6, h-3), lineWidth);
+	}
+	if (c == 43) {
+		Stroke(v, P(1, h+1), P(h+6, h+1), lineWidth);
+		Stroke(v, P(h, 2), P(h, h+6), lineWidth);
+	}
+	if (c == 45) Stroke(v, P(1, h), P(h+3, h), lineWidth);
+	if (c == 46) Stroke(v, P(h-ptSize/6, 3), P(h+ptSize/6, 3), ptSize/3); // square dot in place of a disk
+	if (c == 47) Stroke(v, P(1, 0), P(size-1, size), lineWidth);
+	if (c == 94) {
+		Stroke(v, P(1, 2), P(h, h+4), lineWidth);
+		Stroke(v, P(h, h+4), P(size-2, 2), lineWidth);
 	}
-	int textureName = LoadTexture(pixels, width, height, 3);//, textureUnit);
-	delete [] pixels;
-	return textureName;
 }
 
-void Letter(int x, int y, char c, vec3 color, float ptSize) {
-	if (c < 48 || c == 61 || c == 94) { // 32(space), 40((), 41()), 43(+), 45(-), 46(.), 47(/), 61(=), 94(^)
-		float lineWidth = ptSize/3; // = 2;
-		UseDrawShader(ScreenMode());
-		int size = (int) ptSize, h = (int)(ptSize*.5f), hh = (int)(ptSize*.75f);
-		if (c == 40) {
-			vec2 p1(x+h, y+size+1), p2(x+2, y+(int)(.75f*ptSize)), p3(x+2, y+(int)(.25f*ptSize)), p4(x+h, y-1);
-			Line(p1, p2, lineWidth, color); Line(p2, p3, lineWidth, color); Line(p3, p4, lineWidth, color);
-		}
-		if (c == 41) {
-			vec2 p1(x+h, y+size+1), p2(x+size-2, y+(int)(.75f*ptSize)), p3(x+size-2, y+(int)(.25f*ptSize)), p4(x+h, y-1);
-			Line(p1, p2, lineWidth, color); Line(p2, p3, lineWidth, color); Line(p3, p4, lineWidth, color);
-		}
-		if (c == 61) {
-			Line(x+1, y+h+3, x+h+6, y+h+3, lineWidth, color);
-			Line(x+1, y+h-3, x+h+6, y+h-3, lineWidth, color);
+const std::vector<LetterVertex> &LayOut(const char *s, float ptSize) {
+	uint64_t key = 14695981039346656037ull; // FNV-1a over text and size
+	for (const char *c = s; *c; c++)
+		key = (key^(uint64_t) (unsigned char) *c)*1099511628211ull;
+	uint32_t sizeBits;
+	memcpy(&sizeBits, &ptSize, sizeof(sizeBits));
+	key = (key^sizeBits)*1099511628211ull;
+	Layout &l = layouts[key];
+	if (l.ptSize == ptSize && l.text == s) {
+		layoutHits++;
+		return l.vertices;
+	}
+	layoutMisses++;
+	if (layouts.size() > LETTERS_LAYOUT_CACHE) {
+		// drop everything rather than track use; a steady screen refills in one frame
+		layouts.clear();
+		return LayOut(s, ptSize);
+	}
+	l.text = s;
+	l.ptSize = ptSize;
+	l.vertices.clear();
+	float w = .8f*ptSize, h = ptSize;
+	for (int i = 0; s[i]; i++) {
+		char c = s[i];
+		float x = i*ptSize;
+		if (c < 48 || c == 61 || c == 94)
+			Punctuation(l.vertices, x, c, ptSize);
+		else if ((c >= 65 && c <= 90) || (c >= 97 && c <= 122)) {
+			float du = (float) letterWidth/26/atlasWidth, u = (c <= 90? c-'A' : c-'a')*du;
+			Glyph(l.vertices, vec2(x, 0.f), w, h, u, u+du, c <= 90? atlasUpperRow : atlasLowerRow, letterRows);
 		}
-		if (c == 43) {
-			Line(x+1, y+h+1, x+h+6, y+h+1, lineWidth, color);
-			Line(x+h, y+2, x+h, y+h+6, lineWidth, color);
+		else if (c >= 48 && c <= 57) {
+			float du = (float) numberWidth/10/atlasWidth, u = (c-'0')*du;
+			Glyph(l.vertices, vec2(x, 0.f), w, h, u, u+du, atlasNumberRow, numberRows);
 		}
-		if (c == 45) Line(x+1, y+h, x+h+3, y+h, lineWidth, color);
-		if (c == 46) Disk(vec2(x+h, y+3), ptSize/3, color);
-		if (c == 47) Line(x+1, y, x+size-1, y+size, lineWidth, color);
-		if (c == 94) {
-			Line(x+1, y+2, x+h, y+h+4, lineWidth, color);
-			Line(x+h, y+h+4, x+size-2, y+2, lineWidth, color);
+	}
+	return l.vertices;
+}
+
+TextBatch immediateLetters;
+
+} // end namespace
+
+// TextBatch
+
+void TextBatch::Add(int x, int y, const char *s, vec3 color, float ptSize) {
+	const std::vector<LetterVertex> &layout = LayOut(s, ptSize);
+	vec2 origin((float) x, (float) y);
+	for (const LetterVertex &v : layout)
+		vertices.emplace_back(v.point+origin, v.uv, color);
+}
+
+int TextBatch::Flush(mat4 view) {
+	if (vertices.empty())
+		return 0;
+	if (SoftTarget *soft = CurrentSoftTarget()) {
+		soft->SetView(view);
+		for (size_t i = 0; i+2 < vertices.size(); i += 3) {
+			const TextBatchVertex *v = &vertices[i];
+			soft->Glyph(vec3(v[0].point, 0), vec3(v[1].point, 0), vec3(v[2].point, 0), v[0].uv, v[1].uv, v[2].uv,
+						v[0].color, atlasPixels.p, atlasWidth, atlasHeight);
 		}
-		return;
+		vertices.clear();
+		return 0;
 	}
-	enum { Upper, Lower, Number, Unknown } type =
-		c >= 65 && c <= 90?  Upper  :
-		c >= 97 && c <= 122? Lower  :
-		c >= 48 && c <= 57?  Number :
-							 Unknown;
-	if (type == Unknown)
-		return;
-	if (!textureNameLower)
-		textureNameLower = MakeLetterTexture((unsigned char *) lowerCaseImage);//, textureUnitLower);
-	if (!textureNameUpper)
-		textureNameUpper = MakeLetterTexture((unsigned char *) upperCaseImage);//, textureUnitUpper);
-	if (!textureNameNumber)
-		textureNameNumber = MakeNumberTexture((unsigned char *) numberImage);//, textureUnitNumber);
-	if (!textureNameLower || !textureNameUpper || !textureNameNumber)
-		printf("can't make texture maps\n");
+	GLsizei stride = sizeof(TextBatchVertex);
+	StreamBuffer &stream = VertexStream();
+	GLintptr offset = 0;
+	memcpy(stream.Map(vertices.size()*stride, stride, offset), vertices.data(), vertices.size()*stride);
+	stream.Unmap();
+	if (!atlasName)
+		MakeAtlas();
 	if (!shaderProgram)
 		shaderProgram = LinkProgramViaCode(&vertexShader, &pixelShader);
-	glUseProgram(shaderProgram);
-	if (!vBufferId) {
-		glGenBuffers(1, &vBufferId);
-		glBindBuffer(GL_ARRAY_BUFFER, vBufferId);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(float)*4*6, NULL, GL_DYNAMIC_DRAW);
-			// need 4 vertices for quad, but 6 if triangles
+	UseProgram(shaderProgram);
+	if (!vao)
+		glGenVertexArrays(1, &vao);
+	BindVertexArray(vao);
+	if (streamGeneration != stream.Generation()) {
+		BindBuffer(GL_ARRAY_BUFFER, stream.Buffer());
+		VertexAttribPointer(shaderProgram, "point", 2, stride, (void *) offsetof(TextBatchVertex, point));
+		VertexAttribPointer(shaderProgram, "uv", 2, stride, (void *) offsetof(TextBatchVertex, uv));
+		VertexAttribPointer(shaderProgram, "color", 3, stride, (void *) offsetof(TextBatchVertex, color));
+		streamGeneration = stream.Generation();
 	}
-	glBindBuffer(GL_ARRAY_BUFFER, vBufferId);
-	VertexAttribPointer(shaderProgram, "point", 4, 4*sizeof(float), 0);
-		// each vertex is 4 floats, stride is 4 floats
-	int texUnit = type == Upper? textureUnitUpper : type == Lower? textureUnitLower : textureUnitNumber;
-	GLuint texName = type == Upper? textureNameUpper : type == Lower? textureNameLower : textureNameNumber;
-	glActiveTexture(GL_TEXTURE0+texUnit);
-	glBindTexture(GL_TEXTURE_2D, texName);
-	// set screen-mode
-	SetUniform(shaderProgram, "view", ScreenMode());
-	// set text color and texture map, activate texture
-	SetUniform(shaderProgram, "color", color);
-	SetUniform(shaderProgram, "textureImage", texUnit);
+	BindTexture(0, GL_TEXTURE_2D, atlasName);
+	SetUniform(shaderProgram, "view", view);
+	SetUniform(shaderProgram, "textureImage", 0);
 	// enable blended overwrite of color buffer
 	glEnable(GL_BLEND);
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-	// display character c, value determines horizontal position along texture
-	float w = .8f*ptSize, h = ptSize, xx = (float) x, yy = (float) y;
-	float t = 0, dt = 0;
-	if (type == Number) {
-		int value = c-'0';
-		dt = 1.f/10.f; t = (float) value*dt;
-		float vertices[][4] = { {xx, yy, t, 1}, {xx+w, yy, t+dt, 1}, {xx+w, yy+h, t+dt, 0}, {xx, yy+h, t, 0} };
-		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-	}
-	else {
-		int letterID = type == Upper? c-'A' : type == Lower? c-'a' : c-'0';
-		dt = 1.f/26.f; t = (float)letterID*dt;
-	//	float vertices[][4] = { {xx, yy+h, t, 1}, {xx+w, yy+h, t+dt, 1}, {xx+w, yy, t+dt, 0}, {xx, yy, t, 0} };
-		float vertices[][4] = { {xx, yy, t, 1}, {xx+w, yy, t+dt, 1}, {xx+w, yy+h, t+dt, 0}, {xx, yy+h, t, 0} };
-		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-	}
-	// display as one quad or two triangles, mapped to 1/26 width of texture map
-#ifdef GL_QUADS
-	glDrawArrays(GL_QUADS, 0, 4);
-#else
-	float vertices[][4] = {{xx, yy, t, 1}, {xx+w, yy, t+dt, 1},   {xx+w, yy+h, t+dt, 0},
-					       {xx, yy, t, 1}, {xx+w, yy+h, t+dt, 0}, {xx, yy+h, t, 0}};
-	glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-	glDrawArrays(GL_TRIANGLES, 0, 6);
-#endif
-	glBindVertexArray(0);
-	glBindTexture(GL_TEXTURE_2D, 0);
+	glDrawArrays(GL_TRIANGLES, (GLint) (offset/stride), (GLsizei) vertices.size());
+	vertices.clear();
+	return 1;
 }
 
+void TextBatch::Release() {
+	if (vao) DeleteVertexArrays(1, &vao);
+	vao = 0;
+	streamGeneration = 0;
+}
+
+void LettersLayoutStats(int &hits, int &misses) {
+	hits = layoutHits;
+	misses = layoutMisses;
+}
+
+// Letters
+
 void Letters(int x, int y, const char *letters, vec3 color, float ptSize) {
-	for (int i = 0; i < (int) strlen(letters); i++)
-		Letter((int) (x+i*ptSize), y, letters[i], color, ptSize);
+	immediateLetters.Add(x, y, letters, color, ptSize);
+	immediateLetters.Flush(ScreenMode());
 }
 
 void Letters(vec3 p, mat4 m, const char *letters, vec3 color, float ptSize) {
 	vec2 pp = ScreenPoint(p, m);
-	for (int i = 0; i < (int) strlen(letters); i++)
-	//	Letter((int) (pp.x+i*10.9f), (int) pp.y, letters[i], color, ptSize);
-		Letter((int) (pp.x+i*ptSize), (int) pp.y, letters[i], color, ptSize);
+	Letters((int) pp.x, (int) pp.y, letters, color, ptSize);
 }
 
 /*	// method to convert image to hexadecimal data
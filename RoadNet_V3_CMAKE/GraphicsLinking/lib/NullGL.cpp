@@ -0,0 +1,590 @@
+// NullGL.cpp - glad function table of counting stubs, to measure what a frame asks of the driver without a GPU
+
+#include <glad.h>
+#include <map>
+#include <set>
+#include <string>
+#include <string.h>
+#include <vector>
+#include "GLState.h"
+#include "NullGL.h"
+
+namespace {
+
+// containers are allocated and never destroyed, since other static destructors still release GL objects at exit
+
+NullGLCounters stats;
+std::vector<NullGLCall> &callCounts = *new std::vector<NullGLCall>; // one per entry in procs, in its order
+
+// State Kept To Answer Queries
+typedef std::map<std::pair<GLuint, std::string>, GLint> Locations;
+GLuint nextName = 1;                        // textures, buffers, vertex arrays, shaders, programs, ...
+GLint viewport[4] = {0, 0, 0, 0};
+GLuint program = 0;
+std::set<GLenum> &enabled = *new std::set<GLenum>;
+std::map<GLenum, GLuint> &boundBuffers = *new std::map<GLenum, GLuint>; // by target
+std::map<GLuint, std::vector<char>> &bufferStore = *new std::map<GLuint, std::vector<char>>;
+Locations &uniformLocations = *new Locations, &attribLocations = *new Locations;
+size_t nSyncs = 0;
+
+int Slot(const char *name) {
+	for (size_t i = 0; i < callCounts.size(); i++)
+		if (!strcmp(callCounts[i].name, name))
+			return (int) i;
+	callCounts.push_back({name, 0});
+	return (int) callCounts.size()-1;
+}
+
+// count the call against its entry point; the slot is looked up once per stub
+#define NULL_GL_CALL(name) static int slot = Slot(name); callCounts[slot].count++; stats.calls++;
+
+void GenNames(GLsizei n, GLuint *names) {
+	for (GLsizei i = 0; i < n; i++)
+		names[i] = nextName++;
+}
+
+std::vector<char> &BoundStore(GLenum target, size_t minBytes) {
+	std::vector<char> &store = bufferStore[boundBuffers[target]];
+	if (store.size() < minBytes)
+		store.resize(minBytes);
+	return store;
+}
+
+size_t TexelBytes(GLenum format, GLenum type) {
+	switch (type) {
+		case GL_UNSIGNED_INT_8_8_8_8: case GL_UNSIGNED_INT_8_8_8_8_REV:
+		case GL_UNSIGNED_INT_10_10_10_2: case GL_UNSIGNED_INT_2_10_10_10_REV: return 4;
+		case GL_UNSIGNED_SHORT_5_6_5: case GL_UNSIGNED_SHORT_4_4_4_4: case GL_UNSIGNED_SHORT_5_5_5_1: return 2;
+	}
+	size_t components = 4, size = 1;
+	switch (format) {
+		case GL_RED: case GL_RED_INTEGER: case GL_DEPTH_COMPONENT: case GL_STENCIL_INDEX: components = 1; break;
+		case GL_RG: case GL_RG_INTEGER: components = 2; break;
+		case GL_RGB: case GL_BGR: case GL_RGB_INTEGER: components = 3; break;
+	}
+	switch (type) {
+		case GL_SHORT: case GL_UNSIGNED_SHORT: case GL_HALF_FLOAT: size = 2; break;
+		case GL_INT: case GL_UNSIGNED_INT: case GL_FLOAT: size = 4; break;
+	}
+	return components*size;
+}
+
+void TextureUpload(GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void *pixels) {
+	// NULL without a pixel unpack buffer only allocates
+	if (!pixels && !boundBuffers[GL_PIXEL_UNPACK_BUFFER])
+		return;
+	stats.textureUploads++;
+	stats.textureBytes += (size_t) width*height*depth*TexelBytes(format, type);
+}
+
+void Draw(GLsizei count, GLsizei instances) {
+	stats.draws++;
+	stats.vertices += (long long) count*instances;
+}
+
+// Draws
+
+void APIENTRY NullDrawArrays(GLenum, GLint, GLsizei count) {
+	NULL_GL_CALL("glDrawArrays") Draw(count, 1);
+}
+
+void APIENTRY NullDrawArraysInstanced(GLenum, GLint, GLsizei count, GLsizei instances) {
+	NULL_GL_CALL("glDrawArraysInstanced") Draw(count, instances);
+}
+
+void APIENTRY NullDrawArraysInstancedBaseInstance(GLenum, GLint, GLsizei count, GLsizei instances, GLuint) {
+	NULL_GL_CALL("glDrawArraysInstancedBaseInstance") Draw(count, instances);
+}
+
+void APIENTRY NullDrawElements(GLenum, GLsizei count, GLenum, const void *) {
+	NULL_GL_CALL("glDrawElements") Draw(count, 1);
+}
+
+void APIENTRY NullMultiDrawArrays(GLenum, const GLint *, const GLsizei *count, GLsizei drawcount) {
+	NULL_GL_CALL("glMultiDrawArrays")
+	stats.draws++;
+	for (GLsizei i = 0; i < drawcount; i++)
+		stats.vertices += count[i];
+}
+
+void APIENTRY NullClear(GLbitfield) { NULL_GL_CALL("glClear") }
+void APIENTRY NullFlush() { NULL_GL_CALL("glFlush") }
+void APIENTRY NullFinish() { NULL_GL_CALL("glFinish") }
+
+// Buffers
+
+void APIENTRY NullGenBuffers(GLsizei n, GLuint *names) { NULL_GL_CALL("glGenBuffers") GenNames(n, names); }
+
+void APIENTRY NullDeleteBuffers(GLsizei n, const GLuint *names) {
+	NULL_GL_CALL("glDeleteBuffers")
+	for (GLsizei i = 0; i < n; i++)
+		bufferStore.erase(names[i]);
+}
+
+void APIENTRY NullBindBuffer(GLenum target, GLuint buffer) {
+	NULL_GL_CALL("glBindBuffer")
+	stats.stateChanges++;
+	boundBuffers[target] = buffer;
+}
+
+void APIENTRY NullBindBufferBase(GLenum target, GLuint, GLuint buffer) {
+	NULL_GL_CALL("glBindBufferBase")
+	stats.stateChanges++;
+	boundBuffers[target] = buffer;
+}
+
+void APIENTRY NullBufferData(GLenum target, GLsizeiptr size, const void *data, GLenum) {
+	NULL_GL_CALL("glBufferData")
+	std::vector<char> &store = BoundStore(target, 0);
+	store.assign((size_t) size, 0);
+	if (data) {
+		memcpy(store.data(), data, (size_t) size);
+		stats.bufferUploads++;
+		stats.bufferBytes += (size_t) size;
+	}
+}
+
+void APIENTRY NullBufferStorage(GLenum target, GLsizeiptr size, const void *data, GLbitfield) {
+	NULL_GL_CALL("glBufferStorage")
+	std::vector<char> &store = BoundStore(target, 0);
+	store.assign((size_t) size, 0);
+	if (data) {
+		memcpy(store.data(), data, (size_t) size);
+		stats.bufferUploads++;
+		stats.bufferBytes += (size_t) size;
+	}
+}
+
+void APIENTRY NullBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void *data) {
+	NULL_GL_CALL("glBufferSubData")
+	memcpy(BoundStore(target, (size_t) (offset+size)).data()+offset, data, (size_t) size);
+	stats.bufferUploads++;
+	stats.bufferBytes += (size_t) size;
+}
+
+void APIENTRY NullGetBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, void *data) {
+	NULL_GL_CALL("glGetBufferSubData")
+	stats.queries++;
+	memcpy(data, BoundStore(target, (size_t) (offset+size)).data()+offset, (size_t) size);
+}
+
+void *APIENTRY NullMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield) {
+	NULL_GL_CALL("glMapBufferRange")
+	stats.bufferUploads++;
+	stats.bufferBytes += (size_t) length;
+	return BoundStore(target, (size_t) (offset+length)).data()+offset;
+}
+
+GLboolean APIENTRY NullUnmapBuffer(GLenum) { NULL_GL_CALL("glUnmapBuffer") return GL_TRUE; }
+
+GLsync APIENTRY NullFenceSync(GLenum, GLbitfield) { NULL_GL_CALL("glFenceSync") return (GLsync) ++nSyncs; }
+GLenum APIENTRY NullClientWaitSync(GLsync, GLbitfield, GLuint64) {
+	NULL_GL_CALL("glClientWaitSync")
+	return GL_ALREADY_SIGNALED;
+}
+void APIENTRY NullDeleteSync(GLsync) { NULL_GL_CALL("glDeleteSync") }
+
+// Vertex Arrays
+
+void APIENTRY NullGenVertexArrays(GLsizei n, GLuint *names) { NULL_GL_CALL("glGenVertexArrays") GenNames(n, names); }
+void APIENTRY NullDeleteVertexArrays(GLsizei, const GLuint *) { NULL_GL_CALL("glDeleteVertexArrays") }
+void APIENTRY NullBindVertexArray(GLuint) { NULL_GL_CALL("glBindVertexArray") stats.stateChanges++; }
+void APIENTRY NullEnableVertexAttribArray(GLuint) { NULL_GL_CALL("glEnableVertexAttribArray") stats.stateChanges++; }
+void APIENTRY NullDisableVertexAttribArray(GLuint) { NULL_GL_CALL("glDisableVertexAttribArray") stats.stateChanges++; }
+void APIENTRY NullVertexAttribPointer(GLuint, GLint, GLenum, GLboolean, GLsizei, const void *) {
+	NULL_GL_CALL("glVertexAttribPointer")
+	stats.stateChanges++;
+}
+void APIENTRY NullVertexAttribIPointer(GLuint, GLint, GLenum, GLsizei, const void *) {
+	NULL_GL_CALL("glVertexAttribIPointer")
+	stats.stateChanges++;
+}
+void APIENTRY NullVertexAttribDivisor(GLuint, GLuint) { NULL_GL_CALL("glVertexAttribDivisor") stats.stateChanges++; }
+
+// Textures
+
+void APIENTRY NullGenTextures(GLsizei n, GLuint *names) { NULL_GL_CALL("glGenTextures") GenNames(n, names); }
+void APIENTRY NullDeleteTextures(GLsizei, const GLuint *) { NULL_GL_CALL("glDeleteTextures") }
+void APIENTRY NullActiveTexture(GLenum) { NULL_GL_CALL("glActiveTexture") stats.stateChanges++; }
+void APIENTRY NullBindTexture(GLenum, GLuint) { NULL_GL_CALL("glBindTexture") stats.stateChanges++; }
+void APIENTRY NullTexParameteri(GLenum, GLenum, GLint) { NULL_GL_CALL("glTexParameteri") stats.stateChanges++; }
+void APIENTRY NullPixelStorei(GLenum, GLint) { NULL_GL_CALL("glPixelStorei") stats.stateChanges++; }
+void APIENTRY NullGenerateMipmap(GLenum) { NULL_GL_CALL("glGenerateMipmap") }
+void APIENTRY NullTexStorage2D(GLenum, GLsizei, GLenum, GLsizei, GLsizei) { NULL_GL_CALL("glTexStorage2D") }
+void APIENTRY NullTexBuffer(GLenum, GLenum, GLuint) { NULL_GL_CALL("glTexBuffer") stats.stateChanges++; }
+void APIENTRY NullTexImage2DMultisample(GLenum, GLsizei, GLenum, GLsizei, GLsizei, GLboolean) {
+	NULL_GL_CALL("glTexImage2DMultisample")
+}
+
+void APIENTRY NullTexImage2D(GLenum, GLint, GLint, GLsizei width, GLsizei height, GLint, GLenum format, GLenum type,
+						 const void *pixels) {
+	NULL_GL_CALL("glTexImage2D")
+	TextureUpload(width, height, 1, format, type, pixels);
+}
+
+void APIENTRY NullTexSubImage2D(GLenum, GLint, GLint, GLint, GLsizei width, GLsizei height, GLenum format, GLenum type,
+							const void *pixels) {
+	NULL_GL_CALL("glTexSubImage2D")
+	TextureUpload(width, height, 1, format, type, pixels);
+}
+
+void APIENTRY NullReadPixels(GLint, GLint, GLsizei width, GLsizei height, GLenum format, GLenum type, void *pixels) {
+	NULL_GL_CALL("glReadPixels")
+	stats.queries++;
+	if (!boundBuffers[GL_PIXEL_PACK_BUFFER])
+		memset(pixels, 0, (size_t) width*height*TexelBytes(format, type));
+}
+
+// Framebuffers
+
+void APIENTRY NullGenFramebuffers(GLsizei n, GLuint *names) { NULL_GL_CALL("glGenFramebuffers") GenNames(n, names); }
+void APIENTRY NullGenRenderbuffers(GLsizei n, GLuint *names) { NULL_GL_CALL("glGenRenderbuffers") GenNames(n, names); }
+void APIENTRY NullBindFramebuffer(GLenum, GLuint) { NULL_GL_CALL("glBindFramebuffer") stats.stateChanges++; }
+void APIENTRY NullBindRenderbuffer(GLenum, GLuint) { NULL_GL_CALL("glBindRenderbuffer") stats.stateChanges++; }
+void APIENTRY NullRenderbufferStorage(GLenum, GLenum, GLsizei, GLsizei) { NULL_GL_CALL("glRenderbufferStorage") }
+void APIENTRY NullRenderbufferStorageMultisample(GLenum, GLsizei, GLenum, GLsizei, GLsizei) {
+	NULL_GL_CALL("glRenderbufferStorageMultisample")
+}
+void APIENTRY NullFramebufferTexture(GLenum, GLenum, GLuint, GLint) { NULL_GL_CALL("glFramebufferTexture") }
+void APIENTRY NullFramebufferTexture2D(GLenum, GLenum, GLenum, GLuint, GLint) { NULL_GL_CALL("glFramebufferTexture2D") }
+void APIENTRY NullFramebufferRenderbuffer(GLenum, GLenum, GLenum, GLuint) { NULL_GL_CALL("glFramebufferRenderbuffer") }
+void APIENTRY NullDrawBuffers(GLsizei, const GLenum *) { NULL_GL_CALL("glDrawBuffers") stats.stateChanges++; }
+GLenum APIENTRY NullCheckFramebufferStatus(GLenum) {
+	NULL_GL_CALL("glCheckFramebufferStatus")
+	stats.queries++;
+	return GL_FRAMEBUFFER_COMPLETE;
+}
+
+// Shaders And Programs
+
+GLuint APIENTRY NullCreateShader(GLenum) { NULL_GL_CALL("glCreateShader") return nextName++; }
+GLuint APIENTRY NullCreateProgram() { NULL_GL_CALL("glCreateProgram") return nextName++; }
+void APIENTRY NullShaderSource(GLuint, GLsizei, const GLchar *const *, const GLint *) { NULL_GL_CALL("glShaderSource") }
+void APIENTRY NullCompileShader(GLuint) { NULL_GL_CALL("glCompileShader") }
+void APIENTRY NullAttachShader(GLuint, GLuint) { NULL_GL_CALL("glAttachShader") }
+void APIENTRY NullDetachShader(GLuint, GLuint) { NULL_GL_CALL("glDetachShader") }
+void APIENTRY NullDeleteShader(GLuint) { NULL_GL_CALL("glDeleteShader") }
+void APIENTRY NullLinkProgram(GLuint) { NULL_GL_CALL("glLinkProgram") }
+void APIENTRY NullDeleteProgram(GLuint) { NULL_GL_CALL("glDeleteProgram") }
+void APIENTRY NullProgramBinary(GLuint, GLenum, const void *, GLsizei) { NULL_GL_CALL("glProgramBinary") }
+
+void APIENTRY NullUseProgram(GLuint p) {
+	NULL_GL_CALL("glUseProgram")
+	stats.stateChanges++;
+	program = p;
+}
+
+void APIENTRY NullGetShaderiv(GLuint, GLenum pname, GLint *params) {
+	NULL_GL_CALL("glGetShaderiv")
+	stats.queries++;
+	*params = pname == GL_COMPILE_STATUS? GL_TRUE : 0;
+}
+
+void APIENTRY NullGetProgramiv(GLuint, GLenum pname, GLint *params) {
+	NULL_GL_CALL("glGetProgramiv")
+	stats.queries++;
+	*params = pname == GL_LINK_STATUS? GL_TRUE : 0;
+}
+
+void APIENTRY NullGetShaderInfoLog(GLuint, GLsizei bufSize, GLsizei *length, GLchar *log) {
+	NULL_GL_CALL("glGetShaderInfoLog")
+	if (length) *length = 0;
+	if (bufSize > 0) log[0] = 0;
+}
+
+void APIENTRY NullGetProgramInfoLog(GLuint, GLsizei bufSize, GLsizei *length, GLchar *log) {
+	NULL_GL_CALL("glGetProgramInfoLog")
+	if (length) *length = 0;
+	if (bufSize > 0) log[0] = 0;
+}
+
+void APIENTRY NullGetProgramBinary(GLuint, GLsizei, GLsizei *length, GLenum *format, void *) {
+	NULL_GL_CALL("glGetProgramBinary")
+	if (length) *length = 0;
+	*format = 0;
+}
+
+void APIENTRY NullGetAttachedShaders(GLuint, GLsizei, GLsizei *count, GLuint *) {
+	NULL_GL_CALL("glGetAttachedShaders")
+	if (count) *count = 0;
+}
+
+void APIENTRY NullGetActiveAttrib(GLuint, GLuint, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name) {
+	NULL_GL_CALL("glGetActiveAttrib")
+	if (length) *length = 0;
+	*size = 0;
+	*type = 0;
+	if (bufSize > 0) name[0] = 0;
+}
+
+void APIENTRY NullGetActiveUniform(GLuint, GLuint, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name) {
+	NULL_GL_CALL("glGetActiveUniform")
+	if (length) *length = 0;
+	*size = 0;
+	*type = 0;
+	if (bufSize > 0) name[0] = 0;
+}
+
+// locations are numbered per program in the order names are first asked for, so no two names share one
+GLint Location(Locations &locations, GLuint p, const GLchar *name) {
+	std::pair<GLuint, std::string> key(p, name);
+	auto found = locations.find(key);
+	if (found != locations.end())
+		return found->second;
+	GLint location = 0;
+	for (auto &l : locations)
+		if (l.first.first == p)
+			location++;
+	return locations[key] = location;
+}
+
+GLint APIENTRY NullGetUniformLocation(GLuint p, const GLchar *name) {
+	NULL_GL_CALL("glGetUniformLocation")
+	stats.queries++;
+	return Location(uniformLocations, p, name);
+}
+
+GLint APIENTRY NullGetAttribLocation(GLuint p, const GLchar *name) {
+	NULL_GL_CALL("glGetAttribLocation")
+	stats.queries++;
+	return Location(attribLocations, p, name);
+}
+
+void APIENTRY NullGetUniformiv(GLuint, GLint, GLint *params) {
+	NULL_GL_CALL("glGetUniformiv")
+	stats.queries++;
+	*params = 0;
+}
+
+// Uniforms
+
+void APIENTRY NullUniform1i(GLint, GLint) { NULL_GL_CALL("glUniform1i") stats.uniforms++; }
+void APIENTRY NullUniform1ui(GLint, GLuint) { NULL_GL_CALL("glUniform1ui") stats.uniforms++; }
+void APIENTRY NullUniform1f(GLint, GLfloat) { NULL_GL_CALL("glUniform1f") stats.uniforms++; }
+void APIENTRY NullUniform2f(GLint, GLfloat, GLfloat) { NULL_GL_CALL("glUniform2f") stats.uniforms++; }
+void APIENTRY NullUniform2i(GLint, GLint, GLint) { NULL_GL_CALL("glUniform2i") stats.uniforms++; }
+void APIENTRY NullUniform3f(GLint, GLfloat, GLfloat, GLfloat) { NULL_GL_CALL("glUniform3f") stats.uniforms++; }
+void APIENTRY NullUniform4f(GLint, GLfloat, GLfloat, GLfloat, GLfloat) { NULL_GL_CALL("glUniform4f") stats.uniforms++; }
+void APIENTRY NullUniform1iv(GLint, GLsizei, const GLint *) { NULL_GL_CALL("glUniform1iv") stats.uniforms++; }
+void APIENTRY NullUniform1fv(GLint, GLsizei, const GLfloat *) { NULL_GL_CALL("glUniform1fv") stats.uniforms++; }
+void APIENTRY NullUniform2fv(GLint, GLsizei, const GLfloat *) { NULL_GL_CALL("glUniform2fv") stats.uniforms++; }
+void APIENTRY NullUniform3fv(GLint, GLsizei, const GLfloat *) { NULL_GL_CALL("glUniform3fv") stats.uniforms++; }
+void APIENTRY NullUniform4fv(GLint, GLsizei, const GLfloat *) { NULL_GL_CALL("glUniform4fv") stats.uniforms++; }
+void APIENTRY NullUniformMatrix4fv(GLint, GLsizei, GLboolean, const GLfloat *) {
+	NULL_GL_CALL("glUniformMatrix4fv")
+	stats.uniforms++;
+}
+
+// Fixed Function State
+
+void APIENTRY NullEnable(GLenum cap) { NULL_GL_CALL("glEnable") stats.stateChanges++; enabled.insert(cap); }
+void APIENTRY NullDisable(GLenum cap) { NULL_GL_CALL("glDisable") stats.stateChanges++; enabled.erase(cap); }
+void APIENTRY NullBlendFunc(GLenum, GLenum) { NULL_GL_CALL("glBlendFunc") stats.stateChanges++; }
+void APIENTRY NullClearColor(GLfloat, GLfloat, GLfloat, GLfloat) { NULL_GL_CALL("glClearColor") stats.stateChanges++; }
+void APIENTRY NullLineWidth(GLfloat) { NULL_GL_CALL("glLineWidth") stats.stateChanges++; }
+void APIENTRY NullPatchParameteri(GLenum, GLint) { NULL_GL_CALL("glPatchParameteri") stats.stateChanges++; }
+void APIENTRY NullPatchParameterfv(GLenum, const GLfloat *) { NULL_GL_CALL("glPatchParameterfv") stats.stateChanges++; }
+
+void APIENTRY NullViewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+	NULL_GL_CALL("glViewport")
+	stats.stateChanges++;
+	viewport[0] = x; viewport[1] = y; viewport[2] = width; viewport[3] = height;
+}
+
+// Queries
+
+GLenum APIENTRY NullGetError() { NULL_GL_CALL("glGetError") stats.queries++; return GL_NO_ERROR; }
+
+GLboolean APIENTRY NullIsEnabled(GLenum cap) {
+	NULL_GL_CALL("glIsEnabled")
+	stats.queries++;
+	return enabled.count(cap)? GL_TRUE : GL_FALSE;
+}
+
+const GLubyte *APIENTRY NullGetString(GLenum name) {
+	NULL_GL_CALL("glGetString")
+	stats.queries++;
+	switch (name) {
+		case GL_VENDOR: return (const GLubyte *) "RoadRealm";
+		case GL_RENDERER: return (const GLubyte *) "Null GL";
+		case GL_VERSION: return (const GLubyte *) "4.5 Null GL";
+		case GL_SHADING_LANGUAGE_VERSION: return (const GLubyte *) "4.50";
+	}
+	return NULL;
+}
+
+const GLubyte *APIENTRY NullGetStringi(GLenum name, GLuint index) {
+	// glad needs at least one extension
+	NULL_GL_CALL("glGetStringi")
+	stats.queries++;
+	return name == GL_EXTENSIONS && index == 0? (const GLubyte *) "GL_ARB_buffer_storage" : NULL;
+}
+
+void APIENTRY NullGetIntegerv(GLenum pname, GLint *data) {
+	NULL_GL_CALL("glGetIntegerv")
+	stats.queries++;
+	switch (pname) {
+		case GL_VIEWPORT: memcpy(data, viewport, sizeof(viewport)); break;
+		case GL_CURRENT_PROGRAM: *data = (GLint) program; break;
+		case GL_NUM_EXTENSIONS: *data = 1; break;
+		case GL_MAJOR_VERSION: *data = 4; break;
+		case GL_MINOR_VERSION: *data = 5; break;
+		case GL_MAX_TEXTURE_SIZE: *data = 16384; break;
+		default: *data = 0;
+	}
+}
+
+void APIENTRY NullGetFloatv(GLenum pname, GLfloat *data) {
+	NULL_GL_CALL("glGetFloatv")
+	stats.queries++;
+	switch (pname) {
+		case GL_VIEWPORT: for (int i = 0; i < 4; i++) data[i] = (float) viewport[i]; break;
+		case GL_DEPTH_RANGE: data[0] = 0; data[1] = 1; break;
+		default: *data = 0;
+	}
+}
+
+#undef NULL_GL_CALL
+
+// Function Table
+//	the casts to the glad pointer types check each stub's signature
+
+struct Proc {
+	const char *name;
+	void *stub;
+};
+
+const Proc procs[] = {
+	{"glDrawArrays", (void *) (PFNGLDRAWARRAYSPROC) NullDrawArrays},
+	{"glDrawArraysInstanced", (void *) (PFNGLDRAWARRAYSINSTANCEDPROC) NullDrawArraysInstanced},
+	{"glDrawArraysInstancedBaseInstance", (void *) (PFNGLDRAWARRAYSINSTANCEDBASEINSTANCEPROC) NullDrawArraysInstancedBaseInstance},
+	{"glDrawElements", (void *) (PFNGLDRAWELEMENTSPROC) NullDrawElements},
+	{"glMultiDrawArrays", (void *) (PFNGLMULTIDRAWARRAYSPROC) NullMultiDrawArrays},
+	{"glClear", (void *) (PFNGLCLEARPROC) NullClear},
+	{"glFlush", (void *) (PFNGLFLUSHPROC) NullFlush},
+	{"glFinish", (void *) (PFNGLFINISHPROC) NullFinish},
+	{"glGenBuffers", (void *) (PFNGLGENBUFFERSPROC) NullGenBuffers},
+	{"glDeleteBuffers", (void *) (PFNGLDELETEBUFFERSPROC) NullDeleteBuffers},
+	{"glBindBuffer", (void *) (PFNGLBINDBUFFERPROC) NullBindBuffer},
+	{"glBindBufferBase", (void *) (PFNGLBINDBUFFERBASEPROC) NullBindBufferBase},
+	{"glBufferData", (void *) (PFNGLBUFFERDATAPROC) NullBufferData},
+	{"glBufferStorage", (void *) (PFNGLBUFFERSTORAGEPROC) NullBufferStorage},
+	{"glBufferSubData", (void *) (PFNGLBUFFERSUBDATAPROC) NullBufferSubData},
+	{"glGetBufferSubData", (void *) (PFNGLGETBUFFERSUBDATAPROC) NullGetBufferSubData},
+	{"glMapBufferRange", (void *) (PFNGLMAPBUFFERRANGEPROC) NullMapBufferRange},
+	{"glUnmapBuffer", (void *) (PFNGLUNMAPBUFFERPROC) NullUnmapBuffer},
+	{"glFenceSync", (void *) (PFNGLFENCESYNCPROC) NullFenceSync},
+	{"glClientWaitSync", (void *) (PFNGLCLIENTWAITSYNCPROC) NullClientWaitSync},
+	{"glDeleteSync", (void *) (PFNGLDELETESYNCPROC) NullDeleteSync},
+	{"glGenVertexArrays", (void *) (PFNGLGENVERTEXARRAYSPROC) NullGenVertexArrays},
+	{"glDeleteVertexArrays", (void *) (PFNGLDELETEVERTEXARRAYSPROC) NullDeleteVertexArrays},
+	{"glBindVertexArray", (void *) (PFNGLBINDVERTEXARRAYPROC) NullBindVertexArray},
+	{"glEnableVertexAttribArray", (void *) (PFNGLENABLEVERTEXATTRIBARRAYPROC) NullEnableVertexAttribArray},
+	{"glDisableVertexAttribArray", (void *) (PFNGLDISABLEVERTEXATTRIBARRAYPROC) NullDisableVertexAttribArray},
+	{"glVertexAttribPointer", (void *) (PFNGLVERTEXATTRIBPOINTERPROC) NullVertexAttribPointer},
+	{"glVertexAttribIPointer", (void *) (PFNGLVERTEXATTRIBIPOINTERPROC) NullVertexAttribIPointer},
+	{"glVertexAttribDivisor", (void *) (PFNGLVERTEXATTRIBDIVISORPROC) NullVertexAttribDivisor},
+	{"glGenTextures", (void *) (PFNGLGENTEXTURESPROC) NullGenTextures},
+	{"glDeleteTextures", (void *) (PFNGLDELETETEXTURESPROC) NullDeleteTextures},
+	{"glActiveTexture", (void *) (PFNGLACTIVETEXTUREPROC) NullActiveTexture},
+	{"glBindTexture", (void *) (PFNGLBINDTEXTUREPROC) NullBindTexture},
+	{"glTexParameteri", (void *) (PFNGLTEXPARAMETERIPROC) NullTexParameteri},
+	{"glPixelStorei", (void *) (PFNGLPIXELSTOREIPROC) NullPixelStorei},
+	{"glGenerateMipmap", (void *) (PFNGLGENERATEMIPMAPPROC) NullGenerateMipmap},
+	{"glTexStorage2D", (void *) (PFNGLTEXSTORAGE2DPROC) NullTexStorage2D},
+	{"glTexBuffer", (void *) (PFNGLTEXBUFFERPROC) NullTexBuffer},
+	{"glTexImage2DMultisample", (void *) (PFNGLTEXIMAGE2DMULTISAMPLEPROC) NullTexImage2DMultisample},
+	{"glTexImage2D", (void *) (PFNGLTEXIMAGE2DPROC) NullTexImage2D},
+	{"glTexSubImage2D", (void *) (PFNGLTEXSUBIMAGE2DPROC) NullTexSubImage2D},
+	{"glReadPixels", (void *) (PFNGLREADPIXELSPROC) NullReadPixels},
+	{"glGenFramebuffers", (void *) (PFNGLGENFRAMEBUFFERSPROC) NullGenFramebuffers},
+	{"glGenRenderbuffers", (void *) (PFNGLGENRENDERBUFFERSPROC) NullGenRenderbuffers},
+	{"glBindFramebuffer", (void *) (PFNGLBINDFRAMEBUFFERPROC) NullBindFramebuffer},
+	{"glBindRenderbuffer", (void *) (PFNGLBINDRENDERBUFFERPROC) NullBindRenderbuffer},
+	{"glRenderbufferStorage", (void *) (PFNGLRENDERBUFFERSTORAGEPROC) NullRenderbufferStorage},
+	{"glRenderbufferStorageMultisample", (void *) (PFNGLRENDERBUFFERSTORAGEMULTISAMPLEPROC) NullRenderbufferStorageMultisample},
+	{"glFramebufferTexture", (void *) (PFNGLFRAMEBUFFERTEXTUREPROC) NullFramebufferTexture},
+	{"glFramebufferTexture2D", (void *) (PFNGLFRAMEBUFFERTEXTURE2DPROC) NullFramebufferTexture2D},
+	{"glFramebufferRenderbuffer", (void *) (PFNGLFRAMEBUFFERRENDERBUFFERPROC) NullFramebufferRenderbuffer},
+	{"glDrawBuffers", (void *) (PFNGLDRAWBUFFERSPROC) NullDrawBuffers},
+	{"glCheckFramebufferStatus", (void *) (PFNGLCHECKFRAMEBUFFERSTATUSPROC) NullCheckFramebufferStatus},
+	{"glCreateShader", (void *) (PFNGLCREATESHADERPROC) NullCreateShader},
+	{"glCreateProgram", (void *) (PFNGLCREATEPROGRAMPROC) NullCreateProgram},
+	{"glShaderSource", (void *) (PFNGLSHADERSOURCEPROC) NullShaderSource},
+	{"glCompileShader", (void *) (PFNGLCOMPILESHADERPROC) NullCompileShader},
+	{"glAttachShader", (void *) (PFNGLATTACHSHADERPROC) NullAttachShader},
+	{"glDetachShader", (void *) (PFNGLDETACHSHADERPROC) NullDetachShader},
+	{"glDeleteShader", (void *) (PFNGLDELETESHADERPROC) NullDeleteShader},
+	{"glLinkProgram", (void *) (PFNGLLINKPROGRAMPROC) NullLinkProgram},
+	{"glDeleteProgram", (void *) (PFNGLDELETEPROGRAMPROC) NullDeleteProgram},
+	{"glProgramBinary", (void *) (PFNGLPROGRAMBINARYPROC) NullProgramBinary},
+	{"glUseProgram", (void *) (PFNGLUSEPROGRAMPROC) NullUseProgram},
+	{"glGetShaderiv", (void *) (PFNGLGETSHADERIVPROC) NullGetShaderiv},
+	{"glGetProgramiv", (void *) (PFNGLGETPROGRAMIVPROC) NullGetProgramiv},
+	{"glGetShaderInfoLog", (void *) (PFNGLGETSHADERINFOLOGPROC) NullGetShaderInfoLog},
+	{"glGetProgramInfoLog", (void *) (PFNGLGETPROGRAMINFOLOGPROC) NullGetProgramInfoLog},
+	{"glGetProgramBinary", (void *) (PFNGLGETPROGRAMBINARYPROC) NullGetProgramBinary},
+	{"glGetAttachedShaders", (void *) (PFNGLGETATTACHEDSHADERSPROC) NullGetAttachedShaders},
+	{"glGetActiveAttrib", (void *) (PFNGLGETACTIVEATTRIBPROC) NullGetActiveAttrib},
+	{"glGetActiveUniform", (void *) (PFNGLGETACTIVEUNIFORMPROC) NullGetActiveUniform},
+	{"glGetUniformLocation", (void *) (PFNGLGETUNIFORMLOCATIONPROC) NullGetUniformLocation},
+	{"glGetAttribLocation", (void *) (PFNGLGETATTRIBLOCATIONPROC) NullGetAttribLocation},
+	{"glGetUniformiv", (void *) (PFNGLGETUNIFORMIVPROC) NullGetUniformiv},
+	{"glUniform1i", (void *) (PFNGLUNIFORM1IPROC) NullUniform1i},
+	{"glUniform1ui", (void *) (PFNGLUNIFORM1UIPROC) NullUniform1ui},
+	{"glUniform1f", (void *) (PFNGLUNIFORM1FPROC) NullUniform1f},
+	{"glUniform2f", (void *) (PFNGLUNIFORM2FPROC) NullUniform2f},
+	{"glUniform2i", (void *) (PFNGLUNIFORM2IPROC) NullUniform2i},
+	{"glUniform3f", (void *) (PFNGLUNIFORM3FPROC) NullUniform3f},
+	{"glUniform4f", (void *) (PFNGLUNIFORM4FPROC) NullUniform4f},
+	{"glUniform1iv", (void *) (PFNGLUNIFORM1IVPROC) NullUniform1iv},
+	{"glUniform1fv", (void *) (PFNGLUNIFORM1FVPROC) NullUniform1fv},
+	{"glUniform2fv", (void *) (PFNGLUNIFORM2FVPROC) NullUniform2fv},
+	{"glUniform3fv", (void *) (PFNGLUNIFORM3FVPROC) NullUniform3fv},
+	{"glUniform4fv", (void *) (PFNGLUNIFORM4FVPROC) NullUniform4fv},
+	{"glUniformMatrix4fv", (void *) (PFNGLUNIFORMMATRIX4FVPROC) NullUniformMatrix4fv},
+	{"glEnable", (void *) (PFNGLENABLEPROC) NullEnable},
+	{"glDisable", (void *) (PFNGLDISABLEPROC) NullDisable},
+	{"glBlendFunc", (void *) (PFNGLBLENDFUNCPROC) NullBlendFunc},
+	{"glClearColor", (void *) (PFNGLCLEARCOLORPROC) NullClearColor},
+	{"glLineWidth", (void *) (PFNGLLINEWIDTHPROC) NullLineWidth},
+	{"glPatchParameteri", (void *) (PFNGLPATCHPARAMETERIPROC) NullPatchParameteri},
+	{"glPatchParameterfv", (void *) (PFNGLPATCHPARAMETERFVPROC) NullPatchParameterfv},
+	{"glViewport", (void *) (PFNGLVIEWPORTPROC) NullViewport},
+	{"glGetError", (void *) (PFNGLGETERRORPROC) NullGetError},
+	{"glIsEnabled", (void *) (PFNGLISENABLEDPROC) NullIsEnabled},
+	{"glGetString", (void *) (PFNGLGETSTRINGPROC) NullGetString},
+	{"glGetStringi", (void *) (PFNGLGETSTRINGIPROC) NullGetStringi},
+	{"glGetIntegerv", (void *) (PFNGLGETINTEGERVPROC) NullGetIntegerv},
+	{"glGetFloatv", (void *) (PFNGLGETFLOATVPROC) NullGetFloatv}
+};
+
+void *NullGLProc(const char *name) {
+	for (const Proc &p : procs)
+		if (!strcmp(p.name, name))
+			return p.stub;
+	return NULL;
+}
+
+} // namespace
+
+int LoadNullGL() {
+	callCounts.clear();
+	for (const Proc &p : procs)
+		callCounts.push_back({p.name, 0});
+	int ok = gladLoadGLLoader((GLADloadproc) NullGLProc);
+	InvalidateGLState(); // new "context"
+	ResetNullGLStats();
+	for (NullGLCall &c : callCounts)
+		c.count = 0;
+	return ok;
+}
+
+NullGLCounters &NullGLStats() { return stats; }
+
+void ResetNullGLStats() { stats = NullGLCounters(); }
+
+int NullGLCalls(const NullGLCall **calls) {
+	*calls = callCounts.data();
+	return (int) callCounts.size();
+}
@@ -0,0 +1,49 @@
+// NullGLFW.cpp - windowless stand-ins for GLXtrasGLFW.cpp and the GLFW calls a headless program still links against
+
+//	link this instead of GLXtrasGLFW.cpp and the GLFW library to build a program that only ever runs on NullGL (or a
+//	SoftTarget): no window is made, InitGLFW returns NULL, and the window calls do nothing
+//	glfwGetTime reads a steady clock from the first call, as GLFW's timer starts at glfwInit
+
+#include <glad.h>
+#include "GLXtras.h"
+#include <chrono>
+
+namespace {
+
+std::chrono::steady_clock::time_point timeStart = std::chrono::steady_clock::now();
+
+} // end namespace
+
+// GLXtras.h
+
+GLFWwindow *InitGLFW(int, int, int, int, const char *, bool) { return NULL; }
+
+vec2 MouseCoords() { return vec2(0, 0); }
+
+bool Shift() { return false; }
+
+bool Control() { return false; }
+
+void RegisterMouseButton(MouseButtonCallback) { }
+
+void RegisterMouseMove(MouseMoveCallback) { }
+
+void RegisterMouseWheel(MouseWheelCallback) { }
+
+void RegisterResize(ResizeCallback) { }
+
+void RegisterKeyboard(KeyboardCallback) { }
+
+// GLFW
+
+double glfwGetTime() {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now()-timeStart).count();
+}
+
+int glfwWindowShouldClose(GLFWwindow *) { return 1; }
+
+void glfwSetWindowShouldClose(GLFWwindow *, int) { }
+
+void glfwSwapBuffers(GLFWwindow *) { }
+
+void glfwPollEvents() { }
@@ -0,0 +1,436 @@
+// SoftRaster.cpp - CPU rasterizer for the Draw.h primitives, into an RGBA8 framebuffer
+
+#include "SoftRaster.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <math.h>
+#include <mutex>
+#include <string.h>
+#include <thread>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define SOFT_RASTER_SSE2
+#endif
+
+namespace {
+
+SoftTarget *softTarget = NULL;
+
+// Pixels
+
+struct Paint {
+	unsigned char rgba[4];
+	int alpha; // 0-256
+	Paint(vec4 c) {
+		for (int i = 0; i < 4; i++)
+			rgba[i] = (unsigned char) (std::clamp(i < 3? c[i] : 1.f, 0.f, 1.f)*255.f+.5f);
+		alpha = (int) (std::clamp(c.w, 0.f, 1.f)*256.f+.5f);
+	}
+};
+
+inline void BlendPixel(unsigned char *d, const unsigned char s[4], int a) {
+	// a is 0-256
+	for (int i = 0; i < 4; i++)
+		d[i] = (unsigned char) ((d[i]*(256-a)+s[i]*a) >> 8);
+}
+
+void FillSpan(unsigned char *d, int n, const Paint &paint) {
+	// n pixels from d, four at a time where possible
+	if (n <= 0 || paint.alpha <= 0)
+		return;
+	uint32_t packed;
+	memcpy(&packed, paint.rgba, 4);
+	int i = 0;
+	if (paint.alpha >= 256) {
+#ifdef SOFT_RASTER_SSE2
+		__m128i v = _mm_set1_epi32((int) packed);
+		for (; i+4 <= n; i += 4)
+			_mm_storeu_si128((__m128i *) (d+4*i), v);
+#endif
+		for (; i < n; i++)
+			memcpy(d+4*i, &packed, 4);
+		return;
+	}
+#ifdef SOFT_RASTER_SSE2
+	// (dst*(256-a)+src*a)>>8 in 16-bit lanes: the weights sum to 256, so no lane exceeds 65280
+	__m128i zero = _mm_setzero_si128();
+	__m128i src = _mm_unpacklo_epi8(_mm_set1_epi32((int) packed), zero);
+	__m128i srcA = _mm_mullo_epi16(src, _mm_set1_epi16((short) paint.alpha));
+	__m128i dstA = _mm_set1_epi16((short) (256-paint.alpha));
+	for (; i+4 <= n; i += 4) {
+		__m128i dst = _mm_loadu_si128((__m128i *) (d+4*i));
+		__m128i lo = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(dst, zero), dstA), srcA), 8);
+		__m128i hi = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(dst, zero), dstA), srcA), 8);
+		_mm_storeu_si128((__m128i *) (d+4*i), _mm_packus_epi16(lo, hi));
+	}
+#endif
+	for (; i < n; i++)
+		BlendPixel(d+4*i, paint.rgba, paint.alpha);
+}
+
+inline float Coverage(float inside) {
+	// inside: signed distance, in pixels, from the pixel center to the edge (positive inside)
+	return std::clamp(inside+.5f, 0.f, 1.f);
+}
+
+// Fixed-Point Edges
+
+#define SOFT_SUBPIXEL_BITS 8
+#define SOFT_HALF_PIXEL (1 << (SOFT_SUBPIXEL_BITS-1))
+
+struct Fixed {
+	int64_t x, y;
+	Fixed(vec2 p) {
+		// vertices farther than 2^20 pixels are clamped, which keeps every edge product below 2^60
+		const float limit = (float) (1 << 20);
+		x = llrintf(std::clamp(p.x, -limit, limit)*(1 << SOFT_SUBPIXEL_BITS));
+		y = llrintf(std::clamp(p.y, -limit, limit)*(1 << SOFT_SUBPIXEL_BITS));
+	}
+};
+
+int64_t FloorDiv(int64_t n, int64_t d) { return n/d-((n%d != 0) && ((n < 0) != (d < 0))); } // d != 0
+
+struct Edge {
+	// E(x, y) = dx*(y-a.y)-dy*(x-a.x) is exact, so the edge b->a of a neighbor evaluates to exactly -E
+	// E > 0 left of a->b, inside a counter-clockwise triangle; E == 0 counts as inside for a top edge (horizontal,
+	// inside below) or a left edge (inside to the right), never for both directions of one edge
+	int64_t ax, ay, dx, dy, bias;
+	Edge(Fixed a, Fixed b) : ax(a.x), ay(a.y), dx(b.x-a.x), dy(b.y-a.y) {
+		bias = (dy < 0 || (dy == 0 && dx < 0))? 0 : 1;
+	}
+	void Clip(int y, int64_t &xa, int64_t &xb) const {
+		// narrow [xa, xb) to the pixels of row y whose centers have E >= bias; E = P-Q*x along the row
+		int64_t cy = ((int64_t) y << SOFT_SUBPIXEL_BITS)+SOFT_HALF_PIXEL;
+		int64_t P = dx*(cy-ay)-dy*(SOFT_HALF_PIXEL-ax), Q = dy << SOFT_SUBPIXEL_BITS;
+		if (Q == 0) {
+			if (P < bias) xb = xa;
+		}
+		else if (Q < 0)
+			xa = std::max(xa, -FloorDiv(P-bias, -Q));
+		else
+			xb = std::min(xb, FloorDiv(P-bias, Q)+1);
+	}
+};
+
+struct TriangleEdges {
+	Edge e[3];
+	bool empty;
+	TriangleEdges(const vec2 p[3]) : TriangleEdges(Fixed(p[0]), Fixed(p[1]), Fixed(p[2])) { }
+	TriangleEdges(Fixed a, Fixed b, Fixed c) : e{Edge(a, b), Edge(b, c), Edge(c, a)} {
+		// orientation from the snapped vertices, so slivers cannot flip between setup and test
+		int64_t area = (b.x-a.x)*(c.y-a.y)-(b.y-a.y)*(c.x-a.x);
+		empty = area == 0;
+		if (area < 0) {
+			e[0] = Edge(a, c);
+			e[1] = Edge(c, b);
+			e[2] = Edge(b, a);
+		}
+	}
+	bool Span(int y, int x0, int x1, int &xa, int &xb) const {
+		// pixels of row y, within [x0, x1), that the triangle covers
+		int64_t a = x0, b = x1;
+		for (int i = 0; i < 3; i++)
+			e[i].Clip(y, a, b);
+		xa = (int) a;
+		xb = (int) b;
+		return !empty && a < b;
+	}
+};
+
+} // end namespace
+
+SoftTarget *CurrentSoftTarget() { return softTarget; }
+
+void SetSoftTarget(SoftTarget *target) { softTarget = target; }
+
+// Setup
+
+void SoftTarget::Resize(int w, int h) {
+	width = w;
+	height = h;
+	pixels.assign((size_t) 4*w*h, 0);
+	commands.clear();
+}
+
+void SoftTarget::SetThreads(int n) { nThreads = n; }
+
+void SoftTarget::SetView(mat4 m) { view = m; }
+
+vec2 SoftTarget::Pixel(vec3 p) {
+	vec4 x = view*vec4(p, 1);
+	return vec2((x.x/x.w+1)*.5f*(float)width, (x.y/x.w+1)*.5f*(float)height);
+}
+
+void SoftTarget::Bound(Command &c, vec2 lo, vec2 hi) {
+	c.x0 = std::max(0, (int) floor(lo.x));
+	c.y0 = std::max(0, (int) floor(lo.y));
+	c.x1 = std::min(width, (int) ceil(hi.x)+1);
+	c.y1 = std::min(height, (int) ceil(hi.y)+1);
+	if (c.x0 < c.x1 && c.y0 < c.y1)
+		commands.push_back(c);
+}
+
+// Primitives
+
+void SoftTarget::Clear(vec3 color, float opacity) {
+	if (opacity >= 1)
+		commands.clear(); // nothing queued would show
+	Command c;
+	c.type = Clear_;
+	c.color = vec4(color, opacity);
+	Bound(c, vec2(0, 0), vec2((float) width, (float) height));
+}
+
+void SoftTarget::Triangle(vec3 p1, vec3 p2, vec3 p3, vec4 color) {
+	Command c;
+	c.type = Triangle_;
+	c.p[0] = Pixel(p1);
+	c.p[1] = Pixel(p2);
+	c.p[2] = Pixel(p3);
+	c.color = color;
+	Bound(c, vec2(std::min({c.p[0].x, c.p[1].x, c.p[2].x}), std::min({c.p[0].y, c.p[1].y, c.p[2].y})),
+			 vec2(std::max({c.p[0].x, c.p[1].x, c.p[2].x}), std::max({c.p[0].y, c.p[1].y, c.p[2].y})));
+}
+
+void SoftTarget::Quad(vec3 p1, vec3 p2, vec3 p3, vec3 p4, vec4 color) {
+	Triangle(p1, p2, p3, color);
+	Triangle(p1, p3, p4, color);
+}
+
+void SoftTarget::Line(vec3 p1, vec3 p2, float w, vec4 col1, vec4 col2) {
+	Command c;
+	c.type = Line_;
+	c.p[0] = Pixel(p1);
+	c.p[1] = Pixel(p2);
+	c.width = std::max(w, 1.f);
+	c.color = col1;
+	c.color2 = col2;
+	float r = c.width/2+1;
+	Bound(c, vec2(std::min(c.p[0].x, c.p[1].x)-r, std::min(c.p[0].y, c.p[1].y)-r),
+			 vec2(std::max(c.p[0].x, c.p[1].x)+r, std::max(c.p[0].y, c.p[1].y)+r));
+}
+
+void SoftTarget::Disk(vec3 p, float diameter, vec4 color, bool ring) {
+	Command c;
+	c.type = Disk_;
+	c.p[0] = Pixel(p);
+	c.width = diameter/2; // radius
+	c.color = color;
+	c.ring = ring;
+	float r = c.width+1;
+	Bound(c, c.p[0]-vec2(r, r), c.p[0]+vec2(r, r));
+}
+
+void SoftTarget::Glyph(vec3 p1, vec3 p2, vec3 p3, vec2 uv1, vec2 uv2, vec2 uv3, vec3 color, const unsigned char *alpha, int w, int h) {
+	Command c;
+	c.type = Glyph_;
+	c.p[0] = Pixel(p1);
+	c.p[1] = Pixel(p2);
+	c.p[2] = Pixel(p3);
+	c.uv[0] = uv1;
+	c.uv[1] = uv2;
+	c.uv[2] = uv3;
+	c.color = vec4(color, 1);
+	c.alpha = alpha;
+	c.alphaW = w;
+	c.alphaH = h;
+	Bound(c, vec2(std::min({c.p[0].x, c.p[1].x, c.p[2].x}), std::min({c.p[0].y, c.p[1].y, c.p[2].y})),
+			 vec2(std::max({c.p[0].x, c.p[1].x, c.p[2].x}), std::max({c.p[0].y, c.p[1].y, c.p[2].y})));
+}
+
+// Rasterization
+
+void SoftTarget::Rasterize(const Command &c, int tx0, int ty0, int tx1, int ty1) {
+	int x0 = std::max(tx0, c.x0), x1 = std::min(tx1, c.x1), y0 = std::max(ty0, c.y0), y1 = std::min(ty1, c.y1);
+	if (x0 >= x1 || y0 >= y1)
+		return;
+	Paint paint(c.color);
+	if (c.type == Clear_) {
+		for (int y = y0; y < y1; y++)
+			FillSpan(&pixels[4*((size_t) y*width+x0)], x1-x0, paint);
+		return;
+	}
+	if (c.type == Triangle_) {
+		TriangleEdges edges(c.p);
+		for (int y = y0, xa, xb; y < y1; y++)
+			if (edges.Span(y, x0, x1, xa, xb))
+				FillSpan(&pixels[4*((size_t) y*width+xa)], xb-xa, paint);
+		return;
+	}
+	if (c.type == Line_) {
+		// butt-ended rectangle of the line's width, as GL draws wide lines, with a one pixel soft edge
+		vec2 d = c.p[1]-c.p[0];
+		float len = length(d), halfW = c.width/2;
+		vec2 u = len > 0? d/len : vec2(1, 0);
+		Paint paint2(c.color2);
+		for (int y = y0; y < y1; y++)
+			for (int x = x0; x < x1; x++) {
+				vec2 q = vec2((float) x+.5f, (float) y+.5f)-c.p[0];
+				float along = dot(q, u), across = fabsf(q.x*u.y-q.y*u.x);
+				float cover = Coverage(halfW-across)*Coverage(std::min(along, len-along));
+				if (cover <= 0)
+					continue;
+				float t = len > 0? std::clamp(along/len, 0.f, 1.f) : 0;
+				vec4 col = c.color+t*(c.color2-c.color);
+				Paint p(col);
+				BlendPixel(&pixels[4*((size_t) y*width+x)], p.rgba, (int) (p.alpha*cover));
+			}
+		return;
+	}
+	if (c.type == Disk_) {
+		// per row: the run where the disk is solid is one span, only the pixels around it are shaded one by one
+		float r = c.width, inner = r-.5f, ringEdge = .8f*r;
+		for (int y = y0; y < y1; y++) {
+			float dy = (float) y+.5f-c.p[0].y;
+			if (fabsf(dy) > r+.5f)
+				continue;
+			int solidA = x1, solidB = x1;
+			if (!c.ring && fabsf(dy) < inner) {
+				float h = sqrtf(inner*inner-dy*dy);
+				solidA = std::max(x0, (int) ceil(c.p[0].x-h-.5f));
+				solidB = std::min(x1, (int) floor(c.p[0].x+h-.5f)+1);
+			}
+			unsigned char *row = &pixels[4*(size_t) y*width];
+			for (int x = x0; x < x1; x++) {
+				if (x == solidA && solidA < solidB) {
+					FillSpan(row+4*x, solidB-solidA, paint);
+					x = solidB-1;
+					continue;
+				}
+				float dx = (float) x+.5f-c.p[0].x, dist = sqrtf(dx*dx+dy*dy);
+				float cover = Coverage(r-dist);
+				if (c.ring)
+					cover *= Coverage(dist-ringEdge);
+				if (cover > 0)
+					BlendPixel(row+4*x, paint.rgba, (int) (paint.alpha*cover));
+			}
+		}
+		return;
+	}
+	if (c.type == Glyph_) {
+		// coverage as for triangles, so the two triangles of a glyph quad do not both blend their diagonal
+		vec2 a = c.p[0], b = c.p[1], e = c.p[2];
+		float area = (b.x-a.x)*(e.y-a.y)-(b.y-a.y)*(e.x-a.x);
+		if (area == 0)
+			return;
+		TriangleEdges edges(c.p);
+		for (int y = y0, xa, xb; y < y1; y++) {
+			if (!edges.Span(y, x0, x1, xa, xb))
+				continue;
+			for (int x = xa; x < xb; x++) {
+				vec2 q((float) x+.5f, (float) y+.5f);
+				float w0 = ((b.x-q.x)*(e.y-q.y)-(b.y-q.y)*(e.x-q.x))/area;
+				float w1 = ((e.x-q.x)*(a.y-q.y)-(e.y-q.y)*(a.x-q.x))/area;
+				float w2 = 1-w0-w1;
+				vec2 uv = w0*c.uv[0]+w1*c.uv[1]+w2*c.uv[2];
+				int tx = std::clamp((int) (uv.x*(float) c.alphaW), 0, c.alphaW-1);
+				int ty = std::clamp((int) (uv.y*(float) c.alphaH), 0, c.alphaH-1);
+				int a8 = 255-c.alpha[ty*c.alphaW+tx];
+				if (a8 > 0)
+					BlendPixel(&pixels[4*((size_t) y*width+x)], paint.rgba, (a8*256)/255);
+			}
+		}
+	}
+}
+
+// Workers
+
+struct SoftTarget::Workers {
+	// helper threads wait for a job; Run publishes it under a new generation, runs it on the calling thread too,
+	// and returns once every helper has finished it
+	std::vector<std::thread> threads;
+	std::mutex mutex;
+	std::condition_variable start, finish;
+	void (*job)(void *) = NULL;
+	void *arg = NULL;
+	uint64_t generation = 0;
+	int running = 0;
+	bool quit = false;
+	Workers(int n) {
+		for (int i = 0; i < n; i++)
+			threads.emplace_back([this]() { Loop(); });
+	}
+	~Workers() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			quit = true;
+		}
+		start.notify_all();
+		for (std::thread &t : threads)
+			t.join();
+	}
+	void Loop() {
+		uint64_t seen = 0;
+		for (;;) {
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				start.wait(lock, [&]() { return quit || generation != seen; });
+				if (quit)
+					return;
+				seen = generation;
+			}
+			job(arg);
+			std::lock_guard<std::mutex> lock(mutex);
+			if (--running == 0)
+				finish.notify_one();
+		}
+	}
+	void Run(void (*fn)(void *), void *a) {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			job = fn;
+			arg = a;
+			running = (int) threads.size();
+			generation++;
+		}
+		start.notify_all();
+		fn(a);
+		std::unique_lock<std::mutex> lock(mutex);
+		finish.wait(lock, [&]() { return running == 0; });
+	}
+};
+
+SoftTarget::~SoftTarget() { delete workers; }
+
+void SoftTarget::Resolve() {
+	if (commands.empty() || !width || !height)
+		return;
+	// bin each primitive into the tiles its bounds touch
+	int nx = (width+SOFT_TILE-1)/SOFT_TILE, ny = (height+SOFT_TILE-1)/SOFT_TILE, nTiles = nx*ny;
+	std::vector<std::vector<int>> bins(nTiles);
+	for (int i = 0; i < (int) commands.size(); i++) {
+		const Command &c = commands[i];
+		for (int ty = c.y0/SOFT_TILE; ty <= (c.y1-1)/SOFT_TILE; ty++)
+			for (int tx = c.x0/SOFT_TILE; tx <= (c.x1-1)/SOFT_TILE; tx++)
+				bins[ty*nx+tx].push_back(i);
+	}
+	// tiles are independent: threads take the next unclaimed one until none is left
+	std::atomic<int> next(0);
+	auto work = [&]() {
+		for (int t; (t = next++) < nTiles;) {
+			int tx0 = (t%nx)*SOFT_TILE, ty0 = (t/nx)*SOFT_TILE;
+			int tx1 = std::min(tx0+SOFT_TILE, width), ty1 = std::min(ty0+SOFT_TILE, height);
+			for (int i : bins[t])
+				Rasterize(commands[i], tx0, ty0, tx1, ty1);
+		}
+	};
+	int n = nThreads > 0? nThreads : (int) std::thread::hardware_concurrency();
+	n = std::max(n, 1);
+	if (n == 1)
+		work();
+	else {
+		// the helpers outlive this frame; they are replaced only when the thread count changes
+		if (!workers || (int) workers->threads.size() != n-1) {
+			delete workers;
+			workers = new Workers(n-1);
+		}
+		workers->Run([](void *w) { (*(decltype(work) *) w)(); }, &work);
+	}
+	commands.clear();
+}
+
+const unsigned char *SoftTarget::Pixels() {
+	Resolve();
+	return pixels.data();
+}
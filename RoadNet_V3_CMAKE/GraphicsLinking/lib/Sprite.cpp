@@ -1,8 +1,10 @@
 // Sprite.cpp
 
 #include "Draw.h"
+#include "GLState.h"
 #include "GLXtras.h"
 #include "IO.h"
+#include "SoftRaster.h"
 #include "Sprite.h"
 #include <algorithm>
 #include <iostream>
@@ -185,7 +187,7 @@ int TestCollisions(vector<Sprite *> &sprites) {
 		tmp[i]->id = i;
 	sort(tmp.begin(), tmp.end(), ZCompare);
 	GLuint program = SpriteSpace::GetCollisionShader();
-	glUseProgram(program);
+	UseProgram(program);
 	vec4 vp = VP();
 	SetUniform(program, "vp", vp);
 	SetUniform(program, "showOccupy", true);
@@ -199,7 +201,7 @@ int TestCollisions(vector<Sprite *> &sprites) {
 	}
 	SetUniform(program, "showOccupy", false);
 	UseDrawShader(ScreenMode());
-	glUseProgram(0);
+	UseProgram(0);
 	return ReadCounter();
 }
 
@@ -220,14 +222,16 @@ bool Sprite::Intersect(Sprite &s) {
 	return !xNoOverlap && !yNoOverlap;
 }
 
-void Sprite::Initialize(GLuint texName, float z) {
+void Sprite::Initialize(GLuint texName, float z, bool owns) {
 	this->z = z;
 	textureName = texName;
+	ownsTexture = owns;
 }
 
 void Sprite::Initialize(string imageFile, float z) {
 	this->z = z;
 	textureName = ReadTexture(imageFile.c_str(), true, &nTexChannels, &imgWidth, &imgHeight);
+	ownsTexture = true;
 }
 
 void Sprite::Initialize(string imageFile, string matFile, float z) {
@@ -315,27 +319,28 @@ int GetSpriteShader() {
 }
 
 void Sprite::Display(mat4 *fullview, int textureUnit) {
+	if (CurrentSoftTarget())
+		return; // image is on the GPU only
 	int s = CurrentProgram();
 	if (s <= 0 || (s != spriteShader && s != spriteCollisionShader))
 		s = SpriteSpace::GetShader();
-	glUseProgram(s);
-	glActiveTexture(GL_TEXTURE0+textureUnit);
+	UseProgram(s);
+	ActiveTexture(GL_TEXTURE0+textureUnit);
 	if (nFrames) { // animation
 		time_t now = clock();
 		if (now > change) {
 			frame = (frame+1)%nFrames;
 			change = now+(time_t)(frameDuration*CLOCKS_PER_SEC);
 		}
-		glBindTexture(GL_TEXTURE_2D, textureNames[frame]);
+		BindTexture(GL_TEXTURE_2D, textureNames[frame]);
 	}
-	else glBindTexture(GL_TEXTURE_2D, textureName);
+	else BindTexture(GL_TEXTURE_2D, textureName);
 	SetUniform(s, "textureImage", (int) textureUnit);
 	SetUniform(s, "useMat", matName > 0);
 	SetUniform(s, "nTexChannels", nTexChannels);
 	SetUniform(s, "z", z);
 	if (matName > 0) {
-		glActiveTexture(GL_TEXTURE0+textureUnit+1);
-		glBindTexture(GL_TEXTURE_2D, matName);
+		BindTexture(textureUnit+1, GL_TEXTURE_2D, matName);
 		SetUniform(s, "textureMat", (int) textureUnit+1);
 	}
 	SetUniform(s, "view", fullview? *fullview*ptTransform : ptTransform);
@@ -350,6 +355,7 @@ void Sprite::Display(mat4 *fullview, int textureUnit) {
 void Sprite::SetFrameDuration(float dt) { frameDuration = dt; }
 
 void Sprite::Release() {
-	glDeleteBuffers(1, &textureName);
-	if (matName > 0) glDeleteBuffers(1, &matName);
+	if (textureName > 0 && ownsTexture) DeleteTextures(1, &textureName);
+	if (matName > 0) DeleteTextures(1, &matName);
+	textureName = matName = 0; // the destructor releases again
 }
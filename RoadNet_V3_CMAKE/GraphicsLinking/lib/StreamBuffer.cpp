@@ -0,0 +1,123 @@
+// StreamBuffer.cpp - persistently mapped ring of vertex memory for geometry rebuilt every frame
+
+#include <glad.h>
+#include "GLState.h"
+#include "StreamBuffer.h"
+
+StreamBuffer &VertexStream() {
+	static StreamBuffer stream;
+	return stream;
+}
+
+void StreamBuffer::Create() {
+	glGenBuffers(1, &buffer);
+	BindBuffer(GL_ARRAY_BUFFER, buffer);
+	GLsizeiptr size = (GLsizeiptr) (STREAM_SEGMENTS*segmentBytes);
+	if (GLAD_GL_VERSION_4_4 && glBufferStorage) {
+		persistentFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		glBufferStorage(GL_ARRAY_BUFFER, size, NULL, persistentFlags);
+		mapped = (char *) glMapBufferRange(GL_ARRAY_BUFFER, 0, size, persistentFlags);
+		if (!mapped) {
+			// driver refused the persistent map: fall back to a mutable buffer mapped per span
+			DeleteBuffers(1, &buffer);
+			glGenBuffers(1, &buffer);
+			BindBuffer(GL_ARRAY_BUFFER, buffer);
+			persistentFlags = 0;
+		}
+	}
+	if (!persistentFlags)
+		glBufferData(GL_ARRAY_BUFFER, size, NULL, GL_STREAM_DRAW);
+	segment = 0;
+	head = 0;
+	generation++;
+}
+
+void StreamBuffer::NextSegment() {
+	segment = (segment+1)%STREAM_SEGMENTS;
+	head = 0;
+	if (!persistentFlags) {
+		// each byte of the storage is written once, so no fences: on wrap, orphan, and the driver hands back fresh
+		// storage while the GPU keeps reading the old
+		if (segment == 0) {
+			BindBuffer(GL_ARRAY_BUFFER, buffer);
+			glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr) (STREAM_SEGMENTS*segmentBytes), NULL, GL_STREAM_DRAW);
+		}
+		return;
+	}
+	// fence what the previous segment was given, then wait (normally not at all) until the GPU is done with this one
+	int previous = (segment+STREAM_SEGMENTS-1)%STREAM_SEGMENTS;
+	if (fences[previous])
+		glDeleteSync(fences[previous]);
+	fences[previous] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	GLsync fence = fences[segment];
+	if (fence) {
+		GLenum r = glClientWaitSync(fence, 0, 0);
+		if (r == GL_TIMEOUT_EXPIRED) {
+			stalls++;
+			while (r == GL_TIMEOUT_EXPIRED)
+				r = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000); // 1 ms
+		}
+		glDeleteSync(fence);
+		fences[segment] = 0;
+	}
+}
+
+void *StreamBuffer::Map(size_t bytes, size_t align, GLintptr &offset) {
+	if (!buffer)
+		Create();
+	if (bytes+align > segmentBytes) {
+		// too big for any segment: replace the buffer with a larger one (the old is freed once the GPU is done)
+		Release();
+		while (bytes+align > segmentBytes)
+			segmentBytes *= 2;
+		Create();
+	}
+	size_t base = (size_t) segment*segmentBytes;
+	size_t start = ((base+head+align-1)/align)*align;
+	if (start+bytes > base+segmentBytes) {
+		NextSegment();
+		base = (size_t) segment*segmentBytes;
+		start = ((base+align-1)/align)*align;
+	}
+	head = start+bytes-base;
+	offset = (GLintptr) start;
+	bytesMapped += bytes;
+	BindBuffer(GL_ARRAY_BUFFER, buffer);
+	if (persistentFlags)
+		return mapped+start;
+	spanMapped = true;
+	return glMapBufferRange(GL_ARRAY_BUFFER, offset, (GLsizeiptr) bytes,
+							GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+}
+
+void StreamBuffer::Unmap() {
+	// coherent mapping: writes are visible to the next draw without a flush
+	if (spanMapped) {
+		BindBuffer(GL_ARRAY_BUFFER, buffer);
+		glUnmapBuffer(GL_ARRAY_BUFFER);
+		spanMapped = false;
+	}
+}
+
+void StreamBuffer::EndFrame() {
+	if (buffer && head > 0)
+		NextSegment();
+}
+
+void StreamBuffer::Release() {
+	for (GLsync &f : fences)
+		if (f) {
+			glDeleteSync(f);
+			f = 0;
+		}
+	if (buffer) {
+		if (persistentFlags) {
+			BindBuffer(GL_ARRAY_BUFFER, buffer);
+			glUnmapBuffer(GL_ARRAY_BUFFER);
+		}
+		DeleteBuffers(1, &buffer);
+	}
+	buffer = 0;
+	mapped = NULL;
+	persistentFlags = 0;
+}
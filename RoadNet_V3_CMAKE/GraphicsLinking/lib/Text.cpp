@@ -4,11 +4,15 @@
 
 #include <glad.h>
 #include "Draw.h"
+#include "GLState.h"
 #include "GLXtras.h"
 #include "Letters.h"
+#include "StreamBuffer.h"
 #include "Text.h"
 #include <map>
+#include <stdarg.h>
 #include <stdio.h>
+#include <string.h>
 
 // if FreeType not linked, undefine next line:
 // #define FREETYPE_OK
@@ -18,7 +22,7 @@
 	if (format) {                                      \
 		va_list ap;                                    \
 		va_start(ap, format);                          \
-		_vsnprintf(buffer, maxBufferSize, format, ap); \
+		vsnprintf(buffer, maxBufferSize, format, ap);  \
 		va_end(ap);                                    \
 	}                                                  \
 }
@@ -41,6 +45,11 @@ void Text(float x, float y, vec3 color, float scale, const char *format, ...) {
 	FormatString(text, 500, format);
 	Letters((int) x, (int) y, text, color, scaleAdj*scale);
 }
+void Text(TextBatch &batch, int x, int y, vec3 color, float scale, const char *format, ...) {
+	char text[500];
+	FormatString(text, 500, format);
+	batch.Add(x, y, text, color, scaleAdj*scale);
+}
 void RenderText(const char *text, float x, float y, vec3 color, float scale, mat4 view) {
 	vec2 s = ScreenPoint(vec3(x, y, 0), view);
 	Letters((int) s.x, (int) s.y, text, color, scaleAdj*scale);
@@ -64,7 +73,7 @@ CharacterSet *SetFont(const char *fontName, int charRes, int pixelRes, bool forc
 
 using std::string;
 
-static GLuint textShaderProgram = 0, textVertexBuffer = 0;
+static GLuint textShaderProgram = 0;
 
 CharacterSet *currentFont = NULL;
 
@@ -95,7 +104,7 @@ void SetCharacterSet(CharacterSet &cs, const char *fontName, int charRes, int pi
 			// generate texture
 			GLuint texture;
 			glGenTextures(1, &texture);
-			glBindTexture(GL_TEXTURE_2D, texture);
+			BindTexture(GL_TEXTURE_2D, texture);
 			glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 			glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, g->bitmap.width, g->bitmap.rows, 0, GL_RED, GL_UNSIGNED_BYTE, g->bitmap.buffer);
 			// texture options
@@ -152,44 +161,54 @@ void RenderText(const char *text, float x, float y, vec3 color, float scale, mat
 	}
 	if (!textShaderProgram)
 		textShaderProgram = LinkProgramViaCode(&textVertexShader, &textPixelShader);
-	glUseProgram(textShaderProgram);
+	UseProgram(textShaderProgram);
+	BindVertexArray(0); // point attribute goes on the default vertex array, not on one a batch left bound
 	scale /= (float) currentFont->charRes;
-	// create quad vertex buffer and build characters
-	if (textVertexBuffer == 0)
-		glGenBuffers(1, &textVertexBuffer);
-	glBindBuffer(GL_ARRAY_BUFFER, textVertexBuffer);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(float)*6*4, NULL, GL_DYNAMIC_DRAW);
-	VertexAttribPointer(textShaderProgram, "point", 4, 4*sizeof(float), 0);
-	SetUniform(textShaderProgram, "view", view);
-	SetUniform(textShaderProgram, "color", color);
-	// SetUniform(textShaderProgram, "textureImage", (int) textureID); // not needed? (defaults to 0?)
-	glActiveTexture(GL_TEXTURE0);
-	glBindBuffer(GL_ARRAY_BUFFER, textVertexBuffer);
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-	for (const char *c = text; *c; c++) {
+	// write every glyph quad into the vertex stream, then draw each with its own glyph texture
+#ifdef GL_QUADS
+	const int nGlyphVertices = 4;
+#else
+	const int nGlyphVertices = 6;
+#endif
+	int nGlyphs = (int) strlen(text);
+	if (!nGlyphs)
+		return;
+	GLintptr offset = 0;
+	float (*vertices)[4] = (float (*)[4]) VertexStream().Map(nGlyphs*nGlyphVertices*4*sizeof(float), 4*sizeof(float), offset);
+	for (const char *c = text; *c; c++, vertices += nGlyphVertices) {
 		Character ch = currentFont->characters[(int)*c];
 		float xpos = x+ch.bearing.i1*scale, ypos = y-(ch.gSize.i2-ch.bearing.i2)*scale;
 		float w = ch.gSize.i1*scale, h = ch.gSize.i2*scale;
-		glBindTexture(GL_TEXTURE_2D, ch.textureID);
-		// update vertex memory
 #ifdef GL_QUADS
-		float vertices[][4] = {{xpos, ypos+h, 0, 0}, {xpos+w, ypos+h, 1, 0}, {xpos+w, ypos, 1, 1}, {xpos, ypos, 0, 1}};
-		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-		glDrawArrays(GL_QUADS, 0, 4);     // render glyph texture with quad
+		float quad[][4] = {{xpos, ypos+h, 0, 0}, {xpos+w, ypos+h, 1, 0}, {xpos+w, ypos, 1, 1}, {xpos, ypos, 0, 1}};
 #else
-		float vertices[][4] = {{xpos, ypos+h, 0, 0}, {xpos+w, ypos+h, 1, 0}, {xpos+w, ypos, 1, 1},
-							   {xpos, ypos+h, 0, 0}, {xpos+w, ypos, 1, 1},   {xpos, ypos, 0, 1}};
-		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-		glDrawArrays(GL_TRIANGLES, 0, 6); // render glyph texture with triangles
+		float quad[][4] = {{xpos, ypos+h, 0, 0}, {xpos+w, ypos+h, 1, 0}, {xpos+w, ypos, 1, 1},
+						   {xpos, ypos+h, 0, 0}, {xpos+w, ypos, 1, 1},   {xpos, ypos, 0, 1}};
 #endif
+		memcpy(vertices, quad, sizeof(quad));
 		if (vertical)
 			y -= 24*scale;
 		else
 			x += (ch.advance >> 6)*scale;     // advance character position in terms of 1/64 pixel
 	}
-	glBindVertexArray(0);
-	glBindTexture(GL_TEXTURE_2D, 0);
+	VertexStream().Unmap();
+	VertexAttribPointer(textShaderProgram, "point", 4, 4*sizeof(float), (void *) offset);
+	SetUniform(textShaderProgram, "view", view);
+	SetUniform(textShaderProgram, "color", color);
+	// SetUniform(textShaderProgram, "textureImage", (int) textureID); // not needed? (defaults to 0?)
+	ActiveTexture(GL_TEXTURE0);
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	int first = (int) (offset/(4*sizeof(float)));
+	for (const char *c = text; *c; c++, first += nGlyphVertices) {
+		BindTexture(GL_TEXTURE_2D, currentFont->characters[(int)*c].textureID);
+#ifdef GL_QUADS
+		glDrawArrays(GL_QUADS, first, 4);     // render glyph texture with quad
+#else
+		glDrawArrays(GL_TRIANGLES, first, 6); // render glyph texture with triangles
+#endif
+	}
+	BindTexture(GL_TEXTURE_2D, 0);
 }
 
 float TextWidth(float scale, const char *format, ...) {
@@ -235,6 +254,13 @@ void Text(float x, float y, vec3 color, float scale, const char *format, ...) {
 	RenderText(text, x, y, color, scale, ScreenMode());
 }
 
+void Text(TextBatch &batch, int x, int y, vec3 color, float scale, const char *format, ...) {
+	// glyphs are separate FreeType textures, so draw now rather than batch
+	char text[500];
+	FormatString(text, 500, format);
+	RenderText(text, (float) x, (float) y, color, scale, ScreenMode());
+}
+
 #endif
 
 const int nnicemax = 100;
@@ -0,0 +1,415 @@
+/**
+ * @file AllocTelemetry.h
+ * @author Team 8: Edwin Kaburu, Vincent Marklynn, Yong Long Tan
+ * @date 10/19/2026
+ */
+
+#ifndef ROADREALM_ALLOCTELEMETRY_H
+#define ROADREALM_ALLOCTELEMETRY_H
+
+/**
+ * Heap Allocation Telemetry, enabled with the ROADREALM_ALLOC_TELEMETRY build option. The instrumented build replaces
+ * the global operator new/delete, aligned forms included, and attributes every allocation to the innermost ALLOC_ZONE
+ * on the calling thread. Each thread counts into its own AllocThread, so the render thread's allocations never land
+ * in a simulation tick; ALLOC_TELEMETRY_END_FRAME closes a frame of the calling thread's AllocThread only.
+ * Like the other RoadNet headers it defines its globals, so it is only included by the game's translation unit.
+ */
+
+enum AllocZone {
+    ALLOC_ZONE_OTHER = 0,
+    ALLOC_ZONE_UPDATE,
+    ALLOC_ZONE_DISPLAY,
+    ALLOC_ZONE_TOGGLE_DRAGGED,
+    ALLOC_ZONE_INFO_PANEL,
+    ALLOC_ZONE_COUNT
+};
+
+enum AllocThread {
+    // Asset Decode, Record Writer, Audio Mixer And Any Thread Not Named With ALLOC_THREAD
+    ALLOC_THREAD_OTHER = 0,
+    ALLOC_THREAD_SIMULATION,
+    ALLOC_THREAD_RENDER,
+    ALLOC_THREAD_COUNT
+};
+
+#ifdef ROADREALM_ALLOC_TELEMETRY
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+using namespace std;
+
+// Frames Kept For CSV Export
+#define ALLOC_HISTORY_FRAMES 4096
+// Frames Ignored Before The Steady-State Budget Applies
+#define ALLOC_WARMUP_FRAMES 120
+// Allocations Allowed Per Steady-State Simulation Tick
+#define ALLOC_FRAME_BUDGET 0
+
+/**
+ * @struct AllocFrameRecord
+ * @details Allocation Counts Of A Finished Frame
+ */
+struct AllocFrameRecord {
+    uint32_t frameIndex = 0;
+    uint32_t allocations[ALLOC_ZONE_COUNT] = {};
+    uint64_t bytes[ALLOC_ZONE_COUNT] = {};
+    uint32_t frees = 0;
+
+    uint32_t TotalAllocations() const {
+        uint32_t total = 0;
+        for (uint32_t count: allocations) {
+            total += count;
+        }
+        return total;
+    }
+
+    uint64_t TotalBytes() const {
+        uint64_t total = 0;
+        for (uint64_t count: bytes) {
+            total += count;
+        }
+        return total;
+    }
+};
+
+/**
+ * @class AllocTelemetry
+ * @details Per-thread, per-zone allocation counters, each thread's folded into its own fixed history ring once per
+ * frame. Nothing here allocates, so the telemetry never shows up in its own numbers.
+ */
+class AllocTelemetry {
+private:
+    inline static atomic<uint32_t> zoneAllocations[ALLOC_THREAD_COUNT][ALLOC_ZONE_COUNT] = {};
+    inline static atomic<uint64_t> zoneBytes[ALLOC_THREAD_COUNT][ALLOC_ZONE_COUNT] = {};
+    inline static atomic<uint32_t> frameFrees[ALLOC_THREAD_COUNT] = {};
+    inline static thread_local int currentZone = ALLOC_ZONE_OTHER;
+    inline static thread_local int currentThread = ALLOC_THREAD_OTHER;
+
+    inline static AllocFrameRecord history[ALLOC_THREAD_COUNT][ALLOC_HISTORY_FRAMES];
+    inline static uint32_t framesRecorded[ALLOC_THREAD_COUNT] = {}, budgetViolations = 0;
+
+public:
+    /**
+     * RecordAllocation() Count An Allocation Against The Current Thread And Zone
+     *
+     * @param size Size Bytes
+     */
+    static void RecordAllocation(size_t size) {
+        zoneAllocations[currentThread][currentZone].fetch_add(1, memory_order_relaxed);
+        zoneBytes[currentThread][currentZone].fetch_add(size, memory_order_relaxed);
+    }
+
+    /**
+     * RecordFree() Count A Release Against The Current Thread
+     */
+    static void RecordFree() { frameFrees[currentThread].fetch_add(1, memory_order_relaxed); }
+
+    /**
+     * EnterThread() Count This Thread's Allocations As Another AllocThread, e.g. a headless render thread ticking
+     * the simulation itself
+     *
+     * @param thread AllocThread
+     * @return Integer Previous AllocThread
+     */
+    static int EnterThread(int thread) {
+        int previous = currentThread;
+        currentThread = thread;
+        return previous;
+    }
+
+    /**
+     * LeaveThread() Restore The AllocThread Active Before EnterThread()
+     *
+     * @param previous Integer Previous AllocThread
+     */
+    static void LeaveThread(int previous) { currentThread = previous; }
+
+    /**
+     * EnterZone() Make A Zone Current On This Thread
+     *
+     * @param zone AllocZone
+     * @return Integer Previous Zone
+     */
+    static int EnterZone(int zone) {
+        int previous = currentZone;
+        currentZone = zone;
+        return previous;
+    }
+
+    /**
+     * LeaveZone() Restore The Zone Active Before EnterZone()
+     *
+     * @param previous Integer Previous Zone
+     */
+    static void LeaveZone(int previous) { currentZone = previous; }
+
+    /**
+     * EndFrame() Move The Calling Thread's Frame Counters Into Its History, and check a simulation tick against the
+     * steady-state budget
+     */
+    static void EndFrame() {
+        int thread = currentThread;
+        uint32_t &frames = framesRecorded[thread];
+        AllocFrameRecord &record = history[thread][frames % ALLOC_HISTORY_FRAMES];
+        record.frameIndex = frames;
+        for (int zone = 0; zone < ALLOC_ZONE_COUNT; zone++) {
+            record.allocations[zone] = zoneAllocations[thread][zone].exchange(0, memory_order_relaxed);
+            record.bytes[zone] = zoneBytes[thread][zone].exchange(0, memory_order_relaxed);
+        }
+        record.frees = frameFrees[thread].exchange(0, memory_order_relaxed);
+        if (thread == ALLOC_THREAD_SIMULATION && frames >= ALLOC_WARMUP_FRAMES &&
+            record.TotalAllocations() > ALLOC_FRAME_BUDGET) {
+            budgetViolations++;
+        }
+        frames++;
+    }
+
+    /**
+     * LastFrame() Counters Of A Thread's Most Recent Finished Frame
+     *
+     * @param thread AllocThread
+     * @return AllocFrameRecord
+     */
+    static const AllocFrameRecord &LastFrame(int thread = ALLOC_THREAD_SIMULATION) {
+        return history[thread][(framesRecorded[thread] + ALLOC_HISTORY_FRAMES - 1) % ALLOC_HISTORY_FRAMES];
+    }
+
+    /**
+     * FramesRecorded() Number Of Frames A Thread Has Finished
+     *
+     * @param thread AllocThread
+     * @return Unsigned Count
+     */
+    static uint32_t FramesRecorded(int thread = ALLOC_THREAD_SIMULATION) { return framesRecorded[thread]; }
+
+    /**
+     * BudgetViolations() Number Of Steady-State Simulation Ticks Which Allocated Over Budget
+     *
+     * @return Unsigned Count
+     */
+    static uint32_t BudgetViolations() { return budgetViolations; }
+
+    /**
+     * ThreadName() Printable AllocThread Name
+     *
+     * @param thread Integer AllocThread
+     * @return Char Pointer Name
+     */
+    static const char *ThreadName(int thread) {
+        static const char *names[ALLOC_THREAD_COUNT] = {"Other", "Simulation", "Render"};
+        return names[thread];
+    }
+
+    /**
+     * ZoneName() Printable Zone Name
+     *
+     * @param zone Integer Zone
+     * @return Char Pointer Name
+     */
+    static const char *ZoneName(int zone) {
+        static const char *names[ALLOC_ZONE_COUNT] = {"Other", "Update", "Display", "ToggleDraggedCellsStates",
+                                                      "InfoPanel"};
+        return names[zone];
+    }
+
+    /**
+     * ExportCsv() Write The Recorded Frames Of Every Thread That Ends Frames, oldest first
+     *
+     * @param path Char Pointer File Path
+     * @return Boolean Condition
+     */
+    static bool ExportCsv(const char *path) {
+        FILE *file = fopen(path, "w");
+        if (file == nullptr) {
+            return false;
+        }
+        fprintf(file, "thread,frame");
+        for (int zone = 0; zone < ALLOC_ZONE_COUNT; zone++) {
+            fprintf(file, ",%s_allocs,%s_bytes", ZoneName(zone), ZoneName(zone));
+        }
+        fprintf(file, ",frees\n");
+
+        for (int thread = 0; thread < ALLOC_THREAD_COUNT; thread++) {
+            uint32_t frames = framesRecorded[thread];
+            uint32_t count = frames < ALLOC_HISTORY_FRAMES ? frames : ALLOC_HISTORY_FRAMES;
+            for (uint32_t i = frames - count; i < frames; i++) {
+                const AllocFrameRecord &record = history[thread][i % ALLOC_HISTORY_FRAMES];
+                fprintf(file, "%s,%u", ThreadName(thread), record.frameIndex);
+                for (int zone = 0; zone < ALLOC_ZONE_COUNT; zone++) {
+                    fprintf(file, ",%u,%llu", record.allocations[zone], (unsigned long long) record.bytes[zone]);
+                }
+                fprintf(file, ",%u\n", record.frees);
+            }
+        }
+        fclose(file);
+        return true;
+    }
+};
+
+/**
+ * @struct AllocZoneScope
+ * @details Attributes Allocations To A Zone For The Lifetime Of The Scope
+ */
+struct AllocZoneScope {
+    int previousZone;
+
+    explicit AllocZoneScope(AllocZone zone) : previousZone(AllocTelemetry::EnterZone(zone)) {}
+
+    ~AllocZoneScope() { AllocTelemetry::LeaveZone(previousZone); }
+
+    AllocZoneScope(const AllocZoneScope &) = delete;
+
+    AllocZoneScope &operator=(const AllocZoneScope &) = delete;
+};
+
+/**
+ * @struct AllocThreadScope
+ * @details Counts The Calling Thread As An AllocThread For The Lifetime Of The Scope
+ */
+struct AllocThreadScope {
+    int previousThread;
+
+    explicit AllocThreadScope(AllocThread thread) : previousThread(AllocTelemetry::EnterThread(thread)) {}
+
+    ~AllocThreadScope() { AllocTelemetry::LeaveThread(previousThread); }
+
+    AllocThreadScope(const AllocThreadScope &) = delete;
+
+    AllocThreadScope &operator=(const AllocThreadScope &) = delete;
+};
+
+/**
+ * TelemetryAllocate() Counted Allocation Shared By Every Operator New Replacement
+ *
+ * @param size Size Bytes
+ * @return Void Pointer, null on failure
+ */
+inline void *TelemetryAllocate(size_t size) {
+    AllocTelemetry::RecordAllocation(size);
+    return malloc(size == 0 ? 1 : size);
+}
+
+/**
+ * TelemetryAllocateAligned() Counted Allocation For The Over-Aligned Operator New Replacements
+ *
+ * @param size Size Bytes
+ * @param alignment Align_val_t Power Of Two Alignment
+ * @return Void Pointer, null on failure; release with TelemetryFreeAligned()
+ */
+inline void *TelemetryAllocateAligned(size_t size, align_val_t alignment) {
+    AllocTelemetry::RecordAllocation(size);
+#ifdef _WIN32
+    return _aligned_malloc(size == 0 ? 1 : size, (size_t) alignment);
+#else
+    void *block = nullptr;
+    size_t align = (size_t) alignment < sizeof(void *) ? sizeof(void *) : (size_t) alignment;
+    return posix_memalign(&block, align, size == 0 ? 1 : size) == 0 ? block : nullptr;
+#endif
+}
+
+/**
+ * TelemetryFreeAligned() Counted Release Of A TelemetryAllocateAligned() Block
+ *
+ * @param block Void Pointer
+ */
+inline void TelemetryFreeAligned(void *block) {
+    if (block != nullptr) {
+        AllocTelemetry::RecordFree();
+#ifdef _WIN32
+        _aligned_free(block);
+#else
+        free(block);
+#endif
+    }
+}
+
+void *operator new(size_t size) {
+    void *block = TelemetryAllocate(size);
+    if (block == nullptr) {
+        throw bad_alloc();
+    }
+    return block;
+}
+
+void *operator new[](size_t size) {
+    void *block = TelemetryAllocate(size);
+    if (block == nullptr) {
+        throw bad_alloc();
+    }
+    return block;
+}
+
+void *operator new(size_t size, const nothrow_t &) noexcept { return TelemetryAllocate(size); }
+
+void *operator new[](size_t size, const nothrow_t &) noexcept { return TelemetryAllocate(size); }
+
+void operator delete(void *block) noexcept {
+    if (block != nullptr) {
+        AllocTelemetry::RecordFree();
+        free(block);
+    }
+}
+
+void operator delete[](void *block) noexcept { operator delete(block); }
+
+void operator delete(void *block, size_t) noexcept { operator delete(block); }
+
+void operator delete[](void *block, size_t) noexcept { operator delete(block); }
+
+void operator delete(void *block, const nothrow_t &) noexcept { operator delete(block); }
+
+void operator delete[](void *block, const nothrow_t &) noexcept { operator delete(block); }
+
+void *operator new(size_t size, align_val_t alignment) {
+    void *block = TelemetryAllocateAligned(size, alignment);
+    if (block == nullptr) {
+        throw bad_alloc();
+    }
+    return block;
+}
+
+void *operator new[](size_t size, align_val_t alignment) { return operator new(size, alignment); }
+
+void *operator new(size_t size, align_val_t alignment, const nothrow_t &) noexcept {
+    return TelemetryAllocateAligned(size, alignment);
+}
+
+void *operator new[](size_t size, align_val_t alignment, const nothrow_t &) noexcept {
+    return TelemetryAllocateAligned(size, alignment);
+}
+
+void operator delete(void *block, align_val_t) noexcept { TelemetryFreeAligned(block); }
+
+void operator delete[](void *block, align_val_t) noexcept { TelemetryFreeAligned(block); }
+
+void operator delete(void *block, size_t, align_val_t) noexcept { TelemetryFreeAligned(block); }
+
+void operator delete[](void *block, size_t, align_val_t) noexcept { TelemetryFreeAligned(block); }
+
+void operator delete(void *block, align_val_t, const nothrow_t &) noexcept { TelemetryFreeAligned(block); }
+
+void operator delete[](void *block, align_val_t, const nothrow_t &) noexcept { TelemetryFreeAligned(block); }
+
+#define ALLOC_ZONE_CONCAT_INNER(a, b) a##b
+#define ALLOC_ZONE_CONCAT(a, b) ALLOC_ZONE_CONCAT_INNER(a, b)
+#define ALLOC_ZONE(zone) AllocZoneScope ALLOC_ZONE_CONCAT(allocZoneScope, __LINE__)(zone)
+#define ALLOC_THREAD(thread) AllocThreadScope ALLOC_ZONE_CONCAT(allocThreadScope, __LINE__)(thread)
+#define ALLOC_TELEMETRY_END_FRAME() AllocTelemetry::EndFrame()
+
+#else
+
+#define ALLOC_ZONE(zone)
+#define ALLOC_THREAD(thread)
+#define ALLOC_TELEMETRY_END_FRAME()
+
+#endif //ROADREALM_ALLOC_TELEMETRY
+
+#endif //ROADREALM_ALLOCTELEMETRY_H
@@ -0,0 +1,346 @@
+/**
+ * @file AssetLoader.h
+ * @author Team 8: Edwin Kaburu, Vincent Marklynn, Yong Long Tan
+ * @date 10/19/2026
+ */
+
+#ifndef ROADREALM_ASSETLOADER_H
+#define ROADREALM_ASSETLOADER_H
+
+#include <glad.h>
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "FrameProfiler.h"
+#include "GLState.h"
+#include "STB_Image.h"
+#include "Sprite.h"
+
+using namespace std;
+
+// Pixel Bytes Uploaded Per Pump, so a frame never stalls on a burst of finished decodes
+#define ASSET_UPLOAD_BUDGET (8 * 1024 * 1024)
+// Pixel Unpack Buffers Cycled Through, each orphaned before reuse
+#define ASSET_UNPACK_BUFFERS 3
+
+enum AssetSlot {
+    ASSET_IMAGE, ASSET_FRAME, ASSET_MAT
+};
+
+/**
+ * @struct AssetTarget
+ * @details Texture Slot Of A Sprite Waiting For Its Image
+ */
+struct AssetTarget {
+    Sprite *sprite = nullptr;
+    AssetSlot slot = ASSET_IMAGE;
+    int frame = 0;
+    string path;
+};
+
+/**
+ * @struct DecodedImage
+ * @details Pixels Produced By A Decode Worker, owned until the GL thread uploads them
+ */
+struct DecodedImage {
+    int target = -1;
+    unsigned char *pixels = nullptr;
+    int width = 0, height = 0, channels = 0;
+};
+
+/**
+ * @class AssetLoader
+ * @details Decodes images on a pool of worker threads while the GL thread streams finished ones into textures through
+ * pixel unpack buffers. Sprites get a transparent placeholder at request time and their real texture on the Pump()
+ * that uploads it, so the first frame does not wait for any image.
+ */
+class AssetLoader {
+private:
+    vector<thread> workers;
+    mutex jobLock;
+    condition_variable jobReady;
+    deque<pair<int, string>> jobs;
+    bool stopping = false;
+
+    mutex decodedLock;
+    vector<DecodedImage> decoded;
+
+    // GL Thread Only
+    vector<AssetTarget> targets;
+    int outstanding = 0;
+    GLuint placeholder = 0;
+    GLuint unpackBuffers[ASSET_UNPACK_BUFFERS] = {};
+    int nextUnpackBuffer = 0;
+
+    /**
+     * DecodeWorker() Pull Paths Off The Job Queue And Decode Them Until Stopped
+     */
+    void DecodeWorker() {
+        PROFILE_WORKER_THREAD("AssetDecode");
+        // Flip Is Per Thread, so workers match ReadTexture without touching the GL thread's setting
+        stbi_set_flip_vertically_on_load_thread(true);
+        while (true) {
+            pair<int, string> job;
+            {
+                unique_lock<mutex> lock(jobLock);
+                jobReady.wait(lock, [this] { return stopping || !jobs.empty(); });
+                if (stopping) {
+                    return;
+                }
+                job = move(jobs.front());
+                jobs.pop_front();
+            }
+            PROFILE_ZONE("DecodeAsset");
+            DecodedImage image;
+            image.target = job.first;
+            image.pixels = stbi_load(job.second.c_str(), &image.width, &image.height, &image.channels, 0);
+            if (image.pixels == nullptr) {
+                cout << "Asset could not be decoded: " << job.second << " (" << stbi_failure_reason() << ")" << endl;
+            } else if (image.channels != 3 && image.channels != 4) {
+                // Grey And Grey-Alpha Images Are Rare Enough To Re-Decode As RGBA
+                stbi_image_free(image.pixels);
+                image.pixels = stbi_load(job.second.c_str(), &image.width, &image.height, &image.channels, 4);
+                image.channels = 4;
+            }
+            lock_guard<mutex> lock(decodedLock);
+            decoded.push_back(image);
+        }
+    }
+
+    /**
+     * Start() Create The Placeholder, unpack buffers and worker threads on first use
+     */
+    void Start() {
+        if (!workers.empty()) {
+            return;
+        }
+        if (placeholder == 0) {
+            const unsigned char transparent[4] = {0, 0, 0, 0};
+            glGenTextures(1, &placeholder);
+            BindTexture(GL_TEXTURE_2D, placeholder);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, transparent);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            BindTexture(GL_TEXTURE_2D, 0);
+            glGenBuffers(ASSET_UNPACK_BUFFERS, unpackBuffers);
+        }
+
+        stopping = false;
+        int threadCount = max(1, (int) thread::hardware_concurrency() - 1);
+        for (int i = 0; i < threadCount; i++) {
+            workers.emplace_back(&AssetLoader::DecodeWorker, this);
+        }
+    }
+
+    /**
+     * Enqueue() Register A Target And Hand Its Path To The Workers
+     *
+     * @param target AssetTarget
+     */
+    void Enqueue(const AssetTarget &target) {
+        Start();
+        targets.push_back(target);
+        outstanding++;
+        {
+            lock_guard<mutex> lock(jobLock);
+            jobs.emplace_back((int) targets.size() - 1, target.path);
+        }
+        jobReady.notify_one();
+    }
+
+    /**
+     * Upload() Stream One Decoded Image Into A New Texture And Give It To Its Sprite
+     *
+     * @param image DecodedImage
+     */
+    void Upload(const DecodedImage &image) {
+        PROFILE_ZONE("UploadAsset");
+        AssetTarget &target = targets[image.target];
+        size_t bytes = (size_t) image.width * image.height * image.channels;
+
+        // Orphan, Fill And Unmap, the copy into the texture then runs without blocking this thread
+        BindBuffer(GL_PIXEL_UNPACK_BUFFER, unpackBuffers[nextUnpackBuffer]);
+        nextUnpackBuffer = (nextUnpackBuffer + 1) % ASSET_UNPACK_BUFFERS;
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr) bytes, nullptr, GL_STREAM_DRAW);
+        void *mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, (GLsizeiptr) bytes,
+                                        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        const void *source = nullptr;
+        if (mapped != nullptr) {
+            memcpy(mapped, image.pixels, bytes);
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        } else {
+            BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            source = image.pixels;
+        }
+
+        GLuint texture = 0;
+        glGenTextures(1, &texture);
+        BindTexture(GL_TEXTURE_2D, texture);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        GLenum format = image.channels == 4 ? GL_RGBA : GL_RGB;
+        glTexImage2D(GL_TEXTURE_2D, 0, format, image.width, image.height, 0, format, GL_UNSIGNED_BYTE, source);
+        glGenerateMipmap(GL_TEXTURE_2D);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        BindTexture(GL_TEXTURE_2D, 0);
+        BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+        Sprite &sprite = *target.sprite;
+        if (target.slot == ASSET_IMAGE) {
+            sprite.textureName = texture;
+            sprite.ownsTexture = true;
+            sprite.nTexChannels = image.channels;
+            sprite.imgWidth = image.width;
+            sprite.imgHeight = image.height;
+        } else if (target.slot == ASSET_FRAME) {
+            sprite.textureNames[target.frame] = texture;
+        } else {
+            sprite.matName = texture;
+        }
+    }
+
+public:
+    AssetLoader() {}
+
+    AssetLoader(const AssetLoader &) = delete;
+
+    AssetLoader &operator=(const AssetLoader &) = delete;
+
+    ~AssetLoader() {
+        Stop();
+        Release();
+    }
+
+    /**
+     * Load() Asynchronous Sprite::Initialize(imageFile), GL thread only
+     *
+     * @param sprite Sprite, must outlive the load
+     * @param imageFile String Image Path
+     * @param z Float Depth
+     */
+    void Load(Sprite &sprite, const string &imageFile, float z = 0) {
+        Start();
+        sprite.Initialize(placeholder, z, false);
+        sprite.nTexChannels = 4;
+        AssetTarget target;
+        target.sprite = &sprite;
+        target.path = imageFile;
+        Enqueue(target);
+    }
+
+    /**
+     * LoadFrames() Asynchronous Sprite::Initialize(imageFiles, matFile), every frame decodes in parallel
+     *
+     * @param sprite Sprite, must outlive the load
+     * @param imageFiles String Collection Frame Paths
+     * @param matFile String Matte Path, may be empty
+     * @param z Float Depth
+     */
+    void LoadFrames(Sprite &sprite, const vector<string> &imageFiles, const string &matFile = "", float z = 0) {
+        Start();
+        sprite.z = z;
+        sprite.nFrames = (GLuint) imageFiles.size();
+        sprite.textureNames.assign(imageFiles.size(), placeholder);
+        sprite.change = clock() + (time_t) (sprite.frameDuration * CLOCKS_PER_SEC);
+        for (int i = 0; i < (int) imageFiles.size(); i++) {
+            AssetTarget target;
+            target.sprite = &sprite;
+            target.slot = ASSET_FRAME;
+            target.frame = i;
+            target.path = imageFiles[i];
+            Enqueue(target);
+        }
+        if (!matFile.empty()) {
+            AssetTarget target;
+            target.sprite = &sprite;
+            target.slot = ASSET_MAT;
+            target.path = matFile;
+            Enqueue(target);
+        }
+    }
+
+    /**
+     * Pump() Upload Finished Decodes, called once per frame on the GL thread
+     *
+     * @param byteBudget Unsigned Pixel Bytes To Upload This Call, at least one image always goes
+     * @return Integer Images Uploaded
+     */
+    int Pump(size_t byteBudget = ASSET_UPLOAD_BUDGET) {
+        if (outstanding == 0) {
+            return 0;
+        }
+        vector<DecodedImage> ready;
+        {
+            lock_guard<mutex> lock(decodedLock);
+            size_t bytes = 0;
+            int count = 0;
+            while (count < (int) decoded.size() && (count == 0 || bytes < byteBudget)) {
+                const DecodedImage &image = decoded[count++];
+                bytes += (size_t) image.width * image.height * image.channels;
+            }
+            ready.assign(decoded.begin(), decoded.begin() + count);
+            decoded.erase(decoded.begin(), decoded.begin() + count);
+        }
+        for (const DecodedImage &image: ready) {
+            if (image.pixels != nullptr) {
+                Upload(image);
+                stbi_image_free(image.pixels);
+            }
+            outstanding--;
+        }
+        return (int) ready.size();
+    }
+
+    /**
+     * Idle() Every Requested Image Has Been Uploaded Or Has Failed
+     *
+     * @return Boolean Condition
+     */
+    bool Idle() const { return outstanding == 0; }
+
+    /**
+     * Stop() Join The Workers And Drop Anything Not Yet Uploaded
+     */
+    void Stop() {
+        {
+            lock_guard<mutex> lock(jobLock);
+            stopping = true;
+            jobs.clear();
+        }
+        jobReady.notify_all();
+        for (thread &worker: workers) {
+            worker.join();
+        }
+        workers.clear();
+        lock_guard<mutex> lock(decodedLock);
+        for (DecodedImage &image: decoded) {
+            stbi_image_free(image.pixels);
+        }
+        decoded.clear();
+        outstanding = 0;
+    }
+
+    /**
+     * Release() Delete The Placeholder And Unpack Buffers, GL thread only; sprites still waiting keep a dead name
+     */
+    void Release() {
+        if (placeholder != 0) {
+            DeleteTextures(1, &placeholder);
+            DeleteBuffers(ASSET_UNPACK_BUFFERS, unpackBuffers);
+            placeholder = 0;
+            for (GLuint &buffer: unpackBuffers) {
+                buffer = 0;
+            }
+        }
+    }
+};
+
+AssetLoader ASSETS;
+
+#endif //ROADREALM_ASSETLOADER_H
@@ -0,0 +1,273 @@
+/**
+ * @file AtlasBundle.h
+ * @author Team 8: Edwin Kaburu, Vincent Marklynn, Yong Long Tan
+ * @date 10/19/2026
+ */
+
+#ifndef ROADREALM_ATLASBUNDLE_H
+#define ROADREALM_ATLASBUNDLE_H
+
+#include <glad.h>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "AtlasFormat.h"
+#include "FrameProfiler.h"
+#include "GLState.h"
+#include "Sprite.h"
+#include "VecMat.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// Bundle Written By RoadRealmAtlasPacker At Build Time, into the build directory (CMake defines the full path)
+#ifndef UI_ATLAS_BUNDLE
+#define UI_ATLAS_BUNDLE "ui_atlas.bundle"
+#endif
+
+/**
+ * @class MappedFile
+ * @details Read-only memory mapping of a whole file, so bundle bytes go from the page cache straight to the driver
+ */
+class MappedFile {
+private:
+    const uint8_t *fileBytes = nullptr;
+    size_t fileSize = 0;
+#ifdef _WIN32
+    HANDLE fileHandle = INVALID_HANDLE_VALUE, mappingHandle = nullptr;
+#endif
+
+public:
+    MappedFile() {}
+
+    MappedFile(const MappedFile &) = delete;
+
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    ~MappedFile() { Close(); }
+
+    /**
+     * Open() Map A File Into Memory
+     *
+     * @param path Char Pointer File Path
+     * @return Boolean Condition
+     */
+    bool Open(const char *path) {
+        Close();
+#ifdef _WIN32
+        fileHandle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                 FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(fileHandle, &size) || size.QuadPart == 0) {
+            Close();
+            return false;
+        }
+        mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mappingHandle == nullptr) {
+            Close();
+            return false;
+        }
+        fileBytes = (const uint8_t *) MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+        fileSize = (size_t) size.QuadPart;
+#else
+        int fd = open(path, O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size > 0) {
+            void *bytes = mmap(nullptr, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (bytes != MAP_FAILED) {
+                fileBytes = (const uint8_t *) bytes;
+                fileSize = (size_t) info.st_size;
+            }
+        }
+        close(fd);
+#endif
+        if (fileBytes == nullptr) {
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    const uint8_t *Data() const { return fileBytes; }
+
+    size_t Size() const { return fileSize; }
+
+    /**
+     * Close() Unmap The File
+     */
+    void Close() {
+#ifdef _WIN32
+        if (fileBytes != nullptr) {
+            UnmapViewOfFile(fileBytes);
+        }
+        if (mappingHandle != nullptr) {
+            CloseHandle(mappingHandle);
+        }
+        if (fileHandle != INVALID_HANDLE_VALUE) {
+            CloseHandle(fileHandle);
+        }
+        mappingHandle = nullptr;
+        fileHandle = INVALID_HANDLE_VALUE;
+#else
+        if (fileBytes != nullptr) {
+            munmap((void *) fileBytes, fileSize);
+        }
+#endif
+        fileBytes = nullptr;
+        fileSize = 0;
+    }
+};
+
+/**
+ * @class AtlasBundle
+ * @details One GL texture holding every UI image with its pre-built mip chain, plus the region table sprites use to
+ * pick their part of it. Replaces a decode, upload and glGenerateMipmap per image with a single upload.
+ */
+class AtlasBundle {
+private:
+    GLuint textureName = 0;
+    vector<AtlasRegion> regions;
+
+public:
+    /**
+     * Load() Map A Bundle And Upload It
+     *
+     * @param path Char Pointer Bundle Path
+     * @return Boolean Condition, false leaves the bundle empty
+     */
+    bool Load(const char *path) {
+        PROFILE_ZONE("LoadAtlas");
+        MappedFile file;
+        if (!file.Open(path)) {
+            cout << "UI atlas bundle not found: " << path << endl;
+            return false;
+        }
+        const uint8_t *bytes = file.Data();
+        AtlasBundleHeader header;
+        if (file.Size() < sizeof(header)) {
+            cout << "UI atlas bundle is truncated: " << path << endl;
+            return false;
+        }
+        memcpy(&header, bytes, sizeof(header));
+        size_t tableEnd = sizeof(header) + (size_t) header.regionCount * sizeof(AtlasRegion) +
+                          (size_t) header.mipCount * sizeof(AtlasMipLevel);
+        if (header.magic != ATLAS_BUNDLE_MAGIC || header.version != ATLAS_BUNDLE_VERSION || header.mipCount == 0 ||
+            header.pixelOffset < tableEnd || (size_t) header.pixelOffset + header.pixelBytes > file.Size()) {
+            cout << "Not a usable UI atlas bundle: " << path << endl;
+            return false;
+        }
+
+        regions.resize(header.regionCount);
+        memcpy(regions.data(), bytes + sizeof(header), regions.size() * sizeof(AtlasRegion));
+        vector<AtlasMipLevel> mips(header.mipCount);
+        memcpy(mips.data(), bytes + sizeof(header) + regions.size() * sizeof(AtlasRegion),
+               mips.size() * sizeof(AtlasMipLevel));
+        for (const AtlasMipLevel &mip: mips) {
+            if ((size_t) mip.offset + (size_t) mip.width * mip.height * 4 > header.pixelBytes) {
+                cout << "UI atlas bundle mip table is corrupt: " << path << endl;
+                regions.clear();
+                return false;
+            }
+        }
+
+        // Whole Pixel Blob Goes To The Driver In One Copy, every mip level is then sourced from that buffer
+        GLuint unpackBuffer = 0;
+        glGenBuffers(1, &unpackBuffer);
+        BindBuffer(GL_PIXEL_UNPACK_BUFFER, unpackBuffer);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, header.pixelBytes, bytes + header.pixelOffset, GL_STATIC_DRAW);
+
+        glGenTextures(1, &textureName);
+        BindTexture(GL_TEXTURE_2D, textureName);
+        glTexStorage2D(GL_TEXTURE_2D, (GLsizei) mips.size(), GL_RGBA8, (GLsizei) header.width,
+                       (GLsizei) header.height);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        for (int level = 0; level < (int) mips.size(); level++) {
+            glTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, (GLsizei) mips[level].width, (GLsizei) mips[level].height,
+                            GL_RGBA, GL_UNSIGNED_BYTE, (const void *) (uintptr_t) mips[level].offset);
+        }
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint) mips.size() - 1);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        BindTexture(GL_TEXTURE_2D, 0);
+
+        // Driver Keeps The Storage Alive Until The Transfers Finish
+        BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        DeleteBuffers(1, &unpackBuffer);
+        return true;
+    }
+
+    bool IsLoaded() const { return textureName != 0; }
+
+    /**
+     * Release() Delete The Atlas Texture, which the sprites pointed at it only borrow
+     */
+    void Release() {
+        if (textureName != 0) {
+            DeleteTextures(1, &textureName);
+            textureName = 0;
+        }
+        regions.clear();
+    }
+
+    ~AtlasBundle() { Release(); }
+
+    /**
+     * Find() Look Up A Region By Name
+     *
+     * @param name String Region Name, the source image name without extension
+     * @return AtlasRegion Pointer, nullptr if absent
+     */
+    const AtlasRegion *Find(const string &name) const {
+        for (const AtlasRegion &region: regions) {
+            if (name == region.name) {
+                return &region;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Apply() Point A Sprite At One Region Of The Atlas
+     *
+     * @param sprite Sprite
+     * @param name String Region Name
+     * @return Boolean Condition, false if the region is missing
+     */
+    bool Apply(Sprite &sprite, const string &name) const {
+        const AtlasRegion *region = Find(name);
+        if (!IsLoaded() || region == nullptr) {
+            return false;
+        }
+        sprite.Initialize(textureName, sprite.z, false);
+        sprite.nTexChannels = 4;
+        sprite.imgWidth = (int) region->width;
+        sprite.imgHeight = (int) region->height;
+        sprite.SetUvTransform(Translate(region->u0, region->v0, 0) *
+                              Scale(region->u1 - region->u0, region->v1 - region->v0, 1));
+        return true;
+    }
+};
+
+AtlasBundle UI_ATLAS;
+
+#endif //ROADREALM_ATLASBUNDLE_H
@@ -0,0 +1,56 @@
+/**
+ * @file AtlasFormat.h
+ * @author Team 8: Edwin Kaburu, Vincent Marklynn, Yong Long Tan
+ * @date 10/19/2026
+ */
+
+#ifndef ROADREALM_ATLASFORMAT_H
+#define ROADREALM_ATLASFORMAT_H
+
+#include <cstdint>
+
+/**
+ * Layout Of A UI Atlas Bundle, shared by the offline packer and the game. A bundle is one little-endian file:
+ * AtlasBundleHeader, regionCount AtlasRegion entries, mipCount AtlasMipLevel entries, then the RGBA8 pixels of every
+ * mip level back to back starting at pixelOffset. Rows run bottom to top, matching stbi's flipped loads.
+ */
+
+// 'RRAB' Read As A Little-Endian Integer
+#define ATLAS_BUNDLE_MAGIC 0x42415252u
+#define ATLAS_BUNDLE_VERSION 1
+#define ATLAS_REGION_NAME_SIZE 32
+// Pixel Data Alignment Inside The Bundle
+#define ATLAS_PIXEL_ALIGNMENT 16
+
+/**
+ * @struct AtlasBundleHeader
+ * @details Leading Block Of A Bundle
+ */
+struct AtlasBundleHeader {
+    uint32_t magic = ATLAS_BUNDLE_MAGIC;
+    uint32_t version = ATLAS_BUNDLE_VERSION;
+    uint32_t width = 0, height = 0;
+    uint32_t mipCount = 0, regionCount = 0;
+    uint32_t pixelOffset = 0, pixelBytes = 0;
+};
+
+/**
+ * @struct AtlasRegion
+ * @details Named Image Inside The Atlas, in normalized texture coordinates
+ */
+struct AtlasRegion {
+    char name[ATLAS_REGION_NAME_SIZE] = {};
+    float u0 = 0, v0 = 0, u1 = 0, v1 = 0;
+    uint32_t width = 0, height = 0;
+};
+
+/**
+ * @struct AtlasMipLevel
+ * @details Where One Mip Level's Pixels Start, relative to pixelOffset
+ */
+struct AtlasMipLevel {
+    uint32_t offset = 0;
+    uint32_t width = 0, height = 0;
+};
+
+#endif //ROADREALM_ATLASFORMAT_H
@@ -0,0 +1,569 @@
+/**
+ * @file AudioMixer.h
+ * @author Team 8: Edwin Kaburu, Vincent Marklynn, Yong Long Tan
+ * @date 10/19/2026
+ */
+
+#ifndef ROADREALM_AUDIOMIXER_H
+#define ROADREALM_AUDIOMIXER_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "SpscQueue.h"
+
+#ifdef _WIN32
+// Keep std::min/std::max usable after windows.h
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <mmsystem.h>
+#endif
+
+#ifdef ROADREALM_AUDIO_ALSA
+#include <alsa/asoundlib.h>
+#endif
+
+using namespace std;
+
+// Output Format Every Sample Is Converted To At Load Time
+#define AUDIO_SAMPLE_RATE 44100
+#define AUDIO_CHANNELS 2
+// Frames Mixed Per Block, ~11.6 ms at 44.1 kHz
+#define AUDIO_BLOCK_FRAMES 512
+// Blocks Queued On The Device Ahead Of Playback
+#define AUDIO_DEVICE_BLOCKS 3
+// Sounds Allowed To Overlap, the oldest voice is replaced past this
+#define AUDIO_MAX_VOICES 16
+#define AUDIO_COMMAND_CAPACITY 64
+
+enum SoundId {
+    SOUND_CLICK = 0,
+    SOUND_CHIME,
+    SOUND_ERROR,
+    SOUND_GAME_OVER,
+    SOUND_CALL_TO_ARMS,
+    SOUND_PROGRAM_START,
+    SOUND_COUNT
+};
+
+/**
+ * SoundPath() File Decoded Into A Sound At Startup
+ *
+ * @param sound SoundId
+ * @return Char Pointer File Path
+ */
+const char *SoundPath(SoundId sound) {
+    static const char *paths[SOUND_COUNT] = {"RoadNet/Sounds/click_x.wav", "RoadNet/Sounds/chime.wav",
+                                             "RoadNet/Sounds/error.wav", "RoadNet/Sounds/game_over.wav",
+                                             "RoadNet/Sounds/call_to_arms.wav", "RoadNet/Sounds/program_start.wav"};
+    return paths[sound];
+}
+
+/**
+ * ReadLE() Read A Little-Endian Integer From A Byte Buffer
+ *
+ * @param bytes Byte Pointer
+ * @param count Integer Byte Count, 2 or 4
+ * @return Unsigned Value
+ */
+uint32_t ReadLE(const uint8_t *bytes, int count) {
+    uint32_t value = 0;
+    for (int i = count - 1; i >= 0; i--) {
+        value = (value << 8) | bytes[i];
+    }
+    return value;
+}
+
+/**
+ * DecodeWav() Decode A PCM WAV File Into Interleaved 16-Bit Stereo At AUDIO_SAMPLE_RATE
+ *
+ * @param path Char Pointer File Path
+ * @param frames Int16 Collection Output, two values per frame
+ * @return Boolean Condition, false if the file is missing or not 8/16-bit PCM
+ */
+bool DecodeWav(const char *path, vector<int16_t> &frames) {
+    FILE *file = fopen(path, "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    vector<uint8_t> bytes;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (size > 12) {
+        bytes.resize(size);
+        bytes.resize(fread(bytes.data(), 1, size, file));
+    }
+    fclose(file);
+    if (bytes.size() < 12 || memcmp(bytes.data(), "RIFF", 4) != 0 || memcmp(bytes.data() + 8, "WAVE", 4) != 0) {
+        return false;
+    }
+
+    // Walk The Chunks For The Format And The Samples, skipping LIST and anything else
+    int channels = 0, sampleRate = 0, bitsPerSample = 0;
+    const uint8_t *data = nullptr;
+    size_t dataSize = 0;
+    for (size_t offset = 12; offset + 8 <= bytes.size();) {
+        const uint8_t *chunk = bytes.data() + offset;
+        size_t chunkSize = min<size_t>(ReadLE(chunk + 4, 4), bytes.size() - offset - 8);
+        if (memcmp(chunk, "fmt ", 4) == 0 && chunkSize >= 16) {
+            if (ReadLE(chunk + 8, 2) != 1) {
+                return false;
+            }
+            channels = (int) ReadLE(chunk + 10, 2);
+            sampleRate = (int) ReadLE(chunk + 12, 4);
+            bitsPerSample = (int) ReadLE(chunk + 22, 2);
+        } else if (memcmp(chunk, "data", 4) == 0) {
+            data = chunk + 8;
+            dataSize = chunkSize;
+        }
+        offset += 8 + chunkSize + (chunkSize & 1);
+    }
+    if (data == nullptr || channels < 1 || channels > 2 || sampleRate <= 0 ||
+        (bitsPerSample != 8 && bitsPerSample != 16)) {
+        return false;
+    }
+
+    // Source Frames As 16-Bit Stereo
+    int bytesPerSample = bitsPerSample / 8;
+    size_t sourceCount = dataSize / (bytesPerSample * channels);
+    auto sourceSample = [&](size_t frame, int channel) -> int16_t {
+        const uint8_t *sample = data + (frame * channels + min(channel, channels - 1)) * bytesPerSample;
+        return bitsPerSample == 8 ? (int16_t) ((sample[0] - 128) << 8) : (int16_t) ReadLE(sample, 2);
+    };
+
+    // Linear Resampling To The Mixer Rate, done once so mixing is a plain add
+    size_t outCount = (size_t) ((double) sourceCount * AUDIO_SAMPLE_RATE / sampleRate);
+    frames.assign(outCount * AUDIO_CHANNELS, 0);
+    double step = (double) sampleRate / AUDIO_SAMPLE_RATE;
+    for (size_t i = 0; i < outCount; i++) {
+        double position = i * step;
+        size_t index = (size_t) position;
+        size_t nextIndex = min(index + 1, sourceCount - 1);
+        float blend = (float) (position - index);
+        for (int channel = 0; channel < AUDIO_CHANNELS; channel++) {
+            float a = sourceSample(index, channel), b = sourceSample(nextIndex, channel);
+            frames[i * AUDIO_CHANNELS + channel] = (int16_t) (a + (b - a) * blend);
+        }
+    }
+    return true;
+}
+
+/**
+ * @class AudioBackend
+ * @details Output Device Fed With Mixed 16-Bit Stereo Blocks. Write() blocks until the device can take the block,
+ * which is what paces the mixer thread.
+ */
+class AudioBackend {
+public:
+    virtual ~AudioBackend() {}
+
+    virtual bool Open() = 0;
+
+    virtual void Write(const int16_t *frames, int frameCount) = 0;
+
+    virtual void Close() = 0;
+};
+
+/**
+ * @class NullAudioBackend
+ * @details Discards audio in real time, used headless or when no device opens
+ */
+class NullAudioBackend : public AudioBackend {
+private:
+    chrono::steady_clock::time_point nextBlock;
+
+public:
+    bool Open() override {
+        nextBlock = chrono::steady_clock::now();
+        return true;
+    }
+
+    void Write(const int16_t * /*frames*/, int frameCount) override {
+        nextBlock += chrono::microseconds((long long) frameCount * 1000000 / AUDIO_SAMPLE_RATE);
+        this_thread::sleep_until(nextBlock);
+    }
+
+    void Close() override {}
+};
+
+/**
+ * @class WavFileAudioBackend
+ * @details Writes the mixed output to a WAV file in real time, so headless runs can be listened to or diffed
+ */
+class WavFileAudioBackend : public NullAudioBackend {
+private:
+    string filePath;
+    FILE *outFile = nullptr;
+    uint32_t dataBytes = 0;
+
+    /**
+     * WriteHeader() Write The RIFF Header For The Bytes Written So Far
+     */
+    void WriteHeader() {
+        uint8_t header[44];
+        auto put = [&](int offset, uint32_t value, int count) {
+            for (int i = 0; i < count; i++) {
+                header[offset + i] = (uint8_t) (value >> (8 * i));
+            }
+        };
+        memcpy(header, "RIFF", 4);
+        put(4, 36 + dataBytes, 4);
+        memcpy(header + 8, "WAVEfmt ", 8);
+        put(16, 16, 4);
+        put(20, 1, 2);
+        put(22, AUDIO_CHANNELS, 2);
+        put(24, AUDIO_SAMPLE_RATE, 4);
+        put(28, AUDIO_SAMPLE_RATE * AUDIO_CHANNELS * 2, 4);
+        put(32, AUDIO_CHANNELS * 2, 2);
+        put(34, 16, 2);
+        memcpy(header + 36, "data", 4);
+        put(40, dataBytes, 4);
+        fseek(outFile, 0, SEEK_SET);
+        fwrite(header, 1, sizeof(header), outFile);
+        fseek(outFile, 0, SEEK_END);
+    }
+
+public:
+    explicit WavFileAudioBackend(const string &path) : filePath(path) {}
+
+    bool Open() override {
+        outFile = fopen(filePath.c_str(), "wb");
+        if (outFile == nullptr) {
+            return false;
+        }
+        dataBytes = 0;
+        WriteHeader();
+        return NullAudioBackend::Open();
+    }
+
+    void Write(const int16_t *frames, int frameCount) override {
+        size_t bytes = (size_t) frameCount * AUDIO_CHANNELS * sizeof(int16_t);
+        fwrite(frames, 1, bytes, outFile);
+        dataBytes += (uint32_t) bytes;
+        NullAudioBackend::Write(frames, frameCount);
+    }
+
+    void Close() override {
+        if (outFile != nullptr) {
+            WriteHeader();
+            fclose(outFile);
+            outFile = nullptr;
+        }
+    }
+};
+
+#ifdef _WIN32
+
+/**
+ * @class WaveOutAudioBackend
+ * @details Windows Output Through waveOut, with a small ring of device buffers signalled by an event
+ */
+class WaveOutAudioBackend : public AudioBackend {
+private:
+    HWAVEOUT device = nullptr;
+    HANDLE doneEvent = nullptr;
+    WAVEHDR headers[AUDIO_DEVICE_BLOCKS] = {};
+    int16_t buffers[AUDIO_DEVICE_BLOCKS][AUDIO_BLOCK_FRAMES * AUDIO_CHANNELS] = {};
+    int nextBuffer = 0;
+
+public:
+    bool Open() override {
+        WAVEFORMATEX format = {};
+        format.wFormatTag = WAVE_FORMAT_PCM;
+        format.nChannels = AUDIO_CHANNELS;
+        format.nSamplesPerSec = AUDIO_SAMPLE_RATE;
+        format.wBitsPerSample = 16;
+        format.nBlockAlign = AUDIO_CHANNELS * 2;
+        format.nAvgBytesPerSec = AUDIO_SAMPLE_RATE * format.nBlockAlign;
+        doneEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+        if (waveOutOpen(&device, WAVE_MAPPER, &format, (DWORD_PTR) doneEvent, 0, CALLBACK_EVENT) !=
+            MMSYSERR_NOERROR) {
+            CloseHandle(doneEvent);
+            doneEvent = nullptr;
+            device = nullptr;
+            return false;
+        }
+        for (int i = 0; i < AUDIO_DEVICE_BLOCKS; i++) {
+            headers[i].lpData = (LPSTR) buffers[i];
+            headers[i].dwBufferLength = sizeof(buffers[i]);
+            waveOutPrepareHeader(device, &headers[i], sizeof(WAVEHDR));
+            // Every Buffer Starts Out Free
+            headers[i].dwFlags |= WHDR_DONE;
+        }
+        return true;
+    }
+
+    void Write(const int16_t *frames, int frameCount) override {
+        WAVEHDR &header = headers[nextBuffer];
+        while (!(header.dwFlags & WHDR_DONE)) {
+            WaitForSingleObject(doneEvent, 100);
+        }
+        memcpy(buffers[nextBuffer], frames, sizeof(buffers[nextBuffer]));
+        header.dwFlags &= ~WHDR_DONE;
+        waveOutWrite(device, &header, sizeof(WAVEHDR));
+        nextBuffer = (nextBuffer + 1) % AUDIO_DEVICE_BLOCKS;
+    }
+
+    void Close() override {
+        if (device != nullptr) {
+            waveOutReset(device);
+            for (WAVEHDR &header: headers) {
+                waveOutUnprepareHeader(device, &header, sizeof(WAVEHDR));
+            }
+            waveOutClose(device);
+            CloseHandle(doneEvent);
+            device = nullptr;
+            doneEvent = nullptr;
+        }
+    }
+};
+
+#endif //_WIN32
+
+#ifdef ROADREALM_AUDIO_ALSA
+
+/**
+ * @class AlsaAudioBackend
+ * @details Linux Output Through ALSA's default device, which is routed to PulseAudio or PipeWire where present
+ */
+class AlsaAudioBackend : public AudioBackend {
+private:
+    snd_pcm_t *device = nullptr;
+
+public:
+    bool Open() override {
+        if (snd_pcm_open(&device, "default", SND_PCM_STREAM_PLAYBACK, 0) < 0) {
+            device = nullptr;
+            return false;
+        }
+        unsigned int latencyUs = AUDIO_DEVICE_BLOCKS * AUDIO_BLOCK_FRAMES * 1000000u / AUDIO_SAMPLE_RATE;
+        if (snd_pcm_set_params(device, SND_PCM_FORMAT_S16_LE, SND_PCM_ACCESS_RW_INTERLEAVED, AUDIO_CHANNELS,
+                               AUDIO_SAMPLE_RATE, 1, latencyUs) < 0) {
+            snd_pcm_close(device);
+            device = nullptr;
+            return false;
+        }
+        return true;
+    }
+
+    void Write(const int16_t *frames, int frameCount) override {
+        while (frameCount > 0) {
+            snd_pcm_sframes_t written = snd_pcm_writei(device, frames, frameCount);
+            if (written < 0) {
+                // Recover From Underruns And Suspends, give up on the block otherwise
+                if (snd_pcm_recover(device, (int) written, 1) < 0) {
+                    return;
+                }
+                continue;
+            }
+            frames += written * AUDIO_CHANNELS;
+            frameCount -= (int) written;
+        }
+    }
+
+    void Close() override {
+        if (device != nullptr) {
+            snd_pcm_drain(device);
+            snd_pcm_close(device);
+            device = nullptr;
+        }
+    }
+};
+
+#endif //ROADREALM_AUDIO_ALSA
+
+/**
+ * @struct AudioCommand
+ * @details Request To Start A Sound, sent from the game thread to the mixer thread
+ */
+struct AudioCommand {
+    SoundId sound = SOUND_CLICK;
+    float gain = 1.0f;
+};
+
+/**
+ * @class AudioMixer
+ * @details Decodes every sound once at startup and mixes overlapping voices on its own thread. Play() only pushes a
+ * command into a lock-free queue, so the game never touches files or the device while handling input.
+ */
+class AudioMixer {
+private:
+    /**
+     * @struct Voice
+     * @details A Sound Currently Playing
+     */
+    struct Voice {
+        int sound = -1;
+        size_t position = 0;
+        float gain = 1.0f;
+        uint32_t startOrder = 0;
+    };
+
+    vector<int16_t> samples[SOUND_COUNT];
+    Voice voices[AUDIO_MAX_VOICES];
+    uint32_t voicesStarted = 0;
+    SpscQueue<AudioCommand, AUDIO_COMMAND_CAPACITY> commands;
+    unique_ptr<AudioBackend> backend;
+    thread mixerThread;
+    atomic<bool> running = false;
+
+    /**
+     * CreateBackend() Pick The Output, ROADREALM_AUDIO may be "null" or "wav:<file>" to override the device
+     *
+     * @return AudioBackend Pointer
+     */
+    static unique_ptr<AudioBackend> CreateBackend() {
+        const char *choice = getenv("ROADREALM_AUDIO");
+        string selected = choice != nullptr ? choice : "";
+        if (selected == "null") {
+            return make_unique<NullAudioBackend>();
+        }
+        if (selected.rfind("wav:", 0) == 0) {
+            return make_unique<WavFileAudioBackend>(selected.substr(4));
+        }
+#if defined(_WIN32)
+        return make_unique<WaveOutAudioBackend>();
+#elif defined(ROADREALM_AUDIO_ALSA)
+        return make_unique<AlsaAudioBackend>();
+#else
+        return make_unique<NullAudioBackend>();
+#endif
+    }
+
+    /**
+     * StartVoice() Start A Sound, replacing the oldest voice when all are busy
+     *
+     * @param command AudioCommand
+     */
+    void StartVoice(const AudioCommand &command) {
+        if (samples[command.sound].empty()) {
+            return;
+        }
+        Voice *target = &voices[0];
+        for (Voice &voice: voices) {
+            if (voice.sound < 0) {
+                target = &voice;
+                break;
+            }
+            if (voice.startOrder < target->startOrder) {
+                target = &voice;
+            }
+        }
+        target->sound = command.sound;
+        target->position = 0;
+        target->gain = command.gain;
+        target->startOrder = voicesStarted++;
+    }
+
+    /**
+     * MixBlock() Sum Every Active Voice Into One Output Block
+     *
+     * @param out Int16 Pointer, AUDIO_BLOCK_FRAMES frames
+     */
+    void MixBlock(int16_t *out) {
+        int32_t accumulator[AUDIO_BLOCK_FRAMES * AUDIO_CHANNELS] = {};
+        for (Voice &voice: voices) {
+            if (voice.sound < 0) {
+                continue;
+            }
+            const vector<int16_t> &sample = samples[voice.sound];
+            size_t count = min<size_t>(AUDIO_BLOCK_FRAMES * AUDIO_CHANNELS, sample.size() - voice.position);
+            for (size_t i = 0; i < count; i++) {
+                accumulator[i] += (int32_t) ((float) sample[voice.position + i] * voice.gain);
+            }
+            voice.position += count;
+            if (voice.position >= sample.size()) {
+                voice.sound = -1;
+            }
+        }
+        for (int i = 0; i < AUDIO_BLOCK_FRAMES * AUDIO_CHANNELS; i++) {
+            out[i] = (int16_t) clamp<int32_t>(accumulator[i], INT16_MIN, INT16_MAX);
+        }
+    }
+
+    /**
+     * MixerLoop() Mixer Thread Body, paced by the backend's blocking writes
+     */
+    void MixerLoop() {
+        int16_t block[AUDIO_BLOCK_FRAMES * AUDIO_CHANNELS];
+        while (running.load(memory_order_relaxed)) {
+            AudioCommand command;
+            while (commands.Pop(command)) {
+                StartVoice(command);
+            }
+            MixBlock(block);
+            backend->Write(block, AUDIO_BLOCK_FRAMES);
+        }
+    }
+
+public:
+    AudioMixer() {}
+
+    AudioMixer(const AudioMixer &) = delete;
+
+    AudioMixer &operator=(const AudioMixer &) = delete;
+
+    ~AudioMixer() { Stop(); }
+
+    /**
+     * Start() Decode Every Sound And Start The Mixer Thread
+     *
+     * @return Boolean Condition, false if the null backend had to be used
+     */
+    bool Start() {
+        for (int sound = 0; sound < SOUND_COUNT; sound++) {
+            if (!DecodeWav(SoundPath((SoundId) sound), samples[sound])) {
+                cout << "Sound could not be decoded: " << SoundPath((SoundId) sound) << endl;
+            }
+        }
+        backend = CreateBackend();
+        bool opened = backend->Open();
+        if (!opened) {
+            cout << "Audio device could not be opened, sound is muted" << endl;
+            backend = make_unique<NullAudioBackend>();
+            backend->Open();
+        }
+        running = true;
+        mixerThread = thread(&AudioMixer::MixerLoop, this);
+        return opened;
+    }
+
+    /**
+     * Play() Queue A Sound, safe to call from one game thread at a time
+     *
+     * @param sound SoundId
+     * @param gain Float Volume, 1 for the file's own level
+     */
+    void Play(SoundId sound, float gain = 1.0f) {
+        AudioCommand command;
+        command.sound = sound;
+        command.gain = gain;
+        commands.Push(command);
+    }
+
+    /**
+     * Stop() Stop The Mixer Thread And Close The Output
+     */
+    void Stop() {
+        if (running.exchange(false)) {
+            mixerThread.join();
+            backend->Close();
+        }
+    }
+};
+
+AudioMixer AUDIO;
+
+#endif //ROADREALM_AUDIOMIXER_H
@@ -0,0 +1,53 @@
+/**
+ * @file FrameArena.h
+ * @author Team 8: Edwin Kaburu, Vincent Marklynn, Yong Long Tan
+ * @date 10/19/2026
+ */
+
+#ifndef ROADREALM_FRAMEARENA_H
+#define ROADREALM_FRAMEARENA_H
+
+#include <cstddef>
+#include <memory_resource>
+
+using namespace std;
+
+// Static Bytes Reserved For One Frame, the arena only falls back to the heap past this budget
+#define FRAME_ARENA_BYTES (128 * 1024)
+
+/**
+ * @class FrameArena
+ * @details Scratch memory for containers and strings that live no longer than one frame. Allocation is a pointer
+ * bump, frees are ignored, and the whole arena is rewound at the start of every frame.
+ */
+class FrameArena {
+private:
+    alignas(max_align_t) std::byte arenaBuffer[FRAME_ARENA_BYTES];
+    pmr::monotonic_buffer_resource arenaMonotonic;
+
+public:
+    /**
+     * FrameArena() Default Constructor For A Frame Arena
+     */
+    FrameArena() : arenaMonotonic(arenaBuffer, sizeof(arenaBuffer), pmr::new_delete_resource()) {}
+
+    FrameArena(const FrameArena &) = delete;
+
+    FrameArena &operator=(const FrameArena &) = delete;
+
+    /**
+     * Resource() Memory Resource For Frame-Scoped Containers
+     *
+     * @return Memory Resource Pointer
+     */
+    pmr::memory_resource *Resource() { return &arenaMonotonic; }
+
+    /**
+     * Reset() Rewind The Arena, nothing allocated during the previous frame may be used afterwards
+     */
+    void Reset() { arenaMonotonic.release(); }
+};
+
+FrameArena FRAME_ARENA;
+
+#endif //ROADREALM_FRAMEARENA_H
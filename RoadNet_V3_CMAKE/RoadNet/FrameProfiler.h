@@ -0,0 +1,502 @@
+/**
+ * @file FrameProfiler.h
+ * @author Team 8: Edwin Kaburu, Vincent Marklynn, Yong Long Tan
+ * @date 10/19/2026
+ */
+
+#ifndef ROADREALM_FRAMEPROFILER_H
+#define ROADREALM_FRAMEPROFILER_H
+
+/**
+ * Hierarchical Frame Profiler, enabled with the ROADREALM_FRAME_PROFILER build option. PROFILE_ZONE times the rest of
+ * its scope into a ring on the calling thread; nested zones become children in the exported Chrome trace
+ * (chrome://tracing or ui.perfetto.dev), and each zone's self time, its time less its children's, feeds the overlay.
+ * Without the option every macro expands to nothing.
+ */
+
+#ifdef ROADREALM_FRAME_PROFILER
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+using namespace std;
+
+// Threads With Their Own Ring, zones on any thread past this are not recorded
+#define PROFILE_MAX_THREADS 8
+// Rings Worker Pool Threads May Claim Between Them, the rest stay free for render, simulation and writer threads
+#define PROFILE_WORKER_RINGS 4
+// Zones Per Ring, a power of two; at 60 frames and a few hundred zones a frame this keeps well over the trace window
+#define PROFILE_RING_EVENTS (1 << 15)
+// Distinct Zone Names
+#define PROFILE_MAX_ZONES 64
+// Seconds Of History Written To A Trace
+#define PROFILE_TRACE_SECONDS 5
+// Render Frame Longer Than This Writes A Trace On Its Own
+#define PROFILE_SLOW_FRAME_MS 50.0
+// Seconds Between Slow Frame Traces, so one long stall does not write a trace per frame
+#define PROFILE_SLOW_FRAME_COOLDOWN 10.0
+// Frames Ignored At Startup, while assets upload and shaders compile
+#define PROFILE_WARMUP_FRAMES 60
+// Zones Listed On The Overlay
+#define PROFILE_OVERLAY_ZONES 6
+
+#define PROFILE_TRACE_FILE "RoadNet/Storage/frame_trace.json"
+#define PROFILE_SLOW_TRACE_FILE "RoadNet/Storage/frame_trace_slow.json"
+
+/**
+ * @struct ProfileEvent
+ * @details One Timed Zone, nanoseconds from the profiler's start
+ */
+struct ProfileEvent {
+    uint64_t startNs = 0, endNs = 0;
+    uint32_t zone = 0;
+};
+
+/**
+ * @struct ProfileThread
+ * @details Event Ring Of One Thread. Only its thread writes; written counts every event ever recorded, so a reader
+ * knows which slots still hold the events it wants.
+ */
+struct ProfileThread {
+    atomic<const char *> name = nullptr;
+    atomic<uint64_t> written = 0;
+    ProfileEvent events[PROFILE_RING_EVENTS];
+};
+
+/**
+ * @struct ProfileZoneStat
+ * @details Zone Totals Over The Last Overlay Period
+ */
+struct ProfileZoneStat {
+    const char *name = "";
+    double selfMsPerSecond = 0;
+    double maxMs = 0;
+    uint32_t calls = 0;
+};
+
+/**
+ * @struct ProfileSummary
+ * @details What The Overlay Shows, rebuilt about once a second
+ */
+struct ProfileSummary {
+    double frameMeanMs = 0, frameMaxMs = 0;
+    int slowFrames = 0;
+    int zoneCount = 0;
+    ProfileZoneStat zones[PROFILE_OVERLAY_ZONES];
+};
+
+/**
+ * @class FrameProfiler
+ * @details Zone registry, per-thread event rings and per-zone totals. Recording takes no lock and never allocates;
+ * the registry locks only the first time each zone is seen, and a thread claims its ring with its first zone.
+ */
+class FrameProfiler {
+private:
+    using ProfileClock = chrono::steady_clock;
+
+    /**
+     * @class SlowTraceWriter
+     * @details Background Thread Writing Slow Frame Traces, so the frame that was slow does not also wait on the disk
+     */
+    class SlowTraceWriter {
+    private:
+        thread writer;
+        mutex writerLock;
+        condition_variable writerWake;
+        // Length Of The Slow Frame Waiting For Its Trace, 0 when none is
+        double pendingFrameMs = 0;
+        bool stopping = false;
+
+        /**
+         * WriterLoop() Write A Trace Per Request Until Stopped
+         */
+        void WriterLoop() {
+            unique_lock<mutex> lock(writerLock);
+            while (true) {
+                writerWake.wait(lock, [this] { return stopping || pendingFrameMs > 0; });
+                if (stopping) {
+                    return;
+                }
+                double frameMs = pendingFrameMs;
+                pendingFrameMs = 0;
+                lock.unlock();
+                if (ExportChromeTrace(PROFILE_SLOW_TRACE_FILE)) {
+                    printf("%.1f ms frame, trace written to %s\n", frameMs, PROFILE_SLOW_TRACE_FILE);
+                }
+                lock.lock();
+            }
+        }
+
+    public:
+        SlowTraceWriter() {}
+
+        SlowTraceWriter(const SlowTraceWriter &) = delete;
+
+        SlowTraceWriter &operator=(const SlowTraceWriter &) = delete;
+
+        ~SlowTraceWriter() {
+            {
+                lock_guard<mutex> lock(writerLock);
+                stopping = true;
+            }
+            writerWake.notify_one();
+            if (writer.joinable()) {
+                writer.join();
+            }
+        }
+
+        /**
+         * Request() Ask For A Trace Of A Slow Frame, the writer starts with the first request
+         *
+         * @param frameMs Double Frame Length
+         */
+        void Request(double frameMs) {
+            lock_guard<mutex> lock(writerLock);
+            if (!writer.joinable()) {
+                writer = thread(&SlowTraceWriter::WriterLoop, this);
+            }
+            pendingFrameMs = frameMs;
+            writerWake.notify_one();
+        }
+    };
+
+    inline static const ProfileClock::time_point origin = ProfileClock::now();
+
+    inline static mutex registryLock;
+    inline static const char *zoneNames[PROFILE_MAX_ZONES] = {"Frame"};
+    inline static int zoneCount = 1;
+    inline static ProfileThread threads[PROFILE_MAX_THREADS];
+    inline static atomic<int> threadCount = 0, workerCount = 0;
+    inline static thread_local ProfileThread *currentThread = nullptr;
+    inline static thread_local const char *threadName = nullptr;
+    inline static thread_local bool threadWorker = false, threadFull = false;
+
+    // Totals Since The Overlay Was Last Rebuilt, from every thread
+    inline static atomic<uint64_t> zoneSelfNs[PROFILE_MAX_ZONES] = {};
+    inline static atomic<uint64_t> zoneMaxNs[PROFILE_MAX_ZONES] = {};
+    inline static atomic<uint32_t> zoneCalls[PROFILE_MAX_ZONES] = {};
+
+    // Render Thread Only
+    inline static uint64_t lastFrameNs = 0, periodStartNs = 0, lastSlowTraceNs = 0;
+    inline static double periodFrameMs = 0, periodFrameMaxMs = 0;
+    inline static int periodFrames = 0, periodSlowFrames = 0, framesRecorded = 0;
+    inline static ProfileSummary summary;
+
+    inline static mutex exportLock;
+    // Declared Last, so its thread is joined before the state it exports is torn down
+    inline static SlowTraceWriter slowTraceWriter;
+
+    /**
+     * Thread() Ring Of The Calling Thread, claimed with its first zone so idle threads hold none
+     *
+     * @return ProfileThread Pointer, null once every ring is taken, or every ring workers may take
+     */
+    static ProfileThread *Thread() {
+        if (currentThread == nullptr && !threadFull) {
+            bool claim = !threadWorker || workerCount.fetch_add(1, memory_order_relaxed) < PROFILE_WORKER_RINGS;
+            int index = claim ? threadCount.fetch_add(1, memory_order_relaxed) : PROFILE_MAX_THREADS;
+            if (index < PROFILE_MAX_THREADS) {
+                currentThread = &threads[index];
+                currentThread->name = threadName;
+            } else {
+                threadFull = true;
+            }
+        }
+        return currentThread;
+    }
+
+    /**
+     * WriteJsonString() Write Text As A Quoted JSON String, escaping quotes, backslashes and control characters
+     *
+     * @param file File Pointer
+     * @param text Char Pointer Text
+     */
+    static void WriteJsonString(FILE *file, const char *text) {
+        fputc('"', file);
+        for (const char *c = text; *c != '\0'; c++) {
+            if (*c == '"' || *c == '\\') {
+                fputc('\\', file);
+                fputc(*c, file);
+            } else if ((unsigned char) *c < 0x20) {
+                fprintf(file, "\\u%04x", (unsigned char) *c);
+            } else {
+                fputc(*c, file);
+            }
+        }
+        fputc('"', file);
+    }
+
+    /**
+     * Accumulate() Add A Finished Zone To The Overlay Totals
+     *
+     * @param zone Integer Zone
+     * @param durationNs Unsigned Inclusive Time
+     * @param selfNs Unsigned Time Less Children
+     */
+    static void Accumulate(int zone, uint64_t durationNs, uint64_t selfNs) {
+        zoneSelfNs[zone].fetch_add(selfNs, memory_order_relaxed);
+        zoneCalls[zone].fetch_add(1, memory_order_relaxed);
+        uint64_t most = zoneMaxNs[zone].load(memory_order_relaxed);
+        while (durationNs > most && !zoneMaxNs[zone].compare_exchange_weak(most, durationNs, memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * RebuildSummary() Fold The Period's Totals Into The Overlay Summary, busiest zones first
+     *
+     * @param periodNs Unsigned Length Of The Period
+     */
+    static void RebuildSummary(uint64_t periodNs) {
+        double seconds = (double) periodNs / 1e9;
+        ProfileZoneStat stats[PROFILE_MAX_ZONES];
+        int count = 0;
+        int zones = ZoneCount();
+        // Frame Is Shown On Its Own Line, not ranked with the zones it contains
+        for (int zone = 1; zone < zones; zone++) {
+            uint32_t calls = zoneCalls[zone].exchange(0, memory_order_relaxed);
+            uint64_t selfNs = zoneSelfNs[zone].exchange(0, memory_order_relaxed);
+            uint64_t maxNs = zoneMaxNs[zone].exchange(0, memory_order_relaxed);
+            if (calls > 0) {
+                stats[count++] = {zoneNames[zone], (double) selfNs / 1e6 / seconds, (double) maxNs / 1e6, calls};
+            }
+        }
+        sort(stats, stats + count, [](const ProfileZoneStat &a, const ProfileZoneStat &b) {
+            return a.selfMsPerSecond > b.selfMsPerSecond;
+        });
+        summary.frameMeanMs = periodFrames > 0 ? periodFrameMs / periodFrames : 0;
+        summary.frameMaxMs = periodFrameMaxMs;
+        summary.slowFrames = periodSlowFrames;
+        summary.zoneCount = min(count, PROFILE_OVERLAY_ZONES);
+        copy(stats, stats + summary.zoneCount, summary.zones);
+        periodFrameMs = periodFrameMaxMs = 0;
+        periodFrames = periodSlowFrames = 0;
+    }
+
+    /**
+     * ZoneCount() Zones Registered So Far
+     *
+     * @return Integer Count
+     */
+    static int ZoneCount() {
+        lock_guard<mutex> lock(registryLock);
+        return zoneCount;
+    }
+
+public:
+    /**
+     * Now() Nanoseconds Since The Profiler Started
+     *
+     * @return Unsigned Time
+     */
+    static uint64_t Now() {
+        return (uint64_t) chrono::duration_cast<chrono::nanoseconds>(ProfileClock::now() - origin).count();
+    }
+
+    /**
+     * RegisterZone() Zone Id For A Name, called once per PROFILE_ZONE site
+     *
+     * @param name Char Pointer Zone Name, a string literal
+     * @return Integer Zone, -1 once every zone is taken
+     */
+    static int RegisterZone(const char *name) {
+        lock_guard<mutex> lock(registryLock);
+        for (int zone = 0; zone < zoneCount; zone++) {
+            if (strcmp(zoneNames[zone], name) == 0) {
+                return zone;
+            }
+        }
+        if (zoneCount == PROFILE_MAX_ZONES) {
+            return -1;
+        }
+        zoneNames[zoneCount] = name;
+        return zoneCount++;
+    }
+
+    /**
+     * NameThread() Name The Calling Thread In Traces, without claiming its ring yet
+     *
+     * @param name Char Pointer Thread Name, a string literal
+     * @param worker Boolean Condition, one of a pool of threads limited to PROFILE_WORKER_RINGS rings between them
+     */
+    static void NameThread(const char *name, bool worker = false) {
+        threadName = name;
+        threadWorker = worker;
+        if (currentThread != nullptr) {
+            currentThread->name = name;
+        }
+    }
+
+    /**
+     * Record() Store A Finished Zone In The Calling Thread's Ring
+     *
+     * @param zone Integer Zone
+     * @param startNs Unsigned Zone Start
+     * @param endNs Unsigned Zone End
+     * @param selfNs Unsigned Time Less Children
+     */
+    static void Record(int zone, uint64_t startNs, uint64_t endNs, uint64_t selfNs) {
+        Accumulate(zone, endNs - startNs, selfNs);
+        ProfileThread *thread = Thread();
+        if (thread == nullptr) {
+            return;
+        }
+        uint64_t index = thread->written.load(memory_order_relaxed);
+        ProfileEvent &event = thread->events[index % PROFILE_RING_EVENTS];
+        event.startNs = startNs;
+        event.endNs = endNs;
+        event.zone = (uint32_t) zone;
+        thread->written.store(index + 1, memory_order_release);
+    }
+
+    /**
+     * EndFrame() Close A Render Frame, call once per frame after the swap; writes a trace when the frame was slow
+     */
+    static void EndFrame() {
+        uint64_t now = Now();
+        if (framesRecorded++ == 0) {
+            lastFrameNs = periodStartNs = now;
+            return;
+        }
+        uint64_t frameNs = now - lastFrameNs;
+        Record(0, lastFrameNs, now, 0);
+        lastFrameNs = now;
+
+        double frameMs = (double) frameNs / 1e6;
+        periodFrameMs += frameMs;
+        periodFrameMaxMs = max(periodFrameMaxMs, frameMs);
+        periodFrames++;
+        if (frameMs > PROFILE_SLOW_FRAME_MS && framesRecorded > PROFILE_WARMUP_FRAMES) {
+            periodSlowFrames++;
+            if (lastSlowTraceNs == 0 || (double) (now - lastSlowTraceNs) / 1e9 > PROFILE_SLOW_FRAME_COOLDOWN) {
+                lastSlowTraceNs = now;
+                slowTraceWriter.Request(frameMs);
+            }
+        }
+        if (now - periodStartNs >= 1000000000ull) {
+            RebuildSummary(now - periodStartNs);
+            periodStartNs = now;
+        }
+    }
+
+    /**
+     * Summary() Overlay Figures Of The Last Full Second, read on the render thread
+     *
+     * @return ProfileSummary
+     */
+    static const ProfileSummary &Summary() { return summary; }
+
+    /**
+     * ExportChromeTrace() Write The Last PROFILE_TRACE_SECONDS Of Every Ring As Chrome Trace Event JSON
+     *
+     * @param path Char Pointer File Path
+     * @return Boolean Condition
+     */
+    static bool ExportChromeTrace(const char *path) {
+        lock_guard<mutex> exporting(exportLock);
+        FILE *file = fopen(path, "w");
+        if (file == nullptr) {
+            return false;
+        }
+        uint64_t now = Now();
+        uint64_t cutoff = now > PROFILE_TRACE_SECONDS * 1000000000ull ? now - PROFILE_TRACE_SECONDS * 1000000000ull : 0;
+        const char *names[PROFILE_MAX_ZONES];
+        int zones;
+        {
+            lock_guard<mutex> lock(registryLock);
+            zones = zoneCount;
+            copy(zoneNames, zoneNames + zones, names);
+        }
+
+        fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+        bool first = true;
+        int nThreads = min(threadCount.load(memory_order_relaxed), PROFILE_MAX_THREADS);
+        for (int t = 0; t < nThreads; t++) {
+            ProfileThread &thread = threads[t];
+            const char *threadName = thread.name.load(memory_order_relaxed);
+            fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":",
+                    first ? "" : ",\n", t);
+            WriteJsonString(file, threadName != nullptr ? threadName : "Thread");
+            fprintf(file, "}}");
+            first = false;
+
+            // Rings Are Read While Their Threads Keep Writing; anything overwritten during the pass is dropped below
+            uint64_t written = thread.written.load(memory_order_acquire);
+            uint64_t oldest = written > PROFILE_RING_EVENTS ? written - PROFILE_RING_EVENTS : 0;
+            for (uint64_t i = oldest; i < written; i++) {
+                ProfileEvent event = thread.events[i % PROFILE_RING_EVENTS];
+                // Copy Stays Ahead Of The Recheck, so a slot rewritten mid-copy is seen as overwritten
+                atomic_thread_fence(memory_order_acquire);
+                uint64_t overwritten = thread.written.load(memory_order_relaxed);
+                if (overwritten >= PROFILE_RING_EVENTS && i <= overwritten - PROFILE_RING_EVENTS) {
+                    continue;
+                }
+                if (event.endNs < cutoff || (int) event.zone >= zones) {
+                    continue;
+                }
+                fprintf(file, ",\n{\"name\":");
+                WriteJsonString(file, names[event.zone]);
+                fprintf(file, ",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}", t,
+                        (double) event.startNs / 1e3, (double) (event.endNs - event.startNs) / 1e3);
+            }
+        }
+        fprintf(file, "\n]}\n");
+        return fclose(file) == 0;
+    }
+};
+
+/**
+ * @struct ProfileScope
+ * @details Times A Zone For The Lifetime Of The Scope; the enclosing scope on the same thread is its parent, and is
+ * told how long its child ran so it can report self time
+ */
+struct ProfileScope {
+    inline static thread_local ProfileScope *current = nullptr;
+
+    ProfileScope *parent;
+    int zone;
+    uint64_t startNs, childNs = 0;
+
+    explicit ProfileScope(int zone) : parent(current), zone(zone), startNs(FrameProfiler::Now()) { current = this; }
+
+    ~ProfileScope() {
+        uint64_t endNs = FrameProfiler::Now(), durationNs = endNs - startNs;
+        current = parent;
+        if (parent != nullptr) {
+            parent->childNs += durationNs;
+        }
+        if (zone >= 0) {
+            FrameProfiler::Record(zone, startNs, endNs, durationNs - min(childNs, durationNs));
+        }
+    }
+
+    ProfileScope(const ProfileScope &) = delete;
+
+    ProfileScope &operator=(const ProfileScope &) = delete;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(name)                                                                                             \
+    static const int PROFILE_CONCAT(profileZone, __LINE__) = FrameProfiler::RegisterZone(name);                       \
+    ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(PROFILE_CONCAT(profileZone, __LINE__))
+#define PROFILE_THREAD(name) FrameProfiler::NameThread(name)
+#define PROFILE_WORKER_THREAD(name) FrameProfiler::NameThread(name, true)
+#define PROFILE_END_FRAME() FrameProfiler::EndFrame()
+
+#else
+
+#define PROFILE_ZONE(name)
+#define PROFILE_THREAD(name)
+#define PROFILE_WORKER_THREAD(name)
+#define PROFILE_END_FRAME()
+
+#endif //ROADREALM_FRAME_PROFILER
+
+#endif //ROADREALM_FRAMEPROFILER_H
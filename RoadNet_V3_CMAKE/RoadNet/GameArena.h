@@ -0,0 +1,59 @@
+/**
+ * @file GameArena.h
+ * @author Team 8: Edwin Kaburu, Vincent Marklynn, Yong Long Tan
+ * @date 10/19/2026
+ */
+
+#ifndef ROADREALM_GAMEARENA_H
+#define ROADREALM_GAMEARENA_H
+
+#include <cstddef>
+#include <memory_resource>
+
+using namespace std;
+
+// Static Bytes Reserved For One Game, the arena only falls back to the heap past this budget. Sized for the pool's
+// chunks of every road key, runner and path code size a long game of linking and wiping ends up holding
+#define GAME_ARENA_BYTES (256 * 1024)
+
+/**
+ * @class GameArena
+ * @details Per-game memory for runners, their encoded paths and hash keys. A pool resource recycles blocks freed by
+ * wiped roads, and everything is dropped at once when the game resets.
+ */
+class GameArena {
+private:
+    alignas(max_align_t) std::byte arenaBuffer[GAME_ARENA_BYTES];
+    pmr::monotonic_buffer_resource arenaMonotonic;
+    pmr::unsynchronized_pool_resource arenaPool;
+
+public:
+    /**
+     * GameArena() Default Constructor For A Game Arena
+     */
+    GameArena() : arenaMonotonic(arenaBuffer, sizeof(arenaBuffer), pmr::new_delete_resource()),
+                  arenaPool(&arenaMonotonic) {}
+
+    GameArena(const GameArena &) = delete;
+
+    GameArena &operator=(const GameArena &) = delete;
+
+    /**
+     * Resource() Memory Resource Handed To Containers And Paths
+     *
+     * @return Memory Resource Pointer
+     */
+    pmr::memory_resource *Resource() { return &arenaPool; }
+
+    /**
+     * Release() Drop Every Allocation Of The Game, anything still referencing the arena must be destroyed first
+     */
+    void Release() {
+        arenaPool.release();
+        arenaMonotonic.release();
+    }
+};
+
+GameArena GAME_ARENA;
+
+#endif //ROADREALM_GAMEARENA_H
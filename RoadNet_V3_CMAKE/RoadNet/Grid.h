@@ -6,6 +6,7 @@
 #ifndef ROADREALM_GRID_H
 #define ROADREALM_GRID_H
 
+#include <array>
 #include "RoadNetShared.h"
 
 /**
@@ -30,6 +31,25 @@ private:
     vector<DestinationObjectives> gridDestObjectives;
     // Reversion condition
     bool revertState = false;
+    // Revision Stamp Per Node, so snapshots only copy nodes changed since they were last filled
+    vector<uint32_t> cellRevisions;
+    uint32_t gridRevision = 1;
+
+    /**
+     * MarkChanged() Stamp A Node With A New Grid Revision
+     *
+     * @param node Node Struct
+     */
+    void MarkChanged(const Node &node) {
+        cellRevisions.at(CombineDigits(node.currentPos.row, node.currentPos.col)) = ++gridRevision;
+    }
+
+    /**
+     * MarkAllChanged() Stamp Every Node With A New Grid Revision
+     */
+    void MarkAllChanged() {
+        cellRevisions.assign(gridNodes.size(), ++gridRevision);
+    }
 
     /**
      * FormulateGrid() Will formulate the nodes contained within the grid based on NROWS AND NCOLS
@@ -43,6 +63,9 @@ private:
                 gridNodes.push_back(cellNode);
             }
         }
+        cellRevisions.assign(gridNodes.size(), gridRevision);
+        // Every Objective Closes Two Nodes, so spawning one never grows the list
+        gridDestObjectives.reserve(gridNodes.size() / 2);
     }
 
     /**
@@ -82,6 +105,7 @@ private:
      * @return Boolean Condition
      */
     bool NodeStatesHandler(Node *node) {
+        MarkChanged(*node);
         if (node->currentState == OPEN && GLOBAL_GAMEPLAY_STATE == DRAW_STATE) {
             node->currentState = node->transState;
             node->transState = CLOSED_ROAD;
@@ -130,8 +154,8 @@ private:
         vec2 adjacentBottomRight = vec2(point.x - 1, point.y + 1);
         vec2 adjacentTopRight = vec2(point.x + 1, point.y + 1);
 
-        vector<vec2> adjacentNodes = {adjacentBottom, adjacentTop, adjacentLeft, adjacentRight, adjacentBottomLeft,
-                                      adjacentTopLeft, adjacentBottomRight, adjacentTopRight};
+        array<vec2, 8> adjacentNodes = {adjacentBottom, adjacentTop, adjacentLeft, adjacentRight, adjacentBottomLeft,
+                                        adjacentTopLeft, adjacentBottomRight, adjacentTopRight};
 
         for (auto node: adjacentNodes) {
             if (IsAClosedNodeState(node)) {
@@ -177,6 +201,8 @@ public:
                 objectives.destLinked = isLinked;
                 objectives.houseNode.isConnected = isLinked;
                 objectives.factoryNode.isConnected = isLinked;
+                MarkChanged(objectives.houseNode);
+                MarkChanged(objectives.factoryNode);
                 // Update Performed.
                 return true;
             }
@@ -220,6 +246,8 @@ public:
 
                 gridNodes.at(startNIndex).overlayColor = shrRandColor;
                 gridNodes.at(endNIndex).overlayColor = shrRandColor;
+                MarkChanged(gridNodes.at(startNIndex));
+                MarkChanged(gridNodes.at(endNIndex));
 
                 // Add To Objectives
                 gridDestObjectives.push_back({gridNodes.at(startNIndex), gridNodes.at(endNIndex)});
@@ -231,44 +259,73 @@ public:
     }
 
     /**
-     *  DrawGrid() GridPrimitive Draw Function
+     * FindMatchingFactory() Find The Factory Objective Paired With A House
+     *
+     * @param homePos House NodePosition
+     * @param factoryPos Factory NodePosition Output
+     * @return Boolean Condition
      */
-    void DrawGrid() {
-        // Draw All Cells
-        for (Node &cell: gridNodes) {
+    bool FindMatchingFactory(NodePosition homePos, NodePosition &factoryPos) {
+        for (DestinationObjectives &objectives: gridDestObjectives) {
+            if (IsSimilarNodePos(homePos, objectives.houseNode.currentPos)) {
+                factoryPos = objectives.factoryNode.currentPos;
+                return true;
+            }
+        }
+        return false;
+    }
 
-            // Draw Grid
-            DrawRectangle(cell.currentPos.PosWindowProj().x, cell.currentPos.PosWindowProj().y,
-                          cell.currentPos.PosWindowProj().z, cell.currentPos.PosWindowProj().w,
-                          cell.color);
+    /**
+     * Objectives() House And Factory Objectives, in the order they spawned
+     *
+     * @return DestinationObjectives Collection
+     */
+    const vector<DestinationObjectives> &Objectives() const { return gridDestObjectives; }
 
-            if (cell.currentState == CLOSED_HOUSE) {
-                Disk(vec2(X_POS + (cell.currentPos.col + .5) * DX, Y_POS + (cell.currentPos.row + .5) * DY),
-                     GetCirDiam(!cell.isConnected), cell.overlayColor);
-            }
-            if (cell.currentState == CLOSED_FACTORY) {
-                Disk(vec2(X_POS + (cell.currentPos.col + .5) * DX, Y_POS + (cell.currentPos.row + .5) * DY),
-                     GetCirDiam(!cell.isConnected), cell.overlayColor);
-
-                // Horizontal Line
-                Line(vec2(X_POS + (cell.currentPos.col + 0.0) * DX, Y_POS + (cell.currentPos.row + 0.5) * DY),
-                     vec2(X_POS + (cell.currentPos.col + 1.0) * DX, Y_POS + (cell.currentPos.row + 0.5) * DY),
-                     1.0f, cell.overlayColor);
-
-                // Vertical Line
-                Line(vec2(X_POS + (cell.currentPos.col + 0.5) * DX, Y_POS + (cell.currentPos.row + 1.0) * DY),
-                     vec2(X_POS + (cell.currentPos.col + 0.5) * DX, Y_POS + (cell.currentPos.row + 0.0) * DY),
-                     1.0f, cell.overlayColor);
+    /**
+     * FillBlockedCells() Flag Every Cell That A Road Cannot Pass Through
+     *
+     * @param blockedCells Byte Collection Output, one entry per node
+     */
+    void FillBlockedCells(vector<uint8_t> &blockedCells) {
+        blockedCells.resize(gridNodes.size());
+        for (size_t i = 0; i < gridNodes.size(); i++) {
+            blockedCells[i] = IsAClosedNodeState(gridNodes[i], true) || gridNodes[i].currentState == POTENTIAL_ROAD;
+        }
+    }
+
+    /**
+     * Revision() Latest Grid Revision, every node change stamps a higher one
+     *
+     * @return Unsigned Revision
+     */
+    uint32_t Revision() const { return gridRevision; }
+
+    /**
+     * ForEachChangedNode() Visit Nodes Changed After A Revision
+     *
+     * @tparam F Visitor Type
+     * @param sinceRevision Unsigned Revision Already Seen By The Caller
+     * @param visit Visitor, called with (nodeIndex, node)
+     */
+    template<typename F>
+    void ForEachChangedNode(uint32_t sinceRevision, F visit) const {
+        for (size_t i = 0; i < gridNodes.size(); i++) {
+            if (cellRevisions[i] > sinceRevision) {
+                visit((int) i, gridNodes[i]);
             }
         }
     }
 
     /**
      * GridUpdate() Grid Update Function
+     *
+     * @param cellWidth Integer Cell Width In Pixels
+     * @param cellHeight Integer Cell Height In Pixels
      */
-    void GridUpdate() {
+    void GridUpdate(int cellWidth, int cellHeight) {
         // Update Diameter Max Size
-        MAX_DIAMETER_SIZE = GetMin<float>((int) DX - 1, (int) DY - 1) * MAX_CIR_EXPANSION;
+        MAX_DIAMETER_SIZE = GetMin<float>(cellWidth, cellHeight) * MAX_CIR_EXPANSION;
     }
 
     /**
@@ -335,9 +392,9 @@ public:
      * @param gridAxisPoints Collection
      * @param enableReset Boolean Condition For Reversion
      */
-    void ResetNodes(vector<vec2> gridAxisPoints, bool enableReset) {
+    void ResetNodes(const vector<vec2> &gridAxisPoints, bool enableReset) {
         this->revertState = enableReset;
-        for (vec2 &pt: gridAxisPoints) {
+        for (const vec2 &pt: gridAxisPoints) {
             int mapToIndex = CombineDigits((int) pt.y, (int) pt.x);
             NodeHandler(mapToIndex);
         }
@@ -352,6 +409,7 @@ public:
         for (Node &cell: gridNodes) {
             cell.NodeReset();
         }
+        MarkAllChanged();
     }
 
     /**
@@ -382,6 +440,7 @@ public:
             }
             cell.isConnected = false;
         }
+        MarkAllChanged();
         for (DestinationObjectives &objectives: gridDestObjectives) {
             if (objectives.destLinked) {
                 objectives.destLinked = false;
@@ -0,0 +1,310 @@
+/**
+ * @file GridRenderer.h
+ * @author Team 8: Edwin Kaburu, Vincent Marklynn, Yong Long Tan
+ * @date 10/19/2026
+ */
+
+#ifndef ROADREALM_GRIDRENDERER_H
+#define ROADREALM_GRIDRENDERER_H
+
+#include <glad.h>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "GLState.h"
+#include "GLXtras.h"
+#include "SoftRaster.h"
+#include "VecMat.h"
+
+using namespace std;
+
+// Colors A Grid Can Show At Once, one byte per cell indexes the palette
+#define GRID_PALETTE_SIZE 256
+// Pixels Left Uncovered Between Neighbouring Cells, the background shows through as grid lines
+#define GRID_CELL_GAP 1.0f
+// Dirty Share Of The Grid Above Which One Whole-Texture Upload Beats Per-Run Uploads
+#define GRID_FULL_UPLOAD_FRACTION 8
+
+/**
+ * @class GridRenderer
+ * @details Draws a whole grid as one quad. Each cell is a byte in an R8 texture that indexes a palette texture, the
+ * fragment shader finds its cell, leaves the gap between cells uncovered and looks the color up. The CPU only touches
+ * cells that changed, so drawing costs the same for a 14x14 board as for a 4096x4096 one.
+ */
+class GridRenderer {
+private:
+    int gridCols = 0, gridRows = 0;
+    // CPU Copy Of The Cell Texture, and which cells differ from the uploaded one
+    vector<uint8_t> cellIndices;
+    vector<uint8_t> dirtyFlags;
+    vector<int> dirtyCells;
+
+    vector<vec3> palette;
+    bool paletteDirty = true;
+
+    GLuint cellTexture = 0, paletteTexture = 0, vao = 0;
+    GLuint program = 0;
+
+    /**
+     * Initialize() Build The Shader And Textures On First Draw
+     */
+    void Initialize() {
+        static const char *vertexCode = R"(
+            #version 410 core
+            uniform mat4 view;
+            uniform vec2 origin, extent;
+            out vec2 gridPixel;
+            void main() {
+                vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+                gridPixel = corner * extent;
+                gl_Position = view * vec4(origin + gridPixel, 0, 1);
+            }
+        )";
+        static const char *pixelCode = R"(
+            #version 410 core
+            in vec2 gridPixel;
+            out vec4 pColor;
+            uniform sampler2D cells;
+            uniform sampler2D palette;
+            uniform vec2 cellSize;
+            uniform ivec2 gridSize;
+            uniform float gap;
+            void main() {
+                ivec2 cell = min(ivec2(floor(gridPixel / cellSize)), gridSize - 1);
+                vec2 inside = gridPixel - floor(vec2(cell) * cellSize);
+                if (any(greaterThanEqual(inside, floor(cellSize) - gap)))
+                    discard;
+                int index = int(texelFetch(cells, cell, 0).r * 255.0 + 0.5);
+                pColor = texelFetch(palette, ivec2(index, 0), 0);
+            }
+        )";
+        program = LinkProgramViaCode(&vertexCode, &pixelCode);
+        UseProgram(program);
+        SetUniform(program, "cells", 0);
+        SetUniform(program, "palette", 1);
+
+        // Corners Come From gl_VertexID, the core profile still wants a vertex array bound
+        glGenVertexArrays(1, &vao);
+
+        GLuint textures[2];
+        glGenTextures(2, textures);
+        cellTexture = textures[0];
+        paletteTexture = textures[1];
+        for (GLuint texture: textures) {
+            BindTexture(GL_TEXTURE_2D, texture);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        }
+        glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, GRID_PALETTE_SIZE, 1);
+        BindTexture(GL_TEXTURE_2D, 0);
+    }
+
+    /**
+     * AllocateCells() Size The Cell Texture To The Grid And Send Every Cell
+     */
+    void AllocateCells() {
+        BindTexture(GL_TEXTURE_2D, cellTexture);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, gridCols, gridRows, 0, GL_RED, GL_UNSIGNED_BYTE, cellIndices.data());
+        for (int cell: dirtyCells) {
+            dirtyFlags[cell] = 0;
+        }
+        dirtyCells.clear();
+    }
+
+    /**
+     * Upload() Send Changed Cells And Palette Entries To The GPU
+     */
+    void Upload() {
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        if (paletteDirty) {
+            uint8_t rgba[GRID_PALETTE_SIZE * 4] = {};
+            for (size_t i = 0; i < palette.size(); i++) {
+                rgba[i * 4 + 0] = (uint8_t) (clamp(palette[i].x, 0.0f, 1.0f) * 255.0f + 0.5f);
+                rgba[i * 4 + 1] = (uint8_t) (clamp(palette[i].y, 0.0f, 1.0f) * 255.0f + 0.5f);
+                rgba[i * 4 + 2] = (uint8_t) (clamp(palette[i].z, 0.0f, 1.0f) * 255.0f + 0.5f);
+                rgba[i * 4 + 3] = 255;
+            }
+            BindTexture(GL_TEXTURE_2D, paletteTexture);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, GRID_PALETTE_SIZE, 1, GL_RGBA, GL_UNSIGNED_BYTE, rgba);
+            paletteDirty = false;
+        }
+        if (dirtyCells.empty()) {
+            return;
+        }
+        BindTexture(GL_TEXTURE_2D, cellTexture);
+        if (dirtyCells.size() * GRID_FULL_UPLOAD_FRACTION >= cellIndices.size()) {
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, gridCols, gridRows, GL_RED, GL_UNSIGNED_BYTE, cellIndices.data());
+        } else {
+            // Consecutive Dirty Cells In A Row Go Up Together
+            sort(dirtyCells.begin(), dirtyCells.end());
+            for (size_t i = 0; i < dirtyCells.size();) {
+                int first = dirtyCells[i], row = first / gridCols, count = 1;
+                while (i + count < dirtyCells.size() && dirtyCells[i + count] == first + count &&
+                       (first + count) / gridCols == row) {
+                    count++;
+                }
+                glTexSubImage2D(GL_TEXTURE_2D, 0, first % gridCols, row, count, 1, GL_RED, GL_UNSIGNED_BYTE,
+                                &cellIndices[first]);
+                i += count;
+            }
+        }
+        for (int cell: dirtyCells) {
+            dirtyFlags[cell] = 0;
+        }
+        dirtyCells.clear();
+    }
+
+public:
+    GridRenderer() {}
+
+    GridRenderer(const GridRenderer &) = delete;
+
+    GridRenderer &operator=(const GridRenderer &) = delete;
+
+    ~GridRenderer() { Release(); }
+
+    /**
+     * Resize() Set The Grid Dimensions, every cell starts at palette entry 0
+     *
+     * @param cols Integer Columns
+     * @param rows Integer Rows
+     */
+    void Resize(int cols, int rows) {
+        gridCols = cols;
+        gridRows = rows;
+        cellIndices.assign((size_t) cols * rows, 0);
+        dirtyFlags.assign(cellIndices.size(), 0);
+        dirtyCells.clear();
+        // Without GL (a software target is current) the texture is made by the first GL Draw()
+        if (program != 0) {
+            AllocateCells();
+        } else if (!CurrentSoftTarget()) {
+            Initialize();
+            AllocateCells();
+        }
+    }
+
+    int Cols() const { return gridCols; }
+
+    int Rows() const { return gridRows; }
+
+    /**
+     * PaletteIndex() Palette Entry For A Color, added on first use
+     *
+     * @param color Vec3 Color
+     * @return Integer Palette Index, the last entry is reused once the palette is full
+     */
+    int PaletteIndex(const vec3 &color) {
+        for (size_t i = 0; i < palette.size(); i++) {
+            if (palette[i].x == color.x && palette[i].y == color.y && palette[i].z == color.z) {
+                return (int) i;
+            }
+        }
+        if (palette.size() == GRID_PALETTE_SIZE) {
+            return GRID_PALETTE_SIZE - 1;
+        }
+        palette.push_back(color);
+        paletteDirty = true;
+        return (int) palette.size() - 1;
+    }
+
+    /**
+     * SetCell() Change A Cell, uploaded on the next Draw() only if it differs
+     *
+     * @param cellIndex Integer row * Cols() + col
+     * @param paletteIndex Integer Palette Entry
+     */
+    void SetCell(int cellIndex, int paletteIndex) {
+        if (cellIndices[cellIndex] == (uint8_t) paletteIndex) {
+            return;
+        }
+        cellIndices[cellIndex] = (uint8_t) paletteIndex;
+        if (!dirtyFlags[cellIndex]) {
+            dirtyFlags[cellIndex] = 1;
+            dirtyCells.push_back(cellIndex);
+        }
+    }
+
+    /**
+     * SetCellColor() Change A Cell By Color
+     *
+     * @param cellIndex Integer row * Cols() + col
+     * @param color Vec3 Color
+     */
+    void SetCellColor(int cellIndex, const vec3 &color) { SetCell(cellIndex, PaletteIndex(color)); }
+
+    /**
+     * Draw() Upload Pending Changes And Draw Every Cell With One Quad
+     *
+     * @param view Mat4 Pixel-To-Clip Transform, as from ScreenMode()
+     * @param origin Vec2 Pixel Position Of Cell (0, 0)
+     * @param cellSize Vec2 Cell Pitch In Pixels
+     */
+    void Draw(mat4 view, vec2 origin, vec2 cellSize) {
+        if (gridCols == 0 || gridRows == 0) {
+            return;
+        }
+        if (SoftTarget *soft = CurrentSoftTarget()) {
+            DrawSoft(*soft, view, origin, cellSize);
+            return;
+        }
+        if (program == 0) {
+            Initialize();
+            AllocateCells();
+        }
+        Upload();
+        // Steady Frames Repeat Last Frame's Uniforms And Bindings, the state layer drops those calls
+        UseProgram(program);
+        SetUniform(program, "view", view);
+        SetUniform(program, "origin", origin);
+        SetUniform(program, "extent", vec2(cellSize.x * (float) gridCols, cellSize.y * (float) gridRows));
+        SetUniform(program, "cellSize", cellSize);
+        SetUniform(program, "gridSize", int2(gridCols, gridRows));
+        SetUniform(program, "gap", GRID_CELL_GAP);
+        BindTexture(1, GL_TEXTURE_2D, paletteTexture);
+        BindTexture(0, GL_TEXTURE_2D, cellTexture);
+        BindVertexArray(vao);
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    }
+
+    /**
+     * DrawSoft() Draw Every Cell As A Rectangle Into A Software Target, leaving the same gap as the shader
+     *
+     * @param soft SoftTarget
+     * @param view Mat4 Pixel-To-Clip Transform
+     * @param origin Vec2 Pixel Position Of Cell (0, 0)
+     * @param cellSize Vec2 Cell Pitch In Pixels
+     */
+    void DrawSoft(SoftTarget &soft, mat4 view, vec2 origin, vec2 cellSize) {
+        soft.SetView(view);
+        vec2 inner = vec2(floor(cellSize.x), floor(cellSize.y)) - vec2(GRID_CELL_GAP, GRID_CELL_GAP);
+        for (int row = 0; row < gridRows; row++) {
+            for (int col = 0; col < gridCols; col++) {
+                vec2 p = origin + vec2(floor((float) col * cellSize.x), floor((float) row * cellSize.y));
+                size_t index = cellIndices[(size_t) row * gridCols + col];
+                vec3 color = index < palette.size() ? palette[index] : vec3(0, 0, 0);
+                soft.Quad(vec3(p, 0), vec3(p.x, p.y + inner.y, 0), vec3(p + inner, 0), vec3(p.x + inner.x, p.y, 0),
+                          vec4(color, 1));
+            }
+        }
+    }
+
+    /**
+     * Release() Delete The GL Objects
+     */
+    void Release() {
+        if (program != 0) {
+            GLuint textures[2] = {cellTexture, paletteTexture};
+            DeleteTextures(2, textures);
+            DeleteVertexArrays(1, &vao);
+            DeleteProgram(program);
+        }
+        program = cellTexture = paletteTexture = vao = 0;
+        gridCols = gridRows = 0;
+    }
+};
+
+#endif //ROADREALM_GRIDRENDERER_H
@@ -0,0 +1,178 @@
+/**
+ * @file HeadlessPlayer.h
+ * @author Team 8: Edwin Kaburu, Vincent Marklynn, Yong Long Tan
+ * @date 10/19/2026
+ */
+
+#ifndef ROADREALM_HEADLESSPLAYER_H
+#define ROADREALM_HEADLESSPLAYER_H
+
+#include <cstdint>
+#include <vector>
+#include "Grid.h"
+#include "InputEvents.h"
+#include "PathPlanner.h"
+
+using namespace std;
+
+// Ticks Between Two Inputs Of The Headless Player, about as quick as a person drags across cells
+#define HEADLESS_INPUT_TICKS 3
+
+enum HeadlessPlayerStep : uint8_t {
+    HEADLESS_PLAN, HEADLESS_PRESS, HEADLESS_DRAG, HEADLESS_SWITCH
+};
+
+/**
+ * @class HeadlessPlayer
+ * @details Plays headless runs that have no replay, so they drag, link and wipe roads like a person would. Each road
+ * is planned from an unlinked house to its factory and dragged one cell per input; every other road is wiped right
+ * after it links (W, the same drag, then D) and linked again later, and traffic mode is toggled after each wipe so
+ * both ways of moving vehicles get played. Input goes through the same queue as GLFW callbacks, so a --record of a
+ * headless run replays like any other recording.
+ */
+class HeadlessPlayer {
+private:
+    DStarLitePlanner planner;
+    vector<uint8_t> blockedCells;
+    vector<NodePosition> road;
+    size_t roadStep = 0;
+    HeadlessPlayerStep step = HEADLESS_PLAN;
+    bool wiping = false, wipeNext = false;
+    uint32_t ticks = 0;
+    int linkDrags = 0, wipeDrags = 0;
+
+    /**
+     * PlanRoad() Plan A Road From The First Reachable Unlinked House To Its Factory
+     *
+     * @param gridPrimitive GridPrimitive
+     * @return Boolean Condition, false if no unlinked house can reach its factory
+     */
+    bool PlanRoad(GridPrimitive &gridPrimitive) {
+        gridPrimitive.FillBlockedCells(blockedCells);
+        for (const DestinationObjectives &objective: gridPrimitive.Objectives()) {
+            if (objective.destLinked) {
+                continue;
+            }
+            planner.Begin(NROWS, NCOLS, objective.houseNode.currentPos, objective.factoryNode.currentPos,
+                          blockedCells);
+            planner.ComputeShortestPath();
+            bool found = planner.ExtractPath(road);
+            planner.End();
+            if (found) {
+                return true;
+            }
+        }
+        road.clear();
+        return false;
+    }
+
+    /**
+     * Send() Queue One Input Event
+     *
+     * @tparam Queue Input Queue Type
+     * @param events Queue Input Queue
+     * @param type InputEventType
+     * @param timeUs Unsigned Input Clock Time
+     * @param cell NodePosition Cell Under The Cursor
+     * @param button UiButton Button Under The Cursor
+     * @param key Unsigned GLFW Key, for INPUT_KEY
+     */
+    template<typename Queue>
+    static void Send(Queue &events, InputEventType type, uint32_t timeUs, NodePosition cell,
+                     UiButton button = BUTTON_NONE, uint16_t key = 0) {
+        InputEvent event;
+        event.timeUs = timeUs;
+        event.type = type;
+        event.col = (int16_t) cell.col;
+        event.row = (int16_t) cell.row;
+        event.button = button;
+        event.key = key;
+        events.Push(event);
+    }
+
+public:
+    /**
+     * HeadlessPlayer() Default Constructor, with room for a road across every cell
+     */
+    HeadlessPlayer() {
+        road.reserve(NROWS * NCOLS);
+    }
+
+    /**
+     * Step() Queue The Input Of One Tick, called before the tick drains its input
+     *
+     * @tparam Queue Input Queue Type
+     * @param gridPrimitive GridPrimitive Grid The Coming Tick Plays On
+     * @param events Queue Input Queue
+     * @param timeUs Unsigned Input Clock Time Of The Coming Tick
+     */
+    template<typename Queue>
+    void Step(GridPrimitive &gridPrimitive, Queue &events, uint32_t timeUs) {
+        if (ticks++ % HEADLESS_INPUT_TICKS != 0) {
+            return;
+        }
+        if (APPLICATION_STATE != GAME_STATE) {
+            // Start Over After A Game Over, any drag in progress was thrown away with the game
+            Send(events, INPUT_MOUSE_PRESS, timeUs, NodePosition(), BUTTON_START);
+            Send(events, INPUT_MOUSE_RELEASE, timeUs, NodePosition());
+            step = HEADLESS_PLAN;
+            wiping = false;
+            return;
+        }
+
+        switch (step) {
+            case HEADLESS_PLAN:
+                if (PlanRoad(gridPrimitive)) {
+                    step = HEADLESS_PRESS;
+                }
+                break;
+            case HEADLESS_PRESS:
+                Send(events, INPUT_MOUSE_PRESS, timeUs, road.front());
+                roadStep = 1;
+                step = HEADLESS_DRAG;
+                break;
+            case HEADLESS_DRAG:
+                if (roadStep < road.size()) {
+                    Send(events, INPUT_MOUSE_MOVE, timeUs, road[roadStep++]);
+                } else {
+                    Send(events, INPUT_MOUSE_RELEASE, timeUs, road.back());
+                    step = HEADLESS_SWITCH;
+                }
+                break;
+            case HEADLESS_SWITCH:
+                // Mode Keys Wait A Tick, the release is judged in the mode the road was dragged in
+                if (wiping) {
+                    wipeDrags++;
+                    wiping = false;
+                    Send(events, INPUT_KEY, timeUs, NodePosition(), BUTTON_NONE, GLFW_KEY_D);
+                    Send(events, INPUT_KEY, timeUs, NodePosition(), BUTTON_NONE, GLFW_KEY_T);
+                    step = HEADLESS_PLAN;
+                } else {
+                    linkDrags++;
+                    wipeNext = !wipeNext;
+                    wiping = wipeNext;
+                    if (wiping) {
+                        Send(events, INPUT_KEY, timeUs, NodePosition(), BUTTON_NONE, GLFW_KEY_W);
+                    }
+                    step = wiping ? HEADLESS_PRESS : HEADLESS_PLAN;
+                }
+                break;
+        }
+    }
+
+    /**
+     * LinkDrags() Roads Dragged In Draw Mode So Far
+     *
+     * @return Integer Count
+     */
+    int LinkDrags() const { return linkDrags; }
+
+    /**
+     * WipeDrags() Roads Dragged In Wipe Mode So Far
+     *
+     * @return Integer Count
+     */
+    int WipeDrags() const { return wipeDrags; }
+};
+
+#endif //ROADREALM_HEADLESSPLAYER_H
@@ -0,0 +1,216 @@
+/**
+ * @file InputEvents.h
+ * @author Team 8: Edwin Kaburu, Vincent Marklynn, Yong Long Tan
+ * @date 10/19/2026
+ */
+
+#ifndef ROADREALM_INPUTEVENTS_H
+#define ROADREALM_INPUTEVENTS_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+
+using namespace std;
+
+// File Tag And Version Of Recorded Input Streams
+#define INPUT_RECORD_MAGIC 0x4E495252u
+#define INPUT_RECORD_VERSION 1
+// Write Buffer Of The Recorder, flushed by stdio when full
+#define INPUT_RECORD_BUFFER (16 * 1024)
+
+enum InputEventType : uint8_t {
+    INPUT_MOUSE_PRESS, INPUT_MOUSE_RELEASE, INPUT_MOUSE_MOVE, INPUT_KEY, INPUT_RESIZE, INPUT_TICK
+};
+
+enum UiButton : uint8_t {
+    BUTTON_NONE, BUTTON_RESET, BUTTON_PAUSE, BUTTON_EXIT, BUTTON_CLEAR, BUTTON_START, BUTTON_QUIT
+};
+
+/**
+ * @struct InputEvent
+ * @details Input Captured By A GLFW Callback, already resolved to a grid cell or UI button. INPUT_TICK marks the
+ * start of a simulation tick in recorded streams, its timestamp gives the tick's time step.
+ */
+struct InputEvent {
+    // Microseconds On The Input Clock, wraps after ~71 minutes so only differences are meaningful
+    uint32_t timeUs = 0;
+    // Grid Cell, or the new cell size for INPUT_RESIZE
+    int16_t col = 0, row = 0;
+    uint16_t key = 0;
+    InputEventType type = INPUT_KEY;
+    UiButton button = BUTTON_NONE;
+};
+
+static_assert(sizeof(InputEvent) == 12, "InputEvent is recorded as raw bytes and should stay compact");
+
+/**
+ * InputTimestamp() Current Time On The Input Clock
+ *
+ * @return Unsigned Microseconds
+ */
+uint32_t InputTimestamp() {
+    return (uint32_t) chrono::duration_cast<chrono::microseconds>(
+            chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * ElapsedSeconds() Time Between Two Input Clock Stamps, correct across a wrap
+ *
+ * @param from Unsigned Earlier Stamp
+ * @param to Unsigned Later Stamp
+ * @return Float Seconds
+ */
+float ElapsedSeconds(uint32_t from, uint32_t to) {
+    return (float) (uint32_t) (to - from) * 1e-6f;
+}
+
+/**
+ * @struct InputRecordHeader
+ * @details Leading Block Of A Recorded Input Stream
+ */
+struct InputRecordHeader {
+    uint32_t magic = INPUT_RECORD_MAGIC;
+    uint32_t version = INPUT_RECORD_VERSION;
+    // Seed Of GAME_RNG And Input Clock Time Of The First Tick
+    uint32_t seed = 0;
+    uint32_t startTimeUs = 0;
+};
+
+/**
+ * @class InputRecorder
+ * @details Appends every event the simulation consumes to a file, together with tick markers
+ */
+class InputRecorder {
+private:
+    FILE *recordFile = nullptr;
+    char writeBuffer[INPUT_RECORD_BUFFER];
+
+public:
+    InputRecorder() {}
+
+    InputRecorder(const InputRecorder &) = delete;
+
+    InputRecorder &operator=(const InputRecorder &) = delete;
+
+    ~InputRecorder() { Close(); }
+
+    /**
+     * Open() Start A New Recording
+     *
+     * @param path Char Pointer File Path
+     * @param seed Unsigned Gameplay Seed
+     * @param startTimeUs Unsigned Input Clock Time Of The First Tick
+     * @return Boolean Condition
+     */
+    bool Open(const char *path, uint32_t seed, uint32_t startTimeUs) {
+        Close();
+        recordFile = fopen(path, "wb");
+        if (recordFile == nullptr) {
+            cout << "Input recording could not be created: " << path << endl;
+            return false;
+        }
+        setvbuf(recordFile, writeBuffer, _IOFBF, sizeof(writeBuffer));
+        InputRecordHeader header;
+        header.seed = seed;
+        header.startTimeUs = startTimeUs;
+        fwrite(&header, sizeof(header), 1, recordFile);
+        return true;
+    }
+
+    bool IsOpen() const { return recordFile != nullptr; }
+
+    /**
+     * Write() Append An Event
+     *
+     * @param event InputEvent
+     */
+    void Write(const InputEvent &event) {
+        if (recordFile != nullptr) {
+            fwrite(&event, sizeof(event), 1, recordFile);
+        }
+    }
+
+    /**
+     * Close() Flush And Close The Recording
+     */
+    void Close() {
+        if (recordFile != nullptr) {
+            fclose(recordFile);
+            recordFile = nullptr;
+        }
+    }
+};
+
+/**
+ * @class InputReplay
+ * @details Reads a recorded input stream back one event at a time
+ */
+class InputReplay {
+private:
+    FILE *replayFile = nullptr;
+    InputRecordHeader header;
+
+public:
+    InputReplay() {}
+
+    InputReplay(const InputReplay &) = delete;
+
+    InputReplay &operator=(const InputReplay &) = delete;
+
+    ~InputReplay() { Close(); }
+
+    /**
+     * Open() Open A Recording And Validate Its Header
+     *
+     * @param path Char Pointer File Path
+     * @return Boolean Condition
+     */
+    bool Open(const char *path) {
+        Close();
+        replayFile = fopen(path, "rb");
+        if (replayFile == nullptr) {
+            cout << "Input recording could not be opened: " << path << endl;
+            return false;
+        }
+        if (fread(&header, sizeof(header), 1, replayFile) != 1 || header.magic != INPUT_RECORD_MAGIC ||
+            header.version != INPUT_RECORD_VERSION) {
+            cout << "Not a RoadRealm input recording: " << path << endl;
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    bool IsOpen() const { return replayFile != nullptr; }
+
+    /**
+     * Header() Header Of The Open Recording
+     *
+     * @return InputRecordHeader
+     */
+    const InputRecordHeader &Header() const { return header; }
+
+    /**
+     * Next() Read The Next Event
+     *
+     * @param event InputEvent Output
+     * @return Boolean Condition, false once the recording is exhausted
+     */
+    bool Next(InputEvent &event) {
+        return replayFile != nullptr && fread(&event, sizeof(event), 1, replayFile) == 1;
+    }
+
+    /**
+     * Close() Close The Recording
+     */
+    void Close() {
+        if (replayFile != nullptr) {
+            fclose(replayFile);
+            replayFile = nullptr;
+        }
+    }
+};
+
+#endif //ROADREALM_INPUTEVENTS_H
@@ -0,0 +1,339 @@
+/**
+ * @file PathCodec.h
+ * @author Team 8: Edwin Kaburu, Vincent Marklynn, Yong Long Tan
+ * @date 10/19/2026
+ */
+
+#ifndef ROADREALM_PATHCODEC_H
+#define ROADREALM_PATHCODEC_H
+
+#include <cstdint>
+#include <iterator>
+#include <vector>
+#include "GameArena.h"
+
+using namespace std;
+
+// Longest Straight Stretch Held By A Single Code Byte
+#define PATH_MAX_RUN 64
+
+/**
+ * @struct PathCursor
+ * @details Bidirectional iterator over the cells of an encoded path, positions are decoded on the fly
+ */
+struct PathCursor {
+    using iterator_category = bidirectional_iterator_tag;
+    using value_type = PathCursor;
+    using difference_type = ptrdiff_t;
+    using pointer = const PathCursor *;
+    using reference = const PathCursor &;
+
+    const uint8_t *codes = nullptr;
+    uint16_t codeIndex = 0, cellIndex = 0, cellCount = 0;
+    uint8_t runStep = 0;
+    int16_t row = -1, col = -1;
+
+    /**
+     * CodeDirection() Direction Of A Code Byte
+     *
+     * @param code Byte Code
+     * @return Integer Direction, 0 right, 1 down, 2 left, 3 up
+     */
+    static int CodeDirection(uint8_t code) { return code >> 6; }
+
+    /**
+     * CodeRun() Number Of Steps Of A Code Byte
+     *
+     * @param code Byte Code
+     * @return Integer Steps
+     */
+    static int CodeRun(uint8_t code) { return (code & 0x3F) + 1; }
+
+    /**
+     * Step() Move A Position One Cell In A Direction
+     *
+     * @param direction Integer Direction
+     * @param sign Integer, 1 to follow the direction and -1 to reverse it
+     */
+    void Step(int direction, int sign) {
+        static const int rowStep[4] = {0, 1, 0, -1}, colStep[4] = {1, 0, -1, 0};
+        row = (int16_t) (row + sign * rowStep[direction]);
+        col = (int16_t) (col + sign * colStep[direction]);
+    }
+
+    /**
+     * Index() Index Of The Current Cell Within The Path
+     *
+     * @return Integer Index
+     */
+    int Index() const { return cellIndex; }
+
+    /**
+     * IsFirst() Validate If The Cursor Is On The First Cell
+     *
+     * @return Boolean Condition
+     */
+    bool IsFirst() const { return cellIndex == 0; }
+
+    /**
+     * IsLast() Validate If The Cursor Is On The Last Cell
+     *
+     * @return Boolean Condition
+     */
+    bool IsLast() const { return cellIndex + 1 == cellCount; }
+
+    /**
+     * operator++() Advance To The Next Cell, stepping past the last cell reaches the end cursor
+     */
+    PathCursor &operator++() {
+        if (!IsLast()) {
+            uint8_t code = codes[codeIndex];
+            Step(CodeDirection(code), 1);
+            if (++runStep == CodeRun(code)) {
+                codeIndex++;
+                runStep = 0;
+            }
+        }
+        cellIndex++;
+        return *this;
+    }
+
+    /**
+     * operator--() Return To The Previous Cell, stepping back from the end cursor reaches the last cell
+     */
+    PathCursor &operator--() {
+        if (cellIndex-- == cellCount) {
+            return *this;
+        }
+        if (runStep == 0) {
+            runStep = (uint8_t) CodeRun(codes[--codeIndex]);
+        }
+        runStep--;
+        Step(CodeDirection(codes[codeIndex]), -1);
+        return *this;
+    }
+
+    PathCursor operator++(int) {
+        PathCursor previous = *this;
+        ++*this;
+        return previous;
+    }
+
+    PathCursor operator--(int) {
+        PathCursor previous = *this;
+        --*this;
+        return previous;
+    }
+
+    const PathCursor &operator*() const { return *this; }
+
+    bool operator==(const PathCursor &other) const {
+        return codes == other.codes && cellIndex == other.cellIndex;
+    }
+
+    bool operator!=(const PathCursor &other) const { return !(*this == other); }
+};
+
+/**
+ * @struct PathView
+ * @details Non-owning view of an encoded path: its start and end cells followed by one byte per straight stretch, a
+ * 2-bit direction and a 6-bit run length. Views are cheap to copy and valid while the codes they point at are alive.
+ */
+struct PathView {
+    const uint8_t *codes = nullptr;
+    uint16_t codeCount = 0, cellCount = 0;
+    int16_t startRow = -1, startCol = -1, endRow = -1, endCol = -1;
+
+    bool empty() const { return cellCount == 0; }
+
+    size_t size() const { return cellCount; }
+
+    /**
+     * begin() Cursor On The First Cell
+     *
+     * @return PathCursor
+     */
+    PathCursor begin() const {
+        PathCursor cursor;
+        cursor.codes = codes;
+        cursor.cellCount = cellCount;
+        cursor.row = startRow;
+        cursor.col = startCol;
+        return cursor;
+    }
+
+    /**
+     * end() Cursor Past The Last Cell
+     *
+     * @return PathCursor
+     */
+    PathCursor end() const {
+        PathCursor cursor;
+        cursor.codes = codes;
+        cursor.codeIndex = codeCount;
+        cursor.cellIndex = cellCount;
+        cursor.cellCount = cellCount;
+        cursor.row = endRow;
+        cursor.col = endCol;
+        return cursor;
+    }
+
+    /**
+     * Last() Cursor On The Last Cell
+     *
+     * @return PathCursor
+     */
+    PathCursor Last() const {
+        PathCursor cursor = end();
+        return cellCount > 0 ? --cursor : cursor;
+    }
+
+    /**
+     * ForEachRun() Visit Every Straight Stretch With Its First And Last Cell
+     *
+     * @tparam F Visitor Type
+     * @param visit Visitor, called with (fromRow, fromCol, toRow, toCol, steps)
+     */
+    template<typename F>
+    void ForEachRun(F visit) const {
+        static const int rowStep[4] = {0, 1, 0, -1}, colStep[4] = {1, 0, -1, 0};
+        int row = startRow, col = startCol;
+        for (int i = 0; i < codeCount; i++) {
+            int direction = PathCursor::CodeDirection(codes[i]), steps = PathCursor::CodeRun(codes[i]);
+            int toRow = row + steps * rowStep[direction], toCol = col + steps * colStep[direction];
+            visit(row, col, toRow, toCol, steps);
+            row = toRow;
+            col = toCol;
+        }
+    }
+};
+
+/**
+ * @struct PackedPath
+ * @details Encoded path owning its codes, which are allocated once from the game arena, so it can only be moved
+ */
+struct PackedPath : public PathView {
+    /**
+     * PackedPath() Default Constructor For An Empty Path
+     */
+    PackedPath() {}
+
+    PackedPath(const PackedPath &) = delete;
+
+    PackedPath &operator=(const PackedPath &) = delete;
+
+    PackedPath(PackedPath &&other) noexcept { Take(other); }
+
+    PackedPath &operator=(PackedPath &&other) noexcept {
+        if (this != &other) {
+            Release();
+            Take(other);
+        }
+        return *this;
+    }
+
+    ~PackedPath() { Release(); }
+
+    /**
+     * Encode() Pack A Sequence Of 4-Connected Cells Into The Game Arena
+     *
+     * @tparam C Container Of Positions With Row And Col Members
+     * @param cells Position Collection
+     * @return PackedPath Encoded Path, empty if two consecutive cells are not adjacent
+     */
+    template<typename C>
+    static PackedPath Encode(const C &cells) {
+        PackedPath packed;
+        if (cells.empty()) {
+            return packed;
+        }
+
+        // Count Straight Stretches First, so the codes take one exact allocation
+        int codeCount = 0, prevDirection = -1, runLength = 0;
+        for (size_t i = 1; i < cells.size(); i++) {
+            int direction = Direction(cells[i].row - cells[i - 1].row, cells[i].col - cells[i - 1].col);
+            if (direction < 0) {
+                return packed;
+            }
+            if (direction != prevDirection || runLength == PATH_MAX_RUN) {
+                codeCount++;
+                runLength = 0;
+            }
+            prevDirection = direction;
+            runLength++;
+        }
+
+        packed.codeCount = (uint16_t) codeCount;
+        packed.cellCount = (uint16_t) cells.size();
+        packed.startRow = (int16_t) cells.front().row;
+        packed.startCol = (int16_t) cells.front().col;
+        packed.endRow = (int16_t) cells.back().row;
+        packed.endCol = (int16_t) cells.back().col;
+        uint8_t *writeCodes = nullptr;
+        if (codeCount > 0) {
+            writeCodes = (uint8_t *) GAME_ARENA.Resource()->allocate(codeCount, 1);
+            packed.codes = writeCodes;
+        }
+
+        int codeIndex = -1;
+        prevDirection = -1;
+        runLength = 0;
+        for (size_t i = 1; i < cells.size(); i++) {
+            int direction = Direction(cells[i].row - cells[i - 1].row, cells[i].col - cells[i - 1].col);
+            if (direction != prevDirection || runLength == PATH_MAX_RUN) {
+                codeIndex++;
+                runLength = 0;
+            }
+            prevDirection = direction;
+            runLength++;
+            writeCodes[codeIndex] = (uint8_t) ((direction << 6) | (runLength - 1));
+        }
+        return packed;
+    }
+
+    /**
+     * Direction() Direction Code Of A Single Step
+     *
+     * @param dRow Integer Row Change
+     * @param dCol Integer Column Change
+     * @return Integer Direction, -1 If The Cells Are Not Adjacent
+     */
+    static int Direction(int dRow, int dCol) {
+        if (dRow == 0 && dCol == 1) return 0;
+        if (dRow == 1 && dCol == 0) return 1;
+        if (dRow == 0 && dCol == -1) return 2;
+        if (dRow == -1 && dCol == 0) return 3;
+        return -1;
+    }
+
+    /**
+     * Release() Return The Codes To The Game Arena
+     */
+    void Release() {
+        if (codes != nullptr) {
+            GAME_ARENA.Resource()->deallocate((void *) codes, codeCount, 1);
+        }
+        codes = nullptr;
+        codeCount = cellCount = 0;
+        startRow = startCol = endRow = endCol = -1;
+    }
+
+    /**
+     * Take() Steal The Codes Of Another Path
+     *
+     * @param other PackedPath
+     */
+    void Take(PackedPath &other) {
+        codes = other.codes;
+        codeCount = other.codeCount;
+        cellCount = other.cellCount;
+        startRow = other.startRow;
+        startCol = other.startCol;
+        endRow = other.endRow;
+        endCol = other.endCol;
+        other.codes = nullptr;
+        other.codeCount = other.cellCount = 0;
+    }
+};
+
+#endif //ROADREALM_PATHCODEC_H
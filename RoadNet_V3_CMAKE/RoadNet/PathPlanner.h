@@ -0,0 +1,409 @@
+/**
+ * @file PathPlanner.h
+ * @author Team 8: Edwin Kaburu, Vincent Marklynn, Yong Long Tan
+ * @date 10/19/2026
+ */
+
+#ifndef ROADREALM_PATHPLANNER_H
+#define ROADREALM_PATHPLANNER_H
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "RoadNetShared.h"
+
+// Cells Expanded Per Update At Most, about half a millisecond on a 1024x1024 grid; longer repairs carry over
+#define PLANNER_EXPANSION_BUDGET 1024
+
+/**
+ * @class DStarLitePlanner
+ * @details Incremental D* Lite planner over a 4-connected grid. The search runs backwards from a fixed goal, so the
+ * start (the dragged cursor cell) may move and cells may open or close while most of the search tree is reused.
+ */
+class DStarLitePlanner {
+private:
+    /**
+     * @struct PlannerKey
+     * @details Two-Part Priority Key Of A Cell In The Open List
+     */
+    struct PlannerKey {
+        float primary = 0, secondary = 0;
+
+        bool operator<(const PlannerKey &other) const {
+            return primary < other.primary || (primary == other.primary && secondary < other.secondary);
+        }
+
+        bool operator==(const PlannerKey &other) const {
+            return primary == other.primary && secondary == other.secondary;
+        }
+    };
+
+    /**
+     * @struct OpenEntry
+     * @details Heap Entry, stale entries are skipped lazily when their key no longer matches the cell's key
+     */
+    struct OpenEntry {
+        PlannerKey key;
+        int cellIndex;
+
+        bool operator<(const OpenEntry &other) const { return other.key < key; }
+    };
+
+    const float INF_COST = numeric_limits<float>::infinity();
+
+    int gridRows = 0, gridCols = 0;
+    int startIndex = -1, goalIndex = -1;
+    float keyModifier = 0;
+    bool plannerActive = false, plannerSettled = false;
+
+    vector<float> gValues, rhsValues;
+    vector<PlannerKey> openKeys;
+    vector<uint8_t> inOpen, blockedCells;
+    vector<OpenEntry> openHeap;
+
+    /**
+     * Heuristic() Manhattan Distance From The Start To A Cell
+     *
+     * @param cellIndex Integer Cell Index
+     * @return Float Distance
+     */
+    float Heuristic(int cellIndex) const {
+        return (float) (abs(cellIndex / gridCols - startIndex / gridCols) +
+                        abs(cellIndex % gridCols - startIndex % gridCols));
+    }
+
+    /**
+     * IsPassable() Validate If A Cell Can Be Traversed, the start and goal are always passable
+     *
+     * @param cellIndex Integer Cell Index
+     * @return Boolean Condition
+     */
+    bool IsPassable(int cellIndex) const {
+        return cellIndex == startIndex || cellIndex == goalIndex || !blockedCells[cellIndex];
+    }
+
+    /**
+     * EdgeCost() Cost Of Moving Between Two Adjacent Cells
+     *
+     * @param fromIndex Integer Cell Index
+     * @param toIndex Integer Cell Index
+     * @return Float Cost
+     */
+    float EdgeCost(int fromIndex, int toIndex) const {
+        return IsPassable(fromIndex) && IsPassable(toIndex) ? 1.0f : INF_COST;
+    }
+
+    /**
+     * Neighbors() Gather The 4-Connected Neighbours Of A Cell
+     *
+     * @param cellIndex Integer Cell Index
+     * @param neighbors Integer Array Output
+     * @return Integer Number Of Neighbours
+     */
+    int Neighbors(int cellIndex, int neighbors[4]) const {
+        int row = cellIndex / gridCols, col = cellIndex % gridCols, count = 0;
+        if (row > 0) neighbors[count++] = cellIndex - gridCols;
+        if (row < gridRows - 1) neighbors[count++] = cellIndex + gridCols;
+        if (col > 0) neighbors[count++] = cellIndex - 1;
+        if (col < gridCols - 1) neighbors[count++] = cellIndex + 1;
+        return count;
+    }
+
+    /**
+     * CalculateKey() Priority Key Of A Cell
+     *
+     * @param cellIndex Integer Cell Index
+     * @return PlannerKey Key
+     */
+    PlannerKey CalculateKey(int cellIndex) const {
+        float best = min(gValues[cellIndex], rhsValues[cellIndex]);
+        return {best + Heuristic(cellIndex) + keyModifier, best};
+    }
+
+    /**
+     * PushOpen() Insert Or Re-Key A Cell In The Open List
+     *
+     * @param cellIndex Integer Cell Index
+     */
+    void PushOpen(int cellIndex) {
+        PlannerKey key = CalculateKey(cellIndex);
+        openKeys[cellIndex] = key;
+        inOpen[cellIndex] = 1;
+        openHeap.push_back({key, cellIndex});
+        push_heap(openHeap.begin(), openHeap.end());
+    }
+
+    /**
+     * DiscardStaleTop() Drop Heap Entries Which No Longer Represent A Cell In The Open List
+     */
+    void DiscardStaleTop() {
+        while (!openHeap.empty()) {
+            const OpenEntry &top = openHeap.front();
+            if (inOpen[top.cellIndex] && openKeys[top.cellIndex] == top.key) {
+                return;
+            }
+            pop_heap(openHeap.begin(), openHeap.end());
+            openHeap.pop_back();
+        }
+    }
+
+    /**
+     * UpdateVertex() Recompute The One-Step Lookahead Value Of A Cell And Refresh Its Open List Membership
+     *
+     * @param cellIndex Integer Cell Index
+     */
+    void UpdateVertex(int cellIndex) {
+        if (cellIndex != goalIndex) {
+            int neighbors[4];
+            int count = Neighbors(cellIndex, neighbors);
+            float best = INF_COST;
+            for (int i = 0; i < count; i++) {
+                best = min(best, EdgeCost(cellIndex, neighbors[i]) + gValues[neighbors[i]]);
+            }
+            rhsValues[cellIndex] = best;
+        }
+        inOpen[cellIndex] = 0;
+        if (gValues[cellIndex] != rhsValues[cellIndex]) {
+            PushOpen(cellIndex);
+        }
+    }
+
+    /**
+     * UpdateAround() Refresh A Cell And Its Neighbours After Its Traversability Changed
+     *
+     * @param cellIndex Integer Cell Index
+     */
+    void UpdateAround(int cellIndex) {
+        int neighbors[4];
+        int count = Neighbors(cellIndex, neighbors);
+        UpdateVertex(cellIndex);
+        for (int i = 0; i < count; i++) {
+            UpdateVertex(neighbors[i]);
+        }
+    }
+
+    /**
+     * StartInconsistent() Validate If The Start Still Needs Expansions Before Its Value Is Exact, call with a clean
+     * heap top
+     *
+     * @return Boolean Condition
+     */
+    bool StartInconsistent() const {
+        return !openHeap.empty() &&
+               (openHeap.front().key < CalculateKey(startIndex) || rhsValues[startIndex] != gValues[startIndex]);
+    }
+
+    /**
+     * ToIndex() Map A Node Position To A Cell Index
+     *
+     * @param pos NodePosition
+     * @return Integer Cell Index, -1 If Out Of Bounds
+     */
+    int ToIndex(NodePosition pos) const {
+        if (pos.row < 0 || pos.row >= gridRows || pos.col < 0 || pos.col >= gridCols) {
+            return -1;
+        }
+        return pos.row * gridCols + pos.col;
+    }
+
+public:
+    /**
+     * DStarLitePlanner() Default Constructor For A Planner Instance
+     */
+    DStarLitePlanner() {}
+
+    /**
+     * Begin() Start A New Search Against A Snapshot Of Closed Cells
+     *
+     * @param rows Integer Grid Rows
+     * @param cols Integer Grid Columns
+     * @param start NodePosition Start Cell
+     * @param goal NodePosition Goal Cell
+     * @param blocked Byte Collection, one entry per cell, non-zero when closed
+     * @return Boolean Condition
+     */
+    bool Begin(int rows, int cols, NodePosition start, NodePosition goal, const vector<uint8_t> &blocked) {
+        gridRows = rows;
+        gridCols = cols;
+        startIndex = ToIndex(start);
+        goalIndex = ToIndex(goal);
+        plannerActive = startIndex >= 0 && goalIndex >= 0 && (int) blocked.size() == rows * cols;
+        plannerSettled = false;
+        if (!plannerActive) {
+            return false;
+        }
+
+        size_t cellCount = (size_t) rows * cols;
+        gValues.assign(cellCount, INF_COST);
+        rhsValues.assign(cellCount, INF_COST);
+        openKeys.assign(cellCount, {});
+        inOpen.assign(cellCount, 0);
+        blockedCells = blocked;
+        openHeap.clear();
+        openHeap.reserve(cellCount);
+
+        keyModifier = 0;
+        rhsValues[goalIndex] = 0;
+        PushOpen(goalIndex);
+        return true;
+    }
+
+    /**
+     * Reserve() Size The Search Memory For A Grid Up Front, so no drag on a grid that size allocates
+     *
+     * @param cellCount Integer Grid Cells
+     */
+    void Reserve(int cellCount) {
+        gValues.reserve(cellCount);
+        rhsValues.reserve(cellCount);
+        openKeys.reserve(cellCount);
+        inOpen.reserve(cellCount);
+        blockedCells.reserve(cellCount);
+        openHeap.reserve(cellCount);
+    }
+
+    /**
+     * End() Stop Planning, memory is kept for the next drag
+     */
+    void End() {
+        plannerActive = false;
+        plannerSettled = false;
+        openHeap.clear();
+    }
+
+    /**
+     * IsActive() Validate If A Search Is In Progress
+     *
+     * @return Boolean Condition
+     */
+    bool IsActive() const { return plannerActive; }
+
+    /**
+     * IsSettled() Validate If The Last ComputeShortestPath() Finished Its Repair, so the start's path is exact
+     *
+     * @return Boolean Condition
+     */
+    bool IsSettled() const { return plannerSettled; }
+
+    /**
+     * SetBlocked() Open Or Close A Cell, only the affected part of the search tree is repaired
+     *
+     * @param cell NodePosition
+     * @param isBlocked Boolean Condition
+     */
+    void SetBlocked(NodePosition cell, bool isBlocked) {
+        int cellIndex = ToIndex(cell);
+        if (!plannerActive || cellIndex < 0 || blockedCells[cellIndex] == (uint8_t) isBlocked) {
+            return;
+        }
+        blockedCells[cellIndex] = isBlocked;
+        plannerSettled = false;
+        UpdateAround(cellIndex);
+    }
+
+    /**
+     * MoveStart() Move The Start Cell, the heuristic drift is folded into the key modifier
+     *
+     * @param start NodePosition
+     * @return Boolean Condition
+     */
+    bool MoveStart(NodePosition start) {
+        int newIndex = ToIndex(start);
+        if (!plannerActive || newIndex < 0) {
+            return false;
+        }
+        if (newIndex == startIndex) {
+            return true;
+        }
+        int previousIndex = startIndex;
+        keyModifier += Heuristic(newIndex);
+        startIndex = newIndex;
+        plannerSettled = false;
+        // Passability of both start cells depends on which one is the start
+        UpdateAround(previousIndex);
+        UpdateAround(newIndex);
+        return true;
+    }
+
+    /**
+     * ComputeShortestPath() Expand Inconsistent Cells Until The Start Is Consistent, or the budget runs out; the open
+     * list keeps the rest of the repair for the next call
+     *
+     * @param maxExpansions Integer Most Cells To Expand
+     * @return Integer Number Of Expanded Cells
+     */
+    int ComputeShortestPath(int maxExpansions = numeric_limits<int>::max()) {
+        int expanded = 0;
+        if (!plannerActive) {
+            return expanded;
+        }
+        DiscardStaleTop();
+        while (expanded < maxExpansions && StartInconsistent()) {
+            OpenEntry top = openHeap.front();
+            pop_heap(openHeap.begin(), openHeap.end());
+            openHeap.pop_back();
+            int cellIndex = top.cellIndex;
+            inOpen[cellIndex] = 0;
+            expanded++;
+
+            PlannerKey newKey = CalculateKey(cellIndex);
+            int neighbors[4];
+            int count = Neighbors(cellIndex, neighbors);
+
+            if (top.key < newKey) {
+                PushOpen(cellIndex);
+            } else if (gValues[cellIndex] > rhsValues[cellIndex]) {
+                gValues[cellIndex] = rhsValues[cellIndex];
+                for (int i = 0; i < count; i++) {
+                    UpdateVertex(neighbors[i]);
+                }
+            } else {
+                gValues[cellIndex] = INF_COST;
+                UpdateVertex(cellIndex);
+                for (int i = 0; i < count; i++) {
+                    UpdateVertex(neighbors[i]);
+                }
+            }
+            DiscardStaleTop();
+        }
+        plannerSettled = !StartInconsistent();
+        return expanded;
+    }
+
+    /**
+     * ExtractPath() Follow The Cheapest Successors From The Start To The Goal
+     *
+     * @param path NodePosition Collection Output, cleared first
+     * @return Boolean Condition, false if the goal is unreachable or the repair has not settled
+     */
+    bool ExtractPath(vector<NodePosition> &path) const {
+        path.clear();
+        if (!plannerSettled || gValues[startIndex] == INF_COST) {
+            return false;
+        }
+        int cellIndex = startIndex;
+        path.push_back(NodePosition(cellIndex / gridCols, cellIndex % gridCols));
+        while (cellIndex != goalIndex && (int) path.size() <= gridRows * gridCols) {
+            int neighbors[4];
+            int count = Neighbors(cellIndex, neighbors), next = -1;
+            float best = INF_COST;
+            for (int i = 0; i < count; i++) {
+                float cost = EdgeCost(cellIndex, neighbors[i]) + gValues[neighbors[i]];
+                if (cost < best) {
+                    best = cost;
+                    next = neighbors[i];
+                }
+            }
+            if (next < 0) {
+                path.clear();
+                return false;
+            }
+            cellIndex = next;
+            path.push_back(NodePosition(cellIndex / gridCols, cellIndex % gridCols));
+        }
+        return cellIndex == goalIndex;
+    }
+};
+
+#endif //ROADREALM_PATHPLANNER_H
@@ -0,0 +1,270 @@
+/**
+ * @file RecordStore.h
+ * @author Team 8: Edwin Kaburu, Vincent Marklynn, Yong Long Tan
+ * @date 10/19/2026
+ */
+
+#ifndef ROADREALM_RECORDSTORE_H
+#define ROADREALM_RECORDSTORE_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "FrameProfiler.h"
+
+using namespace std;
+
+// 'RRRL' Read As A Little-Endian Integer
+#define RECORD_LOG_MAGIC 0x4C525252u
+#define RECORD_LOG_VERSION 1
+// Durations Kept On The Leaderboard
+#define RECORD_TOP_N 10
+// Log Entries Allowed Before The Writer Rewrites It Down To The Leaderboard
+#define RECORD_COMPACT_THRESHOLD (4 * RECORD_TOP_N)
+
+/**
+ * @struct RecordEntry
+ * @details One Finished Game, stored as raw bytes in the record log
+ */
+struct RecordEntry {
+    double seconds = 0;
+    // Unix Time The Game Ended, 0 for records migrated from the old text file
+    int64_t endedAt = 0;
+};
+
+static_assert(sizeof(RecordEntry) == 16, "RecordEntry is stored as raw bytes");
+
+/**
+ * @struct RecordLogHeader
+ * @details Leading Block Of The Record Log, followed by RecordEntry values appended one per game
+ */
+struct RecordLogHeader {
+    uint32_t magic = RECORD_LOG_MAGIC;
+    uint32_t version = RECORD_LOG_VERSION;
+};
+
+/**
+ * @class RecordStore
+ * @details Longest-survival leaderboard read from storage once and served from memory. New games are appended to a
+ * binary log by a background writer, which also compacts the log through a temporary file and an atomic rename, so the
+ * game never waits on the disk. The leaderboard itself belongs to the simulation thread.
+ */
+class RecordStore {
+private:
+    string logPath, legacyPath;
+    vector<RecordEntry> leaderboard;
+
+    thread writer;
+    mutex writerLock;
+    condition_variable writerWake;
+    vector<RecordEntry> pending;
+    bool stopping = false;
+    // Writer Thread Only
+    int logEntries = 0;
+
+    /**
+     * Insert() Place An Entry On The Leaderboard, longest first
+     *
+     * @param entry RecordEntry
+     */
+    void Insert(const RecordEntry &entry) {
+        auto position = upper_bound(leaderboard.begin(), leaderboard.end(), entry,
+                                    [](const RecordEntry &a, const RecordEntry &b) { return a.seconds > b.seconds; });
+        leaderboard.insert(position, entry);
+        if (leaderboard.size() > RECORD_TOP_N) {
+            leaderboard.pop_back();
+        }
+    }
+
+    /**
+     * ReadLog() Load Every Entry Of The Log, ignoring a torn trailing entry
+     *
+     * @return Boolean Condition, false if the log is missing or not a record log
+     */
+    bool ReadLog() {
+        PROFILE_ZONE("ReadLog");
+        FILE *file = fopen(logPath.c_str(), "rb");
+        if (file == nullptr) {
+            return false;
+        }
+        RecordLogHeader header;
+        bool valid = fread(&header, sizeof(header), 1, file) == 1 && header.magic == RECORD_LOG_MAGIC &&
+                     header.version == RECORD_LOG_VERSION;
+        RecordEntry entry;
+        while (valid && fread(&entry, sizeof(entry), 1, file) == 1) {
+            Insert(entry);
+            logEntries++;
+        }
+        // A Write Cut Short Leaves A Partial Entry, rewriting realigns the log before anything is appended
+        bool torn = valid && ftell(file) != (long) (sizeof(header) + logEntries * sizeof(RecordEntry));
+        fclose(file);
+        if (!valid) {
+            cout << "Ignoring unreadable record log: " << logPath << endl;
+        } else if (torn) {
+            RewriteLog(leaderboard);
+        }
+        return valid;
+    }
+
+    /**
+     * RewriteLog() Replace The Log With Just The Leaderboard, via a temporary file and an atomic rename
+     *
+     * @param entries RecordEntry Collection To Keep
+     */
+    void RewriteLog(const vector<RecordEntry> &entries) {
+        PROFILE_ZONE("RewriteLog");
+        string temporaryPath = logPath + ".tmp";
+        FILE *file = fopen(temporaryPath.c_str(), "wb");
+        if (file == nullptr) {
+            cout << "Record log could not be written: " << temporaryPath << endl;
+            return;
+        }
+        RecordLogHeader header;
+        bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                       fwrite(entries.data(), sizeof(RecordEntry), entries.size(), file) == entries.size();
+        written = fclose(file) == 0 && written;
+        error_code error;
+        if (written) {
+            filesystem::rename(temporaryPath, logPath, error);
+        }
+        if (!written || error) {
+            cout << "Record log could not be replaced: " << logPath << endl;
+            filesystem::remove(temporaryPath, error);
+            return;
+        }
+        logEntries = (int) entries.size();
+    }
+
+    /**
+     * WriterLoop() Append Pending Entries Until Stopped, compacting when the log grows long
+     *
+     * @param board RecordEntry Collection, the leaderboard as loaded, kept in step for compaction
+     */
+    void WriterLoop(vector<RecordEntry> board) {
+        PROFILE_THREAD("RecordWriter");
+        // Swapped Back And Forth With Pending, so neither side loses its capacity
+        vector<RecordEntry> batch;
+        batch.reserve(RECORD_TOP_N);
+        unique_lock<mutex> lock(writerLock);
+        while (true) {
+            writerWake.wait(lock, [this] { return stopping || !pending.empty(); });
+            if (pending.empty()) {
+                return;
+            }
+            batch.clear();
+            batch.swap(pending);
+            lock.unlock();
+
+            {
+                PROFILE_ZONE("AppendLog");
+                FILE *file = fopen(logPath.c_str(), "ab");
+                if (file != nullptr) {
+                    fwrite(batch.data(), sizeof(RecordEntry), batch.size(), file);
+                    fclose(file);
+                    logEntries += (int) batch.size();
+                } else {
+                    cout << "Record log could not be appended: " << logPath << endl;
+                }
+            }
+            board.insert(board.end(), batch.begin(), batch.end());
+            sort(board.begin(), board.end(),
+                 [](const RecordEntry &a, const RecordEntry &b) { return a.seconds > b.seconds; });
+            board.resize(min<size_t>(board.size(), RECORD_TOP_N));
+            if (logEntries > RECORD_COMPACT_THRESHOLD) {
+                RewriteLog(board);
+            }
+            lock.lock();
+        }
+    }
+
+public:
+    RecordStore(string logPath, string legacyPath) : logPath(move(logPath)), legacyPath(move(legacyPath)) {
+        // Room For The Entry Inserted Before The Last Is Dropped, so finishing a game does not allocate
+        leaderboard.reserve(RECORD_TOP_N + 1);
+        pending.reserve(RECORD_TOP_N);
+    }
+
+    RecordStore(const RecordStore &) = delete;
+
+    RecordStore &operator=(const RecordStore &) = delete;
+
+    ~RecordStore() { Stop(); }
+
+    /**
+     * Load() Read Storage Once And Start The Writer, call before the simulation starts
+     */
+    void Load() {
+        if (writer.joinable()) {
+            return;
+        }
+        if (!ReadLog()) {
+            // First Run With The Log, carry the old single best time over
+            ifstream legacy(legacyPath);
+            RecordEntry entry;
+            if (legacy >> entry.seconds && entry.seconds > 0) {
+                Insert(entry);
+            }
+            RewriteLog(leaderboard);
+        }
+        stopping = false;
+        writer = thread(&RecordStore::WriterLoop, this, leaderboard);
+    }
+
+    /**
+     * Add() Record A Finished Game, the disk write happens on the writer thread
+     *
+     * @param seconds Double Game Duration
+     */
+    void Add(double seconds) {
+        RecordEntry entry;
+        entry.seconds = seconds;
+        entry.endedAt = (int64_t) time(nullptr);
+        Insert(entry);
+        {
+            lock_guard<mutex> lock(writerLock);
+            pending.push_back(entry);
+        }
+        writerWake.notify_one();
+    }
+
+    /**
+     * Best() Longest Game On Record
+     *
+     * @return Double Seconds, 0 when nothing is recorded
+     */
+    double Best() const { return leaderboard.empty() ? 0.0 : leaderboard.front().seconds; }
+
+    /**
+     * Leaderboard() Recorded Games, longest first
+     *
+     * @return RecordEntry Collection, at most RECORD_TOP_N
+     */
+    const vector<RecordEntry> &Leaderboard() const { return leaderboard; }
+
+    /**
+     * Stop() Flush Pending Entries And Join The Writer
+     */
+    void Stop() {
+        {
+            lock_guard<mutex> lock(writerLock);
+            stopping = true;
+        }
+        writerWake.notify_all();
+        if (writer.joinable()) {
+            writer.join();
+        }
+    }
+};
+
+RecordStore RECORDS("RoadNet/Storage/records.log", "RoadNet/Storage/best_record.txt");
+
+#endif //ROADREALM_RECORDSTORE_H
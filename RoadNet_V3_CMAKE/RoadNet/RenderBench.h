@@ -0,0 +1,222 @@
+/**
+ * @file RenderBench.h
+ * @author Team 8: Edwin Kaburu, Vincent Marklynn, Yong Long Tan
+ * @date 10/19/2026
+ */
+
+#ifndef ROADREALM_RENDERBENCH_H
+#define ROADREALM_RENDERBENCH_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "GLState.h"
+#include "NullGL.h"
+#include "StreamBuffer.h"
+
+using namespace std;
+
+// Per-Frame Metrics Of A Null GL Run, one row per frame, to diff between builds
+#define RENDER_BENCH_CSV "RoadNet/Storage/render_bench.csv"
+// GL Entry Points Listed In The Summary, most called first
+#define RENDER_BENCH_TOP_CALLS 12
+
+/**
+ * @struct RenderFrameMetrics
+ * @details What One Frame Asked Of The Driver, and the CPU time it took to ask
+ */
+struct RenderFrameMetrics {
+    double cpuMs = 0;
+    NullGLCounters gl;
+    // Vertex Bytes Written Into The Stream Ring, which the driver never sees as calls
+    size_t streamBytes = 0;
+    // Calls GLState Found Redundant And Skipped
+    int glStateSkipped = 0;
+};
+
+/**
+ * @class RenderBench
+ * @details Records RenderFrameMetrics for each frame drawn on the null GL driver (NullGL.h), then summarises them.
+ * The headless run ticks the simulation once per frame, so draws, uploads and uniform sets per frame are
+ * deterministic for a given replay (with the UI atlas bundle built, so no image is decoded in the background), and a
+ * change in them between builds is a change in what the renderer submits, on any machine, GPU or not.
+ */
+class RenderBench {
+private:
+    using BenchClock = chrono::steady_clock;
+
+    vector<RenderFrameMetrics> frames;
+    BenchClock::time_point frameStart;
+    size_t streamBytesAtStart = 0;
+
+    /**
+     * @struct Column
+     * @details One Reported Metric, its name and how to read it from a frame
+     */
+    struct Column {
+        const char *name;
+
+        double (*value)(const RenderFrameMetrics &);
+    };
+
+    /**
+     * Columns() The Reported Metrics, in CSV column order
+     *
+     * @param count Integer Set To The Number Of Columns
+     * @return Column Pointer
+     */
+    static const Column *Columns(int &count) {
+        static const Column columns[] = {
+                {"cpu_ms",          [](const RenderFrameMetrics &m) { return m.cpuMs; }},
+                {"gl_calls",        [](const RenderFrameMetrics &m) { return (double) m.gl.calls; }},
+                {"draws",           [](const RenderFrameMetrics &m) { return (double) m.gl.draws; }},
+                {"vertices",        [](const RenderFrameMetrics &m) { return (double) m.gl.vertices; }},
+                {"buffer_uploads",  [](const RenderFrameMetrics &m) { return (double) m.gl.bufferUploads; }},
+                {"buffer_bytes",    [](const RenderFrameMetrics &m) { return (double) m.gl.bufferBytes; }},
+                {"stream_bytes",    [](const RenderFrameMetrics &m) { return (double) m.streamBytes; }},
+                {"texture_uploads", [](const RenderFrameMetrics &m) { return (double) m.gl.textureUploads; }},
+                {"texture_bytes",   [](const RenderFrameMetrics &m) { return (double) m.gl.textureBytes; }},
+                {"uniforms",        [](const RenderFrameMetrics &m) { return (double) m.gl.uniforms; }},
+                {"state_changes",   [](const RenderFrameMetrics &m) { return (double) m.gl.stateChanges; }},
+                {"queries",         [](const RenderFrameMetrics &m) { return (double) m.gl.queries; }},
+                {"skipped",         [](const RenderFrameMetrics &m) { return (double) m.glStateSkipped; }}};
+        count = (int) (sizeof(columns) / sizeof(columns[0]));
+        return columns;
+    }
+
+public:
+    /**
+     * BeginFrame() Zero The Driver Counters, call right before Display
+     */
+    void BeginFrame() {
+        ResetNullGLStats();
+        ResetGLStats();
+        streamBytesAtStart = VertexStream().BytesMapped();
+        frameStart = BenchClock::now();
+    }
+
+    /**
+     * EndFrame() Record The Frame, call after VertexStream().EndFrame() so its fence is counted too
+     */
+    void EndFrame() {
+        RenderFrameMetrics metrics;
+        metrics.cpuMs = chrono::duration<double, milli>(BenchClock::now() - frameStart).count();
+        metrics.gl = NullGLStats();
+        metrics.streamBytes = VertexStream().BytesMapped() - streamBytesAtStart;
+        metrics.glStateSkipped = GLStats().Skipped();
+        frames.push_back(metrics);
+    }
+
+    /**
+     * PrintSummary() Mean And Worst Frame Of Each Metric, then the most called entry points
+     *
+     * @param out File Pointer
+     */
+    void PrintSummary(FILE *out) const {
+        if (frames.empty()) {
+            return;
+        }
+        int nColumns;
+        const Column *columns = Columns(nColumns);
+        fprintf(out, "%-16s %14s %14s   (per frame over %d frames)\n", "metric", "mean", "max", (int) frames.size());
+        for (int c = 0; c < nColumns; c++) {
+            double sum = 0, most = 0;
+            for (const RenderFrameMetrics &frame: frames) {
+                double value = columns[c].value(frame);
+                sum += value;
+                most = max(most, value);
+            }
+            fprintf(out, "%-16s %14.3f %14.3f\n", columns[c].name, sum / (double) frames.size(), most);
+        }
+
+        // Entry Point Counts Run From Driver Load, so startup uploads are included
+        const NullGLCall *calls;
+        int nCalls = NullGLCalls(&calls);
+        vector<NullGLCall> sorted(calls, calls + nCalls);
+        sort(sorted.begin(), sorted.end(), [](const NullGLCall &a, const NullGLCall &b) { return a.count > b.count; });
+        fprintf(out, "\n%-36s %10s\n", "gl entry point", "calls");
+        for (int i = 0; i < (int) sorted.size() && i < RENDER_BENCH_TOP_CALLS && sorted[i].count > 0; i++) {
+            fprintf(out, "%-36s %10d\n", sorted[i].name, sorted[i].count);
+        }
+    }
+
+    /**
+     * ExportCsv() Write Every Recorded Frame
+     *
+     * @param path Char Pointer File Path
+     * @return Boolean Condition
+     */
+    bool ExportCsv(const char *path) const {
+        FILE *file = fopen(path, "w");
+        if (file == nullptr) {
+            return false;
+        }
+        int nColumns;
+        const Column *columns = Columns(nColumns);
+        fprintf(file, "frame");
+        for (int c = 0; c < nColumns; c++) {
+            fprintf(file, ",%s", columns[c].name);
+        }
+        fprintf(file, "\n");
+        for (size_t i = 0; i < frames.size(); i++) {
+            fprintf(file, "%u", (unsigned) i);
+            for (int c = 0; c < nColumns; c++) {
+                fprintf(file, ",%.6g", columns[c].value(frames[i]));
+            }
+            fprintf(file, "\n");
+        }
+        fclose(file);
+        return true;
+    }
+
+    /**
+     * CheckMaximums() Compare The Worst Frame Of Each Metric Against Checked-In Maximums
+     *
+     * @param path Char Pointer File Path, one "metric maximum" pair per line, lines starting with # are comments
+     * @param out File Pointer, for every metric over its maximum
+     * @return Boolean Condition, false if a metric passed its maximum or the file could not be read
+     */
+    bool CheckMaximums(const char *path, FILE *out) const {
+        FILE *file = fopen(path, "r");
+        if (file == nullptr) {
+            fprintf(out, "cannot read frame maximums from %s\n", path);
+            return false;
+        }
+        int nColumns;
+        const Column *columns = Columns(nColumns);
+        bool ok = true;
+        int checked = 0;
+        char line[256], name[64];
+        double limit;
+        while (fgets(line, sizeof(line), file) != nullptr) {
+            if (line[0] == '#' || sscanf(line, "%63s %lf", name, &limit) != 2) {
+                continue;
+            }
+            int c = 0;
+            while (c < nColumns && strcmp(columns[c].name, name) != 0) {
+                c++;
+            }
+            if (c == nColumns) {
+                fprintf(out, "unknown metric %s in %s\n", name, path);
+                ok = false;
+                continue;
+            }
+            double most = 0;
+            for (const RenderFrameMetrics &frame: frames) {
+                most = max(most, columns[c].value(frame));
+            }
+            if (most > limit) {
+                fprintf(out, "%s reached %.0f per frame, over the maximum of %.0f\n", name, most, limit);
+                ok = false;
+            }
+            checked++;
+        }
+        fclose(file);
+        fprintf(out, "%d frame maximums from %s %s\n", checked, path, ok ? "held" : "were exceeded");
+        return ok;
+    }
+};
+
+#endif //ROADREALM_RENDERBENCH_H
@@ -0,0 +1,276 @@
+/**
+ * @file RenderSnapshot.h
+ * @author Team 8: Edwin Kaburu, Vincent Marklynn, Yong Long Tan
+ * @date 10/19/2026
+ */
+
+#ifndef ROADREALM_RENDERSNAPSHOT_H
+#define ROADREALM_RENDERSNAPSHOT_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include "Grid.h"
+#include "GridRenderer.h"
+#include "RunnerPaths.h"
+#include "Traffic.h"
+
+// Most Runner Roads The Grid Holds, each links a house and a factory cell of its own
+#define SNAPSHOT_MAX_RUNNERS (NROWS * NCOLS / 2)
+// Most Vehicles In Traffic Mode, a full load on every runner road
+#define SNAPSHOT_MAX_TRAFFIC_DOTS (SNAPSHOT_MAX_RUNNERS * TRAFFIC_MAX_AGENTS_PER_ROAD)
+
+/**
+ * @struct CellSnapshot
+ * @details Drawable State Of A Grid Node
+ */
+struct CellSnapshot {
+    vec3 color = WHITE;
+    vec3 overlayColor = WHITE;
+    NodeStates state = OPEN;
+};
+
+/**
+ * @struct DepotSnapshot
+ * @details House Or Factory Marker With Its Pulse Diameter For This Frame
+ */
+struct DepotSnapshot {
+    int cellIndex = 0;
+    float diameter = 0;
+};
+
+/**
+ * @struct RunnerSnapshot
+ * @details Runner Road And Position, its path codes are copied into the snapshot
+ */
+struct RunnerSnapshot {
+    PathView path;
+    uint32_t pathId = 0;
+    uint32_t codeOffset = 0;
+    float t = 0;
+    vec3 color;
+};
+
+/**
+ * @struct RenderSnapshot
+ * @details Everything The Renderer Needs For One Frame. Filled by the simulation and never touched by it again until
+ * the renderer has moved on to a newer snapshot. Containers keep their capacity, so steady frames do not allocate.
+ */
+struct RenderSnapshot {
+    ApplicationStates appState = STARTING_MENU;
+    bool paused = false, gameOver = false, drawBorders = false, trafficMode = false;
+    float fontScale = 10.0f, maxDiameter = 0;
+    double bestRecord = 0;
+
+    // Grid Revision The Cells Were Last Synchronised To
+    uint32_t gridRevision = 0;
+    array<CellSnapshot, NROWS * NCOLS> cells;
+    vector<DepotSnapshot> depots;
+
+    vector<RunnerSnapshot> runners;
+    vector<uint8_t> runnerCodes;
+    vector<NodePosition> previewPath;
+    vec3 previewColor;
+    vector<TrafficDot> trafficDots;
+
+    InfoPanel labels;
+
+    /**
+     * RenderSnapshot() Default Constructor, with room for the most the grid can hold so filling never reallocates:
+     * a depot or road cell on every cell, no more than one code per road cell, and a full load of traffic
+     */
+    RenderSnapshot() {
+        depots.reserve(NROWS * NCOLS);
+        runners.reserve(SNAPSHOT_MAX_RUNNERS);
+        runnerCodes.reserve(NROWS * NCOLS);
+        previewPath.reserve(NROWS * NCOLS);
+        trafficDots.reserve(SNAPSHOT_MAX_TRAFFIC_DOTS);
+    }
+
+    /**
+     * SyncCells() Copy Nodes Changed Since This Snapshot Was Last Filled
+     *
+     * @param gridPrimitive GridPrimitive
+     */
+    void SyncCells(const GridPrimitive &gridPrimitive) {
+        gridPrimitive.ForEachChangedNode(gridRevision, [&](int nodeIndex, const Node &node) {
+            CellSnapshot &cell = cells[nodeIndex];
+            cell.color = node.color;
+            cell.overlayColor = node.overlayColor;
+            cell.state = node.currentState;
+        });
+        gridRevision = gridPrimitive.Revision();
+    }
+
+    /**
+     * AddRunner() Copy A Runner Into The Snapshot
+     *
+     * @param pathId Uint32 Id Of The Runner's Road
+     * @param path PathView Runner Road
+     * @param t Float Position Along The Road, 0 to 1
+     * @param color Vec3 Color
+     */
+    void AddRunner(uint32_t pathId, const PathView &path, float t, const vec3 &color) {
+        RunnerSnapshot runner;
+        runner.pathId = pathId;
+        runner.path = path;
+        runner.path.codes = nullptr;
+        runner.codeOffset = (uint32_t) runnerCodes.size();
+        runner.t = t;
+        runner.color = color;
+        runnerCodes.insert(runnerCodes.end(), path.codes, path.codes + path.codeCount);
+        runners.push_back(runner);
+    }
+
+    /**
+     * RunnerPath() Road Of A Runner, pointing into this snapshot's copy of the codes
+     *
+     * @param runner RunnerSnapshot
+     * @return PathView
+     */
+    PathView RunnerPath(const RunnerSnapshot &runner) const {
+        PathView path = runner.path;
+        path.codes = runnerCodes.data() + runner.codeOffset;
+        return path;
+    }
+};
+
+/**
+ * @class TripleBuffer
+ * @details Lock-free hand-off of whole frames from one producer to one consumer. The producer always owns a slot to
+ * write, the consumer always owns a slot to read, and the third slot holds the latest published frame.
+ */
+template<typename T>
+class TripleBuffer {
+private:
+    static constexpr uint8_t SLOT_MASK = 0x3, FRESH_BIT = 0x4;
+
+    T slots[3];
+    atomic<uint8_t> middleSlot{1};
+    uint8_t writeSlot = 0, readSlot = 2;
+
+public:
+    /**
+     * WriteSlot() Slot Owned By The Producer
+     *
+     * @return T Reference
+     */
+    T &WriteSlot() { return slots[writeSlot]; }
+
+    /**
+     * Publish() Make The Written Slot The Latest Frame
+     */
+    void Publish() {
+        writeSlot = middleSlot.exchange(writeSlot | FRESH_BIT, memory_order_acq_rel) & SLOT_MASK;
+    }
+
+    /**
+     * Acquire() Latest Published Frame, or the previous one if nothing new was published
+     *
+     * @return T Reference
+     */
+    const T &Acquire() {
+        if (middleSlot.load(memory_order_relaxed) & FRESH_BIT) {
+            readSlot = middleSlot.exchange(readSlot, memory_order_acq_rel) & SLOT_MASK;
+        }
+        return slots[readSlot];
+    }
+};
+
+/**
+ * @struct BoardGrid
+ * @details Grid Renderer Fed From Render Snapshots, remembering the grid revision it last mirrored
+ */
+struct BoardGrid {
+    GridRenderer renderer;
+    uint32_t revision = 0;
+    bool synced = false;
+
+    /**
+     * Sync() Hand Changed Cell Colors To The Renderer, nothing to do while the grid revision is unchanged
+     *
+     * @param snapshot RenderSnapshot
+     */
+    void Sync(const RenderSnapshot &snapshot) {
+        if (synced && snapshot.gridRevision == revision) {
+            return;
+        }
+        if (renderer.Cols() != NCOLS || renderer.Rows() != NROWS) {
+            renderer.Resize(NCOLS, NROWS);
+        }
+        for (int cellIndex = 0; cellIndex < NROWS * NCOLS; cellIndex++) {
+            renderer.SetCellColor(cellIndex, snapshot.cells[cellIndex].color);
+        }
+        revision = snapshot.gridRevision;
+        synced = true;
+    }
+};
+
+/**
+ * DrawSnapshotGrid() Draw Grid Cells And House/Factory Markers
+ *
+ * @param grid BoardGrid Cell Renderer, draws immediately
+ * @param list DrawList Batch To Append The Markers To
+ * @param snapshot RenderSnapshot
+ */
+void DrawSnapshotGrid(BoardGrid &grid, DrawList &list, const RenderSnapshot &snapshot) {
+    PROFILE_ZONE("DrawGrid");
+    // Draw All Cells As One Quad
+    grid.Sync(snapshot);
+    grid.renderer.Draw(ScreenMode(), vec2((float) X_POS, (float) Y_POS), vec2(DX, DY));
+
+    for (const DepotSnapshot &depot: snapshot.depots) {
+        const CellSnapshot &cell = snapshot.cells[depot.cellIndex];
+        int row = depot.cellIndex / NCOLS, col = depot.cellIndex % NCOLS;
+        list.Disk(vec2(X_POS + (col + .5) * DX, Y_POS + (row + .5) * DY), depot.diameter, cell.overlayColor);
+
+        if (cell.state == CLOSED_FACTORY) {
+            // Horizontal Line
+            list.Line(vec2(X_POS + (col + 0.0) * DX, Y_POS + (row + 0.5) * DY),
+                 vec2(X_POS + (col + 1.0) * DX, Y_POS + (row + 0.5) * DY), 1.0f, cell.overlayColor);
+
+            // Vertical Line
+            list.Line(vec2(X_POS + (col + 0.5) * DX, Y_POS + (row + 1.0) * DY),
+                 vec2(X_POS + (col + 0.5) * DX, Y_POS + (row + 0.0) * DY), 1.0f, cell.overlayColor);
+        }
+    }
+}
+
+/**
+ * DrawSnapshotRunners() Draw Every Runner Road, and the runner dots unless traffic mode replaces them
+ *
+ * @param paths RunnerPathRenderer GPU-Resident Roads, draws immediately
+ * @param list DrawList Batch To Append The Traffic Dots To, and the roads when drawing into a software target
+ * @param snapshot RenderSnapshot
+ */
+void DrawSnapshotRunners(RunnerPathRenderer &paths, DrawList &list, const RenderSnapshot &snapshot) {
+    PROFILE_ZONE("DrawRunners");
+    if (CurrentSoftTarget()) {
+        // Software Target Has No GPU-Resident Roads, each road and dot is walked on the CPU into the batch
+        for (const RunnerSnapshot &runner: snapshot.runners) {
+            PathView path = snapshot.RunnerPath(runner);
+            if (path.empty()) {
+                continue;
+            }
+            DrawPath(list, path, 2.5f, runner.color);
+            if (!snapshot.trafficMode) {
+                vec2 p = PointOnPath(runner.t * PathLength(path), path);
+                list.Disk(vec2(X_POS + (p.x + .5) * DX, Y_POS + (p.y + .5) * DY), snapshot.maxDiameter * 0.5f,
+                          runner.color);
+            }
+        }
+    } else {
+        // Roads Already On The GPU Only Need Their Position Along The Path
+        for (const RunnerSnapshot &runner: snapshot.runners) {
+            paths.Add(runner.pathId, snapshot.RunnerPath(runner), runner.color, runner.t);
+        }
+        paths.Draw(ScreenMode(), vec2((float) X_POS, (float) Y_POS), vec2(DX, DY), 2.5f, snapshot.maxDiameter * 0.5f,
+                   !snapshot.trafficMode);
+    }
+    if (snapshot.trafficMode) {
+        DrawTrafficDots(list, snapshot.trafficDots, snapshot.maxDiameter * 0.35f);
+    }
+}
+
+#endif //ROADREALM_RENDERSNAPSHOT_H
@@ -1,41 +1,72 @@
 // RoadNetMain.cpp - 2D road network planning game
 // Team 8 (Edwin Kaburu, Vincent Marklynn, Yong Long Tan)
 // NOTE: Before starting up the game, please ensure to include:
-//       GLXtras.cpp, Draw.cpp, IO.cpp, Letters.cpp, Text.cpp
+//       GLXtras.cpp, Draw.cpp, DrawList.cpp, IO.cpp, Letters.cpp, Text.cpp
+// Usage: RoadRealm [--record <file>] [--replay <file>] [--nullgl <frames>] [--bench-csv <file>] [--bench-max <file>]
+//                  [--sim-thread] [--render-stress]
+//        --nullgl draws the given number of frames headless on the null GL driver and reports the driver work per frame;
+//        without --replay a headless player drags, links and wipes roads. --bench-csv moves the per-frame metrics file.
+//        --bench-max fails the run if the worst frame passes any maximum listed in the file (see RenderBench.h).
+//        --sim-thread ticks the simulation on its own thread instead, drawing flat out for as long as <frames> ticks
+//        take, and fails if the p99 tick work or lateness passes its bound; --render-stress starts with L toggled on
 
 #include <glad.h>
 #include <GLFW/glfw3.h>
 #include "Draw.h"
+#include "GLState.h"
 #include "GLXtras.h"
+#include "StreamBuffer.h"
 #include "Text.h"
 #include <ctime>
 #include <vector>
 #include "Grid.h"
+#include "PathPlanner.h"
+#include "Traffic.h"
+#include "RenderSnapshot.h"
+#include "SimClock.h"
+#include "SpscQueue.h"
+#include "InputEvents.h"
+#include "AudioMixer.h"
+#include "AtlasBundle.h"
+#include "AssetLoader.h"
+#include "RecordStore.h"
+#include "RenderBench.h"
+#include "HeadlessPlayer.h"
 #include <string>
+#include <atomic>
 #include <chrono>
+#include <thread>
 #include <map>
-#include <iomanip>
-#include <sstream>
 #include <fstream>
 #include "Sprite.h"
+#ifdef _WIN32
 #include <windows.h>
 #include <mmsystem.h>
 
 #pragma comment(lib, "winmm.lib")
+#endif
 
 using namespace std;
 
 unsigned int NUM_OF_FRAMES = 0;
 double INIT_FPS_TIME = 0;
-bool GLOBAL_MOUSE_DOWN = false, GLOBAL_PAUSE = false, GLOBAL_DRAW_BORDERS = false, ACTIVE_GAME_RESET = false, GAME_OVER = false, CLEAR_ROADS = false;
+bool GLOBAL_MOUSE_DOWN = false, GLOBAL_PAUSE = false, GLOBAL_DRAW_BORDERS = false, ACTIVE_GAME_RESET = false, GAME_OVER = false, CLEAR_ROADS = false, TRAFFIC_MODE = false;
 // In Seconds
-double REPLENISH_INTERVAL = 10.0, FRAMES_PER_SECONDS = 0;
+double REPLENISH_INTERVAL = 10.0;
+// Render Frame Rate, written by the render thread and shown by the simulation
+atomic<double> FRAMES_PER_SECONDS = 0;
 int REPLENISH_ROADS_NUM = 20;
 int SPAWN_INTERVAL = 5;
-float FONT_SCALE = 10.0f;
 
 
-string LOCAL_STORAGE = "RoadNet/Storage/best_record.txt";
+#define ALLOC_TELEMETRY_CSV "RoadNet/Storage/alloc_telemetry.csv"
+
+#ifdef ROADREALM_FRAME_PROFILER
+// Profiler Overlay Shown Over The Board, toggled on the main thread
+bool PROFILE_OVERLAY = true;
+#define PROFILE_OVERLAY_LINE 16
+#define PROFILE_OVERLAY_WIDTH 300
+#endif
 
 vec2 CURRENT_CLICKED_CELL((NROWS + NCOLS), (NROWS + NCOLS));
 
@@ -44,9 +75,9 @@ vector<vec2> PREV_DRAGGED_CELLS;
 InfoPanel infoPanel;
 Sprite myResetButton, myExitButton, myStartButton, myQuitButton, backGround, myPauseButton, myResumeButton, myClearButton;
 
-GLFWwindow *w = InitGLFW(100, 100, APP_WIDTH, APP_HEIGHT, "RoadRealm");
+// Game Window, none when running headless on the null GL driver
+GLFWwindow *w = nullptr;
 
-time_t oldtime = clock();
 chrono::duration<double> gameClock;
 int currNumRoads = 20;
 double lastReplenishTime = 0.0;
@@ -54,7 +85,66 @@ double lastPairSpawnTime = 0.0;
 float countDown = 5.0f;
 float bufferTime = 5.0f;
 
-map<string, RoadRunnerLinker> ROAD_RUNNERS;
+pmr::map<pmr::string, RoadRunnerLinker> ROAD_RUNNERS(GAME_ARENA.Resource());
+// Id Of The Most Recently Linked Runner Road
+uint32_t LAST_RUNNER_PATH_ID = 0;
+TrafficSimulator TRAFFIC;
+// Frames Handed From The Simulation To The Renderer
+TripleBuffer<RenderSnapshot> RENDER_SNAPSHOTS;
+
+/**
+ * Threads: the simulation thread owns the grid, runners, traffic, info panel and every gameplay global above. The
+ * main thread only polls GLFW, resolves button hits and draws snapshots; it talks to the simulation through
+ * INPUT_EVENTS one way and RENDER_SNAPSHOTS the other.
+ */
+#define INPUT_QUEUE_CAPACITY 1024
+// Grid Draws Per Frame While Render Stress Is On, to saturate the renderer on purpose
+#define RENDER_STRESS_PASSES 64
+
+SpscQueue<InputEvent, INPUT_QUEUE_CAPACITY> INPUT_EVENTS;
+atomic<bool> SIM_RUNNING = true;
+TickStats SIM_TICK_STATS;
+// Cell Size Seen By The Simulation, updated through INPUT_RESIZE
+int SIM_CELL_W = (int) DX - 1, SIM_CELL_H = (int) DY - 1;
+// Recording Or Replay Of The Consumed Input Stream, chosen with --record <file> or --replay <file>
+InputRecorder INPUT_RECORDER;
+InputReplay INPUT_REPLAY;
+// Move Held Back While The Mouse Is Up, only the latest one matters then
+InputEvent PENDING_MOVE;
+bool HAS_PENDING_MOVE = false;
+
+// Frames Drawn On The Null GL Driver, chosen with --nullgl <frames>; 0 to open a window
+int NULL_GL_FRAMES = 0;
+// Player Of Headless Runs Without A Replay
+HeadlessPlayer HEADLESS_PLAYER;
+// Per-Frame Metrics File Of Headless Runs, chosen with --bench-csv <file>
+const char *RENDER_BENCH_PATH = RENDER_BENCH_CSV;
+// Per-Frame Maximums Checked After Headless Runs, chosen with --bench-max <file>
+const char *RENDER_BENCH_MAX_PATH = nullptr;
+// Headless Runs With The Simulation On Its Own Thread, chosen with --sim-thread
+bool NULL_GL_SIM_THREAD = false;
+// Bounds On The p99 Tick Of A --sim-thread Run: work well inside the 16.7 ms tick, and lateness under half a tick so a
+//   late tick never slips into the next; a renderer sharing one core costs about one scheduler slice (3-4 ms)
+#define SIM_STRESS_MAX_WORK_MS 4.0f
+#define SIM_STRESS_MAX_LATE_MS (500.0f / SIM_TICK_RATE)
+
+// Render Thread State
+ApplicationStates RENDER_APP_STATE = STARTING_MENU;
+bool RENDER_STRESS = false;
+// Board Primitives Batched Per Frame, one draw per primitive type when flushed
+DrawList BOARD_DRAWS;
+// Info Panel Labels, laid out from one glyph atlas and drawn in a single call
+TextBatch PANEL_TEXT;
+// Runner Roads Kept On The GPU Between Frames
+RunnerPathRenderer RUNNER_PATHS;
+BoardGrid BOARD_GRID;
+
+// Live Drag Preview (Cursor Cell -> Matching Factory)
+DStarLitePlanner DRAG_PLANNER;
+vector<NodePosition> DRAG_PREVIEW_PATH;
+vector<uint8_t> DRAG_BLOCKED_CELLS;
+size_t DRAG_PREVIEW_PROCESSED = 0;
+vec3 DRAG_PREVIEW_COLOR = PALE_GREY;
 
 string formatDuration(const chrono::duration<double> &duration) {
     int totalSeconds = static_cast<int>(duration.count());
@@ -62,44 +152,11 @@ string formatDuration(const chrono::duration<double> &duration) {
     int minutes = (totalSeconds % 3600) / 60;
     int seconds = totalSeconds % 60;
 
-    stringstream ss;
-    ss << setw(2) << setfill('0') << hours << "H"
-       << setw(2) << setfill('0') << minutes << "M"
-       << setw(2) << setfill('0') << seconds << "S";
-
-    return ss.str();
-}
-
-void setBestRecord(double bestRecord) {
-    std::ofstream file(LOCAL_STORAGE);
-
-    if (file.is_open()) {
-        file << bestRecord;
-    }
-
-    file.close();
-}
-
-double getBestRecord() {
-    std::ifstream file(LOCAL_STORAGE);
-    double longestDuration = 0.0;
-
-    if (file.is_open()) {
-        file >> longestDuration;
-    }
-
-    file.close();
+    // Short Enough For The Small String Buffer, so formatting never reaches the heap
+    char formatted[16];
+    snprintf(formatted, sizeof(formatted), "%02dH%02dM%02dS", hours % 100, minutes, seconds);
 
-    return longestDuration;
-}
-
-void checkAndSaveBestRecord(chrono::duration<double> gameClock) {
-    double newRecord = gameClock.count();
-    double currentBestScore = getBestRecord();
-
-    if (newRecord > currentBestScore) {
-        setBestRecord(newRecord);
-    }
+    return formatted;
 }
 
 void replenishRoads() {
@@ -119,7 +176,7 @@ void GenerateDestination(GridPrimitive &gridPrimitive, int radius, int retryCoun
     vec2 rndStPoint;
     vec2 rndEdPoint;
 
-    vector<vec2> potentialValues = {};
+    pmr::vector<vec2> potentialValues(FRAME_ARENA.Resource());
 
     while (!addStatus && retryCount > 0) {
         rndStPoint = GetRandomPoint();
@@ -144,12 +201,18 @@ void GenerateDestination(GridPrimitive &gridPrimitive, int radius, int retryCoun
         retryCount -= 1;
     }
 
+    if (addStatus && DRAG_PLANNER.IsActive()) {
+        DRAG_PLANNER.SetBlocked(NodePosition((int) rndStPoint.y, (int) rndStPoint.x), true);
+        DRAG_PLANNER.SetBlocked(NodePosition((int) rndEdPoint.y, (int) rndEdPoint.x), true);
+    }
+
     if (APPLICATION_STATE == GAME_STATE && addStatus) {
-        PlaySound(TEXT("RoadNet/Sounds/chime.wav"), NULL, SND_FILENAME | SND_ASYNC);
+        AUDIO.Play(SOUND_CHIME);
     }
 }
 
 void spawnPair(int interval, GridPrimitive &gridPrimitive, int radius = 2) {
+    PROFILE_ZONE("SpawnPair");
     if (gameClock.count() - lastPairSpawnTime >= interval) {
         GenerateDestination(gridPrimitive, radius, PAIR_GENERATION_RETRY);
         lastPairSpawnTime = gameClock.count();
@@ -157,18 +220,17 @@ void spawnPair(int interval, GridPrimitive &gridPrimitive, int radius = 2) {
 }
 
 
-void Update(GridPrimitive &gridPrimitive) {
-
-    time_t now = clock();
-    float dt;
+void Update(GridPrimitive &gridPrimitive, float dt) {
+    ALLOC_ZONE(ALLOC_ZONE_UPDATE);
+    PROFILE_ZONE("Update");
 
     if (APPLICATION_STATE == GAME_STATE && !GLOBAL_PAUSE) {
-        dt = (float) (now - oldtime) / CLOCKS_PER_SEC;
-
-
-        oldtime = now;
-        for (auto &runnerLinkers: ROAD_RUNNERS) {
-            runnerLinkers.second.vehicleRunner.Update(dt);
+        if (TRAFFIC_MODE) {
+            TRAFFIC.Update(dt);
+        } else {
+            for (auto &runnerLinkers: ROAD_RUNNERS) {
+                runnerLinkers.second.vehicleRunner.Update(dt);
+            }
         }
 
         gameClock += chrono::duration<double>(dt);
@@ -179,8 +241,8 @@ void Update(GridPrimitive &gridPrimitive) {
             } else {
                 countDown -= dt;
                 if (countDown <= 0.0f) {
-                    PlaySound(TEXT("RoadNet/Sounds/game_over.wav"), NULL, SND_FILENAME | SND_ASYNC);
-                    checkAndSaveBestRecord(gameClock);
+                    AUDIO.Play(SOUND_GAME_OVER);
+                    RECORDS.Add(gameClock.count());
                     GAME_OVER = true;
                     ACTIVE_GAME_RESET = true;
                     countDown = 5.0f;
@@ -195,24 +257,46 @@ void Update(GridPrimitive &gridPrimitive) {
         int radius = ((((int) gameClock.count() % 3600) / 60) + 1) * 2;
         spawnPair(SPAWN_INTERVAL, gridPrimitive, radius);
         replenishRoads();
-    } else {
-        oldtime = now;
     }
 
-    gridPrimitive.GridUpdate();
+    gridPrimitive.GridUpdate(SIM_CELL_W, SIM_CELL_H);
+    if (APPLICATION_STATE == GAME_STATE) {
+        if (gameClock.count() < 0.05) {
+            AUDIO.Play(SOUND_CALL_TO_ARMS);
+        }
+        infoPanel.SetLabel(COUNTDOWN, countDown < 5.0f ? RED : GREEN, "Countdown: ", LabelFixed{countDown, 3}, "S");
+    } else if (GAME_OVER) {
+        infoPanel.AddMessage(COUNTDOWN, " ", WHITE);
+    }
     // EVENT_LABEL
-    infoPanel.AddMessage(TIME_LABEL, "Time: " + formatDuration(gameClock), WHITE);
-    infoPanel.AddMessage(DIMS_LABEL, "Grid DIM: (" + to_string(NROWS) + " by " + to_string(NCOLS) + ")", WHITE);
-    infoPanel.AddMessage(NUM_OF_ROAD_LABEL, "Number of Roads: " + to_string(currNumRoads), WHITE);
+    infoPanel.SetLabel(TIME_LABEL, WHITE, "Time: ", LabelDuration{(int) gameClock.count()});
+    infoPanel.SetLabel(DIMS_LABEL, WHITE, "Grid DIM: (", NROWS, " by ", NCOLS, ")");
+    infoPanel.SetLabel(NUM_OF_ROAD_LABEL, WHITE, "Number of Roads: ", currNumRoads);
     infoPanel.AddMessage(APPLICATION_STATE_LABEL, PrintApplicationState(), PURPLE);
     infoPanel.AddMessage(GAMEPLAY_STATE_LABEL, PrintGameplayState(), PURPLE);
-    infoPanel.AddMessage(FPS_LABEL, ("FPS: " + to_string(FRAMES_PER_SECONDS)), WHITE);
-    infoPanel.AddMessage(RUNNERS_COUNT_LABEL, ("Total Runners: " + to_string(ROAD_RUNNERS.size())), YELLOW);
+    infoPanel.SetLabel(FPS_LABEL, WHITE, "FPS: ", LabelFixed{FRAMES_PER_SECONDS.load(memory_order_relaxed), 1});
+    infoPanel.SetLabel(RUNNERS_COUNT_LABEL, YELLOW, "Total Runners: ", ROAD_RUNNERS.size());
     infoPanel.AddMessage(EVT_MSG_LABEL, GLOBAL_EVENT_LABEL, CYAN);
+    if (TRAFFIC_MODE) {
+        infoPanel.SetLabel(TRAFFIC_LABEL, ORANGE, "Congestion: ", (int) (TRAFFIC.CongestionIndex() * 100), "% (",
+                           TRAFFIC.AgentCount(), " cars)");
+    } else {
+        infoPanel.AddMessage(TRAFFIC_LABEL, "Traffic: OFF", ORANGE);
+    }
+    TickSummary tickSummary = SIM_TICK_STATS.Summary();
+    infoPanel.SetLabel(SIM_TICK_LABEL, tickSummary.p99LateMs > 1000.0f / SIM_TICK_RATE ? RED : GREEN, "Tick: ",
+                       LabelFixed{tickSummary.meanWorkMs, 2}, "ms p99 ", LabelFixed{tickSummary.p99WorkMs, 2},
+                       "ms late ", LabelFixed{tickSummary.p99LateMs, 2}, "ms");
+#ifdef ROADREALM_ALLOC_TELEMETRY
+    const AllocFrameRecord &allocFrame = AllocTelemetry::LastFrame();
+    infoPanel.SetLabel(ALLOC_LABEL, allocFrame.TotalAllocations() > ALLOC_FRAME_BUDGET ? RED : GREEN,
+                       "Allocs/Tick: ", allocFrame.TotalAllocations(), " (", allocFrame.TotalBytes(), "B) Over: ",
+                       AllocTelemetry::BudgetViolations());
+#endif
 }
 
 bool LinkedPathFormulation(GridPrimitive &gridPrimitive, NodePosition homePos, NodePosition factoryPos,
-                           const Vehicle &vehicleRunner, const string &pathHashKey) {
+                           Vehicle &vehicleRunner, const pmr::string &pathHashKey) {
     bool updateLinkStatus = false;
 
     if (GLOBAL_GAMEPLAY_STATE == DRAW_STATE) {
@@ -221,8 +305,11 @@ bool LinkedPathFormulation(GridPrimitive &gridPrimitive, NodePosition homePos, N
         if (updateLinkStatus) {
             currNumRoads += 2;
 
-            RoadRunnerLinker runnerLinker(pathHashKey, vehicleRunner, true);
-            ROAD_RUNNERS.insert({pathHashKey, runnerLinker});
+            // Runner Moves Into The Map Node, Its Path Stays Where The Arena Placed It
+            Vehicle &linkedRunner = ROAD_RUNNERS.try_emplace(pathHashKey, pathHashKey, std::move(vehicleRunner),
+                                                             true).first->second.vehicleRunner;
+            linkedRunner.pathId = ++LAST_RUNNER_PATH_ID;
+            TRAFFIC.AddRoad(pathHashKey, linkedRunner.runnerPath, linkedRunner.overlayColor);
             currNumRoads -= (int) PREV_DRAGGED_CELLS.size();
 
             infoPanel.AddMessage(ERROR_MSG_LABEL, "Valid Linking", GREEN);
@@ -235,6 +322,7 @@ bool LinkedPathFormulation(GridPrimitive &gridPrimitive, NodePosition homePos, N
             updateLinkStatus = gridPrimitive.UpdateDestinationLink(homePos, factoryPos, false);
             if (updateLinkStatus) {
                 cout << pathHashKey << endl;
+                TRAFFIC.RemoveRoad(pathHashKey);
                 ROAD_RUNNERS.erase(findRunner);
                 currNumRoads += (int) PREV_DRAGGED_CELLS.size() - 2;
 
@@ -289,11 +377,15 @@ bool AreValidDraggedCells(GridPrimitive &gridPrimitive, Node &houseNode, Node &f
 }
 
 void ToggleDraggedCellsStates(GridPrimitive &gridPrimitive) {
+    ALLOC_ZONE(ALLOC_ZONE_TOGGLE_DRAGGED);
+    PROFILE_ZONE("ToggleDraggedCellsStates");
     if (!GLOBAL_MOUSE_DOWN && !PREV_DRAGGED_CELLS.empty()) {
 
         Vehicle vehicleRunner(-.55f, .0f);
         Node houseNode, factoryNode;
-        string pathHashKey;
+        pmr::string pathHashKey(GAME_ARENA.Resource());
+        pmr::vector<NodePosition> runnerCells(GAME_ARENA.Resource());
+        runnerCells.reserve(PREV_DRAGGED_CELLS.size());
 
         bool isErrorCorrect = AreValidDraggedCells(gridPrimitive, houseNode, factoryNode);
 
@@ -305,12 +397,13 @@ void ToggleDraggedCellsStates(GridPrimitive &gridPrimitive) {
                 // Hash Key
                 pathHashKey += to_string(getNode.currentPos.row) + to_string(getNode.currentPos.col);
                 // Add To Path
-                vehicleRunner.runnerPath.push_back(getNode.currentPos);
+                runnerCells.push_back(getNode.currentPos);
 
                 if (getNode.currentState != CLOSED_HOUSE && getNode.currentState != CLOSED_FACTORY) {
                     vehicleRunner.overlayColor = houseNode.overlayColor;
                 }
             }
+            vehicleRunner.runnerPath = PackedPath::Encode(runnerCells);
             // Link Result
             isErrorCorrect = LinkedPathFormulation(gridPrimitive, houseNode.currentPos, factoryNode.currentPos,
                                                    vehicleRunner,
@@ -323,7 +416,7 @@ void ToggleDraggedCellsStates(GridPrimitive &gridPrimitive) {
         }
 
         if (!isErrorCorrect) {
-            PlaySound(TEXT("RoadNet/Sounds/error.wav"), NULL, SND_FILENAME | SND_ASYNC);
+            AUDIO.Play(SOUND_ERROR);
             cout << "Is Not Correct Dragging Linking\n";
             gridPrimitive.ResetNodes(PREV_DRAGGED_CELLS, true);
             infoPanel.AddMessage(ERROR_MSG_LABEL, "InValid Linking", RED);
@@ -342,6 +435,63 @@ void ToggleDraggedCellsStates(GridPrimitive &gridPrimitive) {
 }
 
 
+void EndDragPreview() {
+    DRAG_PLANNER.End();
+    DRAG_PREVIEW_PATH.clear();
+    DRAG_PREVIEW_PROCESSED = 0;
+}
+
+void RefreshDragPreview(GridPrimitive &gridPrimitive) {
+    if (!GLOBAL_MOUSE_DOWN || PREV_DRAGGED_CELLS.empty() || GLOBAL_GAMEPLAY_STATE != DRAW_STATE) {
+        if (DRAG_PREVIEW_PROCESSED > 0) {
+            EndDragPreview();
+        }
+        return;
+    }
+
+    if (DRAG_PREVIEW_PROCESSED == 0) {
+        // Drag Must Start On A House That Has A Factory Objective
+        vec2 houseCell = PREV_DRAGGED_CELLS.front();
+        DRAG_PREVIEW_PROCESSED = 1;
+
+        if (IsWithInBounds(houseCell)) {
+            Node houseNode = gridPrimitive.GetNode(houseCell);
+            NodePosition factoryPos;
+            if (houseNode.currentState == CLOSED_HOUSE &&
+                gridPrimitive.FindMatchingFactory(houseNode.currentPos, factoryPos)) {
+                gridPrimitive.FillBlockedCells(DRAG_BLOCKED_CELLS);
+                DRAG_PLANNER.Begin(NROWS, NCOLS, houseNode.currentPos, factoryPos, DRAG_BLOCKED_CELLS);
+                DRAG_PREVIEW_COLOR = houseNode.overlayColor;
+            }
+        }
+    }
+
+    if (!DRAG_PLANNER.IsActive()) {
+        return;
+    }
+
+    // Repair Only Around The Cells Dragged Since The Last Refresh
+    for (; DRAG_PREVIEW_PROCESSED < PREV_DRAGGED_CELLS.size(); DRAG_PREVIEW_PROCESSED++) {
+        vec2 prevCell = PREV_DRAGGED_CELLS.at(DRAG_PREVIEW_PROCESSED - 1);
+        vec2 curCell = PREV_DRAGGED_CELLS.at(DRAG_PREVIEW_PROCESSED);
+
+        DRAG_PLANNER.SetBlocked(NodePosition((int) prevCell.y, (int) prevCell.x), true);
+        DRAG_PLANNER.MoveStart(NodePosition((int) curCell.y, (int) curCell.x));
+    }
+
+    if (!IsWithInBounds(PREV_DRAGGED_CELLS.back())) {
+        DRAG_PREVIEW_PATH.clear();
+        return;
+    }
+    // Long Repairs Carry On Next Tick, the old preview is taken down meanwhile as it starts where the cursor was
+    DRAG_PLANNER.ComputeShortestPath(PLANNER_EXPANSION_BUDGET);
+    if (DRAG_PLANNER.IsSettled()) {
+        DRAG_PLANNER.ExtractPath(DRAG_PREVIEW_PATH);
+    } else {
+        DRAG_PREVIEW_PATH.clear();
+    }
+}
+
 bool ClickedCellHandled(int col, int row) {
     if (col >= NCOLS || row >= NROWS) {
         infoPanel.AddMessage(ERROR_MSG_LABEL, "Out Of Grid Mouse Click", RED);
@@ -356,16 +506,6 @@ bool ClickedCellHandled(int col, int row) {
     return false;
 }
 
-bool AccumulateDraggedCell(float xMouse, float yMouse) {
-    int col = (int) ((xMouse - X_POS) / DX), row = (int) ((yMouse - Y_POS) / DY);
-    if (!ClickedCellHandled(col, row)) {
-        CURRENT_CLICKED_CELL = vec2(col, row);
-        PREV_DRAGGED_CELLS.push_back(CURRENT_CLICKED_CELL);
-        return true;
-    }
-    return false;
-}
-
 bool AccumulateDraggedCell(int col, int row) {
     if (!ClickedCellHandled(col, row)) {
 
@@ -380,6 +520,7 @@ bool AccumulateDraggedCell(int col, int row) {
 
 
 void ResetGameState(GridPrimitive &gridPrimitive) {
+    PROFILE_ZONE("ResetGameState");
     if (ACTIVE_GAME_RESET) {
         GLOBAL_GAMEPLAY_STATE = DRAW_STATE;
         GLOBAL_MOUSE_DOWN = false;
@@ -400,10 +541,15 @@ void ResetGameState(GridPrimitive &gridPrimitive) {
 
         PREV_DRAGGED_CELLS.clear();
         ROAD_RUNNERS.clear();
+        TRAFFIC.Clear();
+        GAME_ARENA.Release();
+        EndDragPreview();
         gridPrimitive.GridReset();
     }
     if (CLEAR_ROADS) {
         ROAD_RUNNERS.clear();
+        TRAFFIC.Clear();
+        GAME_ARENA.Release();
         int numRoadsAfterClear = gridPrimitive.GridClearAndCountRoads();
         currNumRoads += numRoadsAfterClear;
     }
@@ -411,104 +557,360 @@ void ResetGameState(GridPrimitive &gridPrimitive) {
     ACTIVE_GAME_RESET = false;
 }
 
-void MouseButton(float xmouse, float ymouse, bool left, bool down) {
+/**
+ * HandleMousePress() Apply A Mouse Press On The Simulation Thread
+ *
+ * @param event InputEvent
+ */
+void HandleMousePress(const InputEvent &event) {
+    AUDIO.Play(SOUND_CLICK);
+    GLOBAL_MOUSE_DOWN = true;
+
+    if (APPLICATION_STATE == GAME_STATE && event.button == BUTTON_RESET) {
+        GLOBAL_EVENT_LABEL = "RESET_EVT";
+
+        ACTIVE_GAME_RESET = true;
+    } else if (APPLICATION_STATE == GAME_STATE && event.button == BUTTON_PAUSE) {
+        GLOBAL_PAUSE = !GLOBAL_PAUSE;
+        GLOBAL_EVENT_LABEL = "PLAY_EVT";
+        if (GLOBAL_PAUSE) {
+            GLOBAL_EVENT_LABEL = "PAUSE_EVT";
+        }
+    } else if (APPLICATION_STATE == GAME_STATE && event.button == BUTTON_EXIT) {
+        GLOBAL_EVENT_LABEL = "EXIT_EVT";
 
-    int col = (int) ((xmouse - X_POS) / DX), row = (int) ((ymouse - Y_POS) / DY);
-    infoPanel.AddMessage(MOUSE_CLICK_LABEL, "Mouse Move: X" + to_string(col) + " Y " + to_string(row), WHITE);
+        APPLICATION_STATE = STARTING_MENU;
+        ACTIVE_GAME_RESET = true;
+    } else if (APPLICATION_STATE == GAME_STATE && event.button == BUTTON_CLEAR) {
+        GLOBAL_EVENT_LABEL = "CLEAR_EVT";
 
-    if (down) {
-        PlaySound(TEXT("RoadNet/Sounds/click_x.wav"), NULL, SND_FILENAME | SND_ASYNC);
-        GLOBAL_MOUSE_DOWN = true;
+        CLEAR_ROADS = true;
 
-        if (APPLICATION_STATE == GAME_STATE && myResetButton.Hit(xmouse, ymouse)) {
-            GLOBAL_EVENT_LABEL = "RESET_EVT";
+    } else if (APPLICATION_STATE == STARTING_MENU && event.button == BUTTON_START) {
+        GLOBAL_EVENT_LABEL = "START_EVT";
 
-            ACTIVE_GAME_RESET = true;
-        } else if (APPLICATION_STATE == GAME_STATE && myPauseButton.Hit(xmouse, ymouse)) {
+        GAME_OVER = false;
+        APPLICATION_STATE = GAME_STATE;
+    } else if (APPLICATION_STATE == STARTING_MENU && event.button == BUTTON_QUIT) {
+        // Window Is Closed By The Main Thread
+        GLOBAL_EVENT_LABEL = "QUIT_EVT";
+    } else {
+        AccumulateDraggedCell(event.col, event.row);
+    }
+}
+
+/**
+ * HandleKey() Apply A Key Press On The Simulation Thread
+ *
+ * @param key Integer GLFW Key
+ */
+void HandleKey(int key) {
+    switch (key) {
+        case GLFW_KEY_P:
+            AUDIO.Play(SOUND_CLICK);
+            GLOBAL_PAUSE = !GLOBAL_PAUSE;
+            GLOBAL_EVENT_LABEL = "PLAY_EVT";
+            if (GLOBAL_PAUSE) {
+                GLOBAL_EVENT_LABEL = "PAUSE_EVT";
+            }
+            break;
+        case GLFW_KEY_SPACE:
+            AUDIO.Play(SOUND_CLICK);
             GLOBAL_PAUSE = !GLOBAL_PAUSE;
             GLOBAL_EVENT_LABEL = "PLAY_EVT";
             if (GLOBAL_PAUSE) {
                 GLOBAL_EVENT_LABEL = "PAUSE_EVT";
             }
-        } else if (APPLICATION_STATE == GAME_STATE && myExitButton.Hit(xmouse, ymouse)) {
-            GLOBAL_EVENT_LABEL = "EXIT_EVT";
+            break;
+        case GLFW_KEY_D:
+            AUDIO.Play(SOUND_CLICK);
+            if (GLOBAL_GAMEPLAY_STATE == WIPE_STATE) {
+                GLOBAL_GAMEPLAY_STATE = DRAW_STATE;
+            } else {
+                GLOBAL_GAMEPLAY_STATE = WIPE_STATE;
+            }
+            break;
+        case GLFW_KEY_W:
+            AUDIO.Play(SOUND_CLICK);
+            GLOBAL_GAMEPLAY_STATE = WIPE_STATE;
+            break;
+        case GLFW_KEY_T:
+            AUDIO.Play(SOUND_CLICK);
+            TRAFFIC_MODE = !TRAFFIC_MODE;
+
+            GLOBAL_EVENT_LABEL = "TRAFFIC_EVT";
+            break;
+        case GLFW_KEY_B:
+            AUDIO.Play(SOUND_CLICK);
+            GLOBAL_DRAW_BORDERS = !GLOBAL_DRAW_BORDERS;
+
+            GLOBAL_EVENT_LABEL = "BORDER_DISP_EVT";
+            break;
+        case GLFW_KEY_L:
+            // Render Stress Itself Is Toggled On The Main Thread
+            GLOBAL_EVENT_LABEL = "RENDER_STRESS_EVT";
+            break;
+#ifdef ROADREALM_ALLOC_TELEMETRY
+        case GLFW_KEY_E:
+            GLOBAL_EVENT_LABEL = AllocTelemetry::ExportCsv(ALLOC_TELEMETRY_CSV) ? "ALLOC_CSV_EVT" : "ALLOC_CSV_ERR";
+            break;
+#endif
+#ifdef ROADREALM_FRAME_PROFILER
+        case GLFW_KEY_X:
+            GLOBAL_EVENT_LABEL = FrameProfiler::ExportChromeTrace(PROFILE_TRACE_FILE) ? "TRACE_EVT" : "TRACE_ERR";
+            break;
+#endif
+    }
+}
 
-            APPLICATION_STATE = STARTING_MENU;
-            ACTIVE_GAME_RESET = true;
-        } else if (APPLICATION_STATE == GAME_STATE && myClearButton.Hit(xmouse, ymouse)) {
-            GLOBAL_EVENT_LABEL = "CLEAR_EVT";
+/**
+ * ApplyInputEvent() Apply One Input Event To The Simulation State
+ *
+ * @param event InputEvent
+ */
+void ApplyInputEvent(const InputEvent &event) {
+    switch (event.type) {
+        case INPUT_MOUSE_PRESS:
+            infoPanel.SetLabel(MOUSE_CLICK_LABEL, WHITE, "Mouse Move: X", event.col, " Y ", event.row);
+            HandleMousePress(event);
+            break;
+        case INPUT_MOUSE_RELEASE:
+            infoPanel.SetLabel(MOUSE_CLICK_LABEL, WHITE, "Mouse Move: X", event.col, " Y ", event.row);
+            GLOBAL_MOUSE_DOWN = false;
+            break;
+        case INPUT_MOUSE_MOVE:
+            infoPanel.SetLabel(MOUSE_MOVE_LABEL, WHITE, "Mouse Move: X", event.col, " Y ", event.row);
+            if (GLOBAL_MOUSE_DOWN) {
+                AccumulateDraggedCell(event.col, event.row);
+            }
+            break;
+        case INPUT_KEY:
+            HandleKey(event.key);
+            break;
+        case INPUT_RESIZE:
+            SIM_CELL_W = event.col;
+            SIM_CELL_H = event.row;
+            break;
+        case INPUT_TICK:
+            break;
+    }
+}
 
-            CLEAR_ROADS = true;
+/**
+ * CoalesceInputEvent() Apply An Event, collapsing runs of moves made while the mouse is up into the last one.
+ * Moves during a drag are all kept, since every cell they cross becomes part of the road.
+ *
+ * @param event InputEvent
+ */
+void CoalesceInputEvent(const InputEvent &event) {
+    if (event.type == INPUT_MOUSE_MOVE && !GLOBAL_MOUSE_DOWN) {
+        PENDING_MOVE = event;
+        HAS_PENDING_MOVE = true;
+        return;
+    }
+    if (HAS_PENDING_MOVE) {
+        HAS_PENDING_MOVE = false;
+        ApplyInputEvent(PENDING_MOVE);
+    }
+    ApplyInputEvent(event);
+}
 
-        } else if (APPLICATION_STATE == STARTING_MENU && myStartButton.Hit(xmouse, ymouse)) {
-            GLOBAL_EVENT_LABEL = "START_EVT";
+/**
+ * DrainInputEvents() Apply The Input Of One Tick, from the live queue or from a replayed recording
+ *
+ * @param tickTimeUs Unsigned Input Clock Time Of This Tick, replaced by the recorded time while replaying
+ */
+void DrainInputEvents(uint32_t &tickTimeUs) {
+    PROFILE_ZONE("DrainInput");
+    InputEvent event;
+    if (INPUT_REPLAY.IsOpen()) {
+        // Live Input Is Ignored While Replaying, except for the window layout
+        while (INPUT_EVENTS.Pop(event)) {
+            if (event.type == INPUT_RESIZE) {
+                ApplyInputEvent(event);
+            }
+        }
+        bool tickFound = false;
+        while (INPUT_REPLAY.Next(event)) {
+            INPUT_RECORDER.Write(event);
+            if (event.type == INPUT_TICK) {
+                tickFound = true;
+                tickTimeUs = event.timeUs;
+                break;
+            }
+            CoalesceInputEvent(event);
+        }
+        if (!tickFound) {
+            INPUT_REPLAY.Close();
+            GLOBAL_EVENT_LABEL = "REPLAY_END_EVT";
+        }
+    } else {
+        while (INPUT_EVENTS.Pop(event)) {
+            // Resizes Depend On The Window, not on the game
+            if (event.type != INPUT_RESIZE) {
+                INPUT_RECORDER.Write(event);
+            }
+            CoalesceInputEvent(event);
+        }
+        InputEvent tick;
+        tick.type = INPUT_TICK;
+        tick.timeUs = tickTimeUs;
+        INPUT_RECORDER.Write(tick);
+    }
+    if (HAS_PENDING_MOVE) {
+        HAS_PENDING_MOVE = false;
+        ApplyInputEvent(PENDING_MOVE);
+    }
+}
 
-            GAME_OVER = false;
-            APPLICATION_STATE = GAME_STATE;
-        } else if (APPLICATION_STATE == STARTING_MENU && myQuitButton.Hit(xmouse, ymouse)) {
-            GLOBAL_EVENT_LABEL = "QUIT_EVT";
+/**
+ * HitButton() Resolve Which UI Button Lies Under The Cursor, main thread only as sprite hits read GL state
+ *
+ * @param xmouse Float X
+ * @param ymouse Float Y
+ * @return UiButton, BUTTON_NONE if no button was hit
+ */
+UiButton HitButton(float xmouse, float ymouse) {
+    if (RENDER_APP_STATE == GAME_STATE) {
+        if (myResetButton.Hit(xmouse, ymouse)) return BUTTON_RESET;
+        if (myPauseButton.Hit(xmouse, ymouse)) return BUTTON_PAUSE;
+        if (myExitButton.Hit(xmouse, ymouse)) return BUTTON_EXIT;
+        if (myClearButton.Hit(xmouse, ymouse)) return BUTTON_CLEAR;
+    } else {
+        if (myStartButton.Hit(xmouse, ymouse)) return BUTTON_START;
+        if (myQuitButton.Hit(xmouse, ymouse)) return BUTTON_QUIT;
+    }
+    return BUTTON_NONE;
+}
 
+void MouseButton(float xmouse, float ymouse, bool left, bool down) {
+    InputEvent event;
+    event.timeUs = InputTimestamp();
+    event.type = down ? INPUT_MOUSE_PRESS : INPUT_MOUSE_RELEASE;
+    event.col = (int16_t) ((xmouse - X_POS) / DX);
+    event.row = (int16_t) ((ymouse - Y_POS) / DY);
+    if (down) {
+        event.button = HitButton(xmouse, ymouse);
+        if (event.button == BUTTON_QUIT) {
             glfwSetWindowShouldClose(w, true);
-        } else {
-            AccumulateDraggedCell(xmouse, ymouse);
         }
-    } else {
-        GLOBAL_MOUSE_DOWN = false;
     }
+    INPUT_EVENTS.Push(event);
 }
 
 void MouseMove(float x, float y, bool leftDown, bool rightDown) {
-    int col = (int) ((x - X_POS) / DX), row = (int) ((y - Y_POS) / DY);
-
-    infoPanel.AddMessage(MOUSE_MOVE_LABEL, "Mouse Move: X" + to_string(col) + " Y " + to_string(row), WHITE);
-
-    if (GLOBAL_MOUSE_DOWN) {
-        AccumulateDraggedCell(col, row);
+    static int16_t lastCol = -1, lastRow = -1;
+    InputEvent event;
+    event.timeUs = InputTimestamp();
+    event.type = INPUT_MOUSE_MOVE;
+    event.col = (int16_t) ((x - X_POS) / DX);
+    event.row = (int16_t) ((y - Y_POS) / DY);
+    // Moves Within The Same Cell Change Nothing, so only cell crossings are queued
+    if (event.col == lastCol && event.row == lastRow) {
+        return;
+    }
+    if (INPUT_EVENTS.Push(event)) {
+        lastCol = event.col;
+        lastRow = event.row;
     }
 }
 
 void KeyButton(int key, bool down, bool shift, bool control) {
     if (down == GLFW_PRESS) {
-        switch (key) {
-            case GLFW_KEY_P:
-                PlaySound(TEXT("RoadNet/Sounds/click_x.wav"), NULL, SND_FILENAME | SND_ASYNC);
-                GLOBAL_PAUSE = !GLOBAL_PAUSE;
-                GLOBAL_EVENT_LABEL = "PLAY_EVT";
-                if (GLOBAL_PAUSE) {
-                    GLOBAL_EVENT_LABEL = "PAUSE_EVT";
-                }
-                break;
-            case GLFW_KEY_SPACE:
-                PlaySound(TEXT("RoadNet/Sounds/click_x.wav"), NULL, SND_FILENAME | SND_ASYNC);
-                GLOBAL_PAUSE = !GLOBAL_PAUSE;
-                GLOBAL_EVENT_LABEL = "PLAY_EVT";
-                if (GLOBAL_PAUSE) {
-                    GLOBAL_EVENT_LABEL = "PAUSE_EVT";
-                }
-                break;
-            case GLFW_KEY_D:
-                PlaySound(TEXT("RoadNet/Sounds/click_x.wav"), NULL, SND_FILENAME | SND_ASYNC);
-                if (GLOBAL_GAMEPLAY_STATE == WIPE_STATE) {
-                    GLOBAL_GAMEPLAY_STATE = DRAW_STATE;
-                } else {
-                    GLOBAL_GAMEPLAY_STATE = WIPE_STATE;
-                }
-                break;
-            case GLFW_KEY_W:
-                PlaySound(TEXT("RoadNet/Sounds/click_x.wav"), NULL, SND_FILENAME | SND_ASYNC);
-                GLOBAL_GAMEPLAY_STATE = WIPE_STATE;
-                break;
-            case GLFW_KEY_B:
-                PlaySound(TEXT("RoadNet/Sounds/click_x.wav"), NULL, SND_FILENAME | SND_ASYNC);
-                GLOBAL_DRAW_BORDERS = !GLOBAL_DRAW_BORDERS;
+        if (key == GLFW_KEY_L) {
+            RENDER_STRESS = !RENDER_STRESS;
+        }
+#ifdef ROADREALM_FRAME_PROFILER
+        if (key == GLFW_KEY_O) {
+            PROFILE_OVERLAY = !PROFILE_OVERLAY;
+        }
+#endif
+        InputEvent event;
+        event.timeUs = InputTimestamp();
+        event.type = INPUT_KEY;
+        event.key = (uint16_t) key;
+        INPUT_EVENTS.Push(event);
+    }
+}
 
-                GLOBAL_EVENT_LABEL = "BORDER_DISP_EVT";
-                break;
+/**
+ * PublishRenderSnapshot() Copy Everything The Renderer Draws Into The Next Snapshot And Publish It
+ *
+ * @param gridPrimitive GridPrimitive
+ */
+void PublishRenderSnapshot(GridPrimitive &gridPrimitive) {
+    RenderSnapshot &snapshot = RENDER_SNAPSHOTS.WriteSlot();
+    snapshot.appState = APPLICATION_STATE;
+    snapshot.paused = GLOBAL_PAUSE;
+    snapshot.gameOver = GAME_OVER;
+    snapshot.drawBorders = GLOBAL_DRAW_BORDERS;
+    snapshot.trafficMode = TRAFFIC_MODE;
+    snapshot.fontScale = APPLICATION_STATE == STARTING_MENU ? 13.0f : 12.0f;
+    snapshot.maxDiameter = MAX_DIAMETER_SIZE;
+    snapshot.bestRecord = RECORDS.Best();
+
+    snapshot.SyncCells(gridPrimitive);
+    snapshot.depots.clear();
+    snapshot.runners.clear();
+    snapshot.runnerCodes.clear();
+    snapshot.previewPath.clear();
+    snapshot.trafficDots.clear();
+
+    if (APPLICATION_STATE == GAME_STATE) {
+        // Pulse Animation Advances Once Per Unconnected Depot, as it did when the grid drew itself
+        for (const Node &cell: gridPrimitive.gridNodes) {
+            if (cell.currentState == CLOSED_HOUSE || cell.currentState == CLOSED_FACTORY) {
+                snapshot.depots.push_back({CombineDigits(cell.currentPos.row, cell.currentPos.col),
+                                           GetCirDiam(!cell.isConnected)});
+            }
+        }
+        for (auto &runnerLinkers: ROAD_RUNNERS) {
+            const Vehicle &runner = runnerLinkers.second.vehicleRunner;
+            snapshot.AddRunner(runner.pathId, runner.runnerPath, runner.t, runner.overlayColor);
+        }
+        snapshot.previewPath.assign(DRAG_PREVIEW_PATH.begin(), DRAG_PREVIEW_PATH.end());
+        snapshot.previewColor = DRAG_PREVIEW_COLOR;
+        if (TRAFFIC_MODE) {
+            TRAFFIC.CollectDots(snapshot.trafficDots);
         }
     }
+
+    // Labels Travel With Their Revisions, the renderer compares those with what it last drew
+    snapshot.labels = infoPanel;
+    RENDER_SNAPSHOTS.Publish();
+}
+
+#ifdef ROADREALM_FRAME_PROFILER
+/**
+ * DrawProfileOverlay() Frame Times And The Zones With The Most Self Time Over The Last Second, at the board's top left
+ *
+ * @param list DrawList Batch For The Backing Panel, flushed here so the labels draw over it
+ * @param texts TextBatch Receiving The Lines, drawn by the caller
+ */
+void DrawProfileOverlay(DrawList &list, TextBatch &texts) {
+    const ProfileSummary &summary = FrameProfiler::Summary();
+    int lines = summary.zoneCount + 1;
+    int top = Y_POS + GLOBAL_H;
+    list.Rectangle((float) X_POS, (float) (top - (lines + 1) * PROFILE_OVERLAY_LINE), PROFILE_OVERLAY_WIDTH,
+                   (float) ((lines + 1) * PROFILE_OVERLAY_LINE), BLACK, .7f);
+    list.Flush();
+
+    // Letters Only Has Letters, Digits And A Few Marks, so no colons or percent signs
+    int y = top - PROFILE_OVERLAY_LINE;
+    Text(texts, X_POS + 6, y, summary.slowFrames > 0 ? RED : GREEN, 10.0f, "Frame %.2f ms avg %.2f max %d slow",
+         summary.frameMeanMs, summary.frameMaxMs, summary.slowFrames);
+    for (int i = 0; i < summary.zoneCount; i++) {
+        const ProfileZoneStat &zone = summary.zones[i];
+        y -= PROFILE_OVERLAY_LINE;
+        Text(texts, X_POS + 6, y, WHITE, 10.0f, "%s %.2f ms/s max %.2f ms", zone.name, zone.selfMsPerSecond,
+             zone.maxMs);
+    }
 }
+#endif
 
-void Display(GridPrimitive gridPrimitive) {
+void Display(const RenderSnapshot &snapshot) {
+    ALLOC_ZONE(ALLOC_ZONE_DISPLAY);
+    PROFILE_ZONE("Display");
     glClearColor(0, 0, 0, 1);
     glClear(GL_COLOR_BUFFER_BIT);
     glEnable(GL_BLEND);
@@ -518,65 +920,225 @@ void Display(GridPrimitive gridPrimitive) {
 
     UseDrawShader(ScreenMode());
 
-    if (APPLICATION_STATE == STARTING_MENU) {
-        FONT_SCALE = 13.0f;
-
+    if (snapshot.appState == STARTING_MENU) {
         backGround.Display();
         myStartButton.Display();
         myQuitButton.Display();
 
         // Best record
-        double bestRecord = getBestRecord();
-        if (bestRecord != 0.0) {
-            chrono::duration<double> longestDuration(bestRecord);
-            Text(GLOBAL_W / 2 - 95, GLOBAL_H / 2 + 50, BLACK, FONT_SCALE,
-                 ("BEST RECORD: " + formatDuration(longestDuration)).c_str());
+        if (snapshot.bestRecord != 0.0) {
+            chrono::duration<double> longestDuration(snapshot.bestRecord);
+            Text(GLOBAL_W / 2 - 95, GLOBAL_H / 2 + 50, BLACK, snapshot.fontScale, "BEST RECORD: %s",
+                 formatDuration(longestDuration).c_str());
         } else {
-            Text(GLOBAL_W / 2 - 95, GLOBAL_H / 2 + 50, BLACK, FONT_SCALE, "BEST RECORD: 00H00M00S");
+            Text(GLOBAL_W / 2 - 95, GLOBAL_H / 2 + 50, BLACK, snapshot.fontScale, "BEST RECORD: 00H00M00S");
         }
 
-        if (GAME_OVER) {
+        if (snapshot.gameOver) {
             Text(GLOBAL_W / 2 - 85, GLOBAL_H / 2 + 100, RED, 30.0f, "Game Over");
-            infoPanel.AddMessage(COUNTDOWN, " ", WHITE);
         }
     }
-    if (APPLICATION_STATE == GAME_STATE) {
-        if (gameClock.count() < 0.05) {
-            PlaySound(TEXT("RoadNet/Sounds/call_to_arms.wav"), NULL, SND_FILENAME | SND_ASYNC);
-        }
-        FONT_SCALE = 12.0f;
+    if (snapshot.appState == GAME_STATE) {
         myResetButton.Display();
         myExitButton.Display();
         myClearButton.Display();
-        if (GLOBAL_PAUSE) {
+        if (snapshot.paused) {
             myPauseButton.Display();
         } else {
             myResumeButton.Display();
         }
 
-        gridPrimitive.DrawGrid();
+        // Board Layer: cells in one quad, then depots and factory crosses in one batch
+        DrawSnapshotGrid(BOARD_GRID, BOARD_DRAWS, snapshot);
+        for (int pass = 1; RENDER_STRESS && pass < RENDER_STRESS_PASSES; pass++) {
+            DrawSnapshotGrid(BOARD_GRID, BOARD_DRAWS, snapshot);
+        }
+        BOARD_DRAWS.Flush();
 
-        for (auto &runnerLinkers: ROAD_RUNNERS) {
-            string runnerDrawLog;
-            runnerLinkers.second.vehicleRunner.Draw(runnerDrawLog);
+        // Road Layer: preview, runner roads and dots, borders, drawn over the board
+        if (!snapshot.previewPath.empty()) {
+            DrawPath(BOARD_DRAWS, snapshot.previewPath, 1.5f, snapshot.previewColor);
+            BOARD_DRAWS.Flush();
         }
-        if (GLOBAL_DRAW_BORDERS) {
-            DrawBorders();
+        DrawSnapshotRunners(RUNNER_PATHS, BOARD_DRAWS, snapshot);
+        if (snapshot.drawBorders) {
+            DrawBorders(BOARD_DRAWS);
         }
-        stringstream stream;
-        stream << fixed << setprecision(3) << countDown;
-        string countDownFormatted = stream.str();
+        BOARD_DRAWS.Flush();
+    }
 
-        if (countDown < 5.0f) {
-            infoPanel.AddMessage(COUNTDOWN, "Countdown: " + countDownFormatted + "S", RED);
-        } else {
-            infoPanel.AddMessage(COUNTDOWN, "Countdown: " + countDownFormatted + "S", GREEN);
+    snapshot.labels.InfoDisplay(PANEL_TEXT, snapshot.fontScale, snapshot.appState);
+#ifdef ROADREALM_FRAME_PROFILER
+    if (PROFILE_OVERLAY) {
+        DrawProfileOverlay(BOARD_DRAWS, PANEL_TEXT);
+    }
+#endif
+    PANEL_TEXT.Flush(ScreenMode());
+
+    glFlush();
+}
+
+/**
+ * SimulationTick() Apply One Tick's Input, advance the game and publish what the renderer draws
+ *
+ * @param gridPrimitive GridPrimitive
+ * @param lastTickUs Unsigned Input Clock Time Of The Previous Tick, advanced to this tick
+ * @param tickTimeUs Unsigned Input Clock Time Of This Tick, unless a replay supplies it
+ */
+void SimulationTick(GridPrimitive &gridPrimitive, uint32_t &lastTickUs, uint32_t tickTimeUs) {
+    PROFILE_ZONE("SimTick");
+
+    // Time Step Comes From Tick Stamps, so a replay steps exactly like its recording
+    bool replaying = INPUT_REPLAY.IsOpen();
+    DrainInputEvents(tickTimeUs);
+    if (replaying && !INPUT_REPLAY.IsOpen()) {
+        // Live Clock Resumes Where The Recording Ended
+        lastTickUs = tickTimeUs;
+    }
+    float dt = ElapsedSeconds(lastTickUs, tickTimeUs);
+    lastTickUs = tickTimeUs;
+    Update(gridPrimitive, dt);
+
+    if (APPLICATION_STATE == GAME_STATE) {
+        RefreshDragPreview(gridPrimitive);
+        ToggleDraggedCellsStates(gridPrimitive);
+        ResetGameState(gridPrimitive);
+    }
+    PublishRenderSnapshot(gridPrimitive);
+}
+
+/**
+ * SimulationLoop() Simulation Thread Body, ticks at SIM_TICK_RATE regardless of how long frames take to draw
+ *
+ * @param startTimeUs Unsigned Input Clock Time The First Tick Is Measured From
+ */
+void SimulationLoop(uint32_t startTimeUs) {
+    using SimClock = chrono::steady_clock;
+    const SimClock::duration tickPeriod = chrono::duration_cast<SimClock::duration>(
+            chrono::duration<double>(1.0 / SIM_TICK_RATE));
+
+#ifdef _WIN32
+    // Finer Sleep Granularity For Steady Ticks
+    timeBeginPeriod(1);
+#endif
+    PROFILE_THREAD("Simulation");
+    ALLOC_THREAD(ALLOC_THREAD_SIMULATION);
+    GridPrimitive gridPrimitive;
+    SimClock::time_point nextTick = SimClock::now();
+    uint32_t lastTickUs = startTimeUs;
+    while (SIM_RUNNING) {
+        SimClock::time_point tickStart = SimClock::now();
+        if (NULL_GL_FRAMES > 0 && !INPUT_REPLAY.IsOpen()) {
+            HEADLESS_PLAYER.Step(gridPrimitive, INPUT_EVENTS, InputTimestamp());
         }
+        FRAME_ARENA.Reset();
+        SimulationTick(gridPrimitive, lastTickUs, InputTimestamp());
+        ALLOC_TELEMETRY_END_FRAME();
+        SIM_TICK_STATS.Record(SimClock::now() - tickStart, tickStart - nextTick);
+
+        // Skip Missed Ticks Rather Than Bursting To Catch Up
+        nextTick = max(nextTick + tickPeriod, SimClock::now());
+        this_thread::sleep_until(nextTick);
     }
+#ifdef _WIN32
+    timeEndPeriod(1);
+#endif
+}
 
-    infoPanel.InfoDisplay(FONT_SCALE);
+/**
+ * RunNullGLBench() Draw Frames Headless On The Null GL Driver, then report what each frame asked of the driver
+ * The simulation runs on this thread in lockstep, one tick of 1/SIM_TICK_RATE seconds before each frame, so the
+ * frames of a replay do not depend on how fast the machine draws them. With --sim-thread the simulation thread ticks
+ * in real time instead and frames are drawn as fast as they can be until as many ticks are due.
+ *
+ * @param frames Integer Frame Count, or tick count with --sim-thread
+ * @param startTimeUs Unsigned Input Clock Time The First Tick Is Measured From
+ * @return Boolean Condition, false if a --sim-thread run passed its tick bounds
+ */
+bool RunNullGLBench(int frames, uint32_t startTimeUs) {
+    using BenchClock = chrono::steady_clock;
+    const uint32_t tickUs = 1000000 / SIM_TICK_RATE;
+    GridPrimitive gridPrimitive;
+    uint32_t lastTickUs = startTimeUs;
+    RenderBench bench;
+    BenchClock::time_point start = BenchClock::now();
+    thread simulationThread;
+    if (NULL_GL_SIM_THREAD) {
+        simulationThread = thread(SimulationLoop, startTimeUs);
+    }
+    const BenchClock::time_point end = start + chrono::duration_cast<BenchClock::duration>(
+            chrono::duration<double>((double) frames / SIM_TICK_RATE));
+    for (int frame = 0; NULL_GL_SIM_THREAD ? BenchClock::now() < end : frame < frames; frame++) {
+        if (!NULL_GL_SIM_THREAD) {
+            uint32_t tickTimeUs = startTimeUs + (uint32_t) (frame + 1) * tickUs;
+            if (!INPUT_REPLAY.IsOpen()) {
+                HEADLESS_PLAYER.Step(gridPrimitive, INPUT_EVENTS, tickTimeUs);
+            }
+            {
+                ALLOC_THREAD(ALLOC_THREAD_SIMULATION);
+                FRAME_ARENA.Reset();
+                SimulationTick(gridPrimitive, lastTickUs, tickTimeUs);
+                ALLOC_TELEMETRY_END_FRAME();
+            }
+#ifdef ROADREALM_ALLOC_TELEMETRY
+            const AllocFrameRecord &tickAllocs = AllocTelemetry::LastFrame();
+            if (tickAllocs.frameIndex >= ALLOC_WARMUP_FRAMES && tickAllocs.TotalAllocations() > ALLOC_FRAME_BUDGET) {
+                printf("tick %u allocated:", tickAllocs.frameIndex);
+                for (int zone = 0; zone < ALLOC_ZONE_COUNT; zone++) {
+                    if (tickAllocs.allocations[zone] > 0) {
+                        printf(" %s %u", AllocTelemetry::ZoneName(zone), tickAllocs.allocations[zone]);
+                    }
+                }
+                printf("\n");
+            }
+#endif
+        }
 
-    glFlush();
+        ASSETS.Pump();
+        const RenderSnapshot &snapshot = RENDER_SNAPSHOTS.Acquire();
+        RENDER_APP_STATE = snapshot.appState;
+        bench.BeginFrame();
+        Display(snapshot);
+        VertexStream().EndFrame();
+        bench.EndFrame();
+        PROFILE_END_FRAME();
+        ALLOC_TELEMETRY_END_FRAME();
+
+        NUM_OF_FRAMES += 1;
+        FRAMES_PER_SECONDS.store(NUM_OF_FRAMES / chrono::duration<double>(BenchClock::now() - start).count(),
+                                 memory_order_relaxed);
+    }
+    if (simulationThread.joinable()) {
+        SIM_RUNNING = false;
+        simulationThread.join();
+    }
+    bench.PrintSummary(stdout);
+    if (HEADLESS_PLAYER.LinkDrags() > 0) {
+        printf("\nheadless player dragged %d roads to link and %d to wipe, %zu linked at the end\n",
+               HEADLESS_PLAYER.LinkDrags(), HEADLESS_PLAYER.WipeDrags(), ROAD_RUNNERS.size());
+    }
+    if (bench.ExportCsv(RENDER_BENCH_PATH)) {
+        printf("\nper-frame metrics written to %s\n", RENDER_BENCH_PATH);
+    }
+    bool withinMaximums = true;
+    if (RENDER_BENCH_MAX_PATH != nullptr) {
+        printf("\n");
+        withinMaximums = bench.CheckMaximums(RENDER_BENCH_MAX_PATH, stdout);
+    }
+#ifdef ROADREALM_ALLOC_TELEMETRY
+    printf("\nsimulation ticks over the allocation budget (%d) after %d warm-up ticks: %u of %u\n", ALLOC_FRAME_BUDGET,
+           ALLOC_WARMUP_FRAMES, AllocTelemetry::BudgetViolations(), AllocTelemetry::FramesRecorded());
+#endif
+    if (!NULL_GL_SIM_THREAD) {
+        return withinMaximums;
+    }
+    TickSummary ticks = SIM_TICK_STATS.Summary();
+    bool withinBounds = ticks.p99WorkMs <= SIM_STRESS_MAX_WORK_MS && ticks.p99LateMs <= SIM_STRESS_MAX_LATE_MS;
+    printf("\n%u simulation ticks%s: mean %.3f ms, p99 %.3f ms (bound %.1f), max %.3f ms, p99 late %.3f ms (bound %.1f)"
+           " over the last %d\n", ticks.ticks, RENDER_STRESS ? " under render stress" : "", ticks.meanWorkMs,
+           ticks.p99WorkMs, SIM_STRESS_MAX_WORK_MS, ticks.maxWorkMs, ticks.p99LateMs, SIM_STRESS_MAX_LATE_MS,
+           SIM_STATS_WINDOW);
+    return withinMaximums && withinBounds;
 }
 
 void UpdateAppVariables(int width, int height) {
@@ -592,25 +1154,68 @@ void UpdateAppVariables(int width, int height) {
 }
 
 void Resize(int width, int height) {
-    glViewport(0, 0, width, height);
+    SetViewport(0, 0, width, height);
     UpdateAppVariables(width, height);
+
+    InputEvent event;
+    event.timeUs = InputTimestamp();
+    event.type = INPUT_RESIZE;
+    event.col = (int16_t) ((int) DX - 1);
+    event.row = (int16_t) ((int) DY - 1);
+    INPUT_EVENTS.Push(event);
     glFlush();
 }
 
 int main(int ac, char **av) {
-    myResetButton.Initialize("RoadNet/Images/resetButton.png");
-    myExitButton.Initialize("RoadNet/Images/exitButton.png");
-    myStartButton.Initialize("RoadNet/Images/startButton.png");
-    myQuitButton.Initialize("RoadNet/Images/quitButton.png");
-    backGround.Initialize("RoadNet/Images/background.jpg");
-    myPauseButton.Initialize("RoadNet/Images/pauseButton.png");
-    myResumeButton.Initialize("RoadNet/Images/resumeButton.png");
-    myClearButton.Initialize("RoadNet/Images/clearButton.png");
-
-    RegisterMouseButton(MouseButton);
-    RegisterMouseMove(MouseMove);
-    RegisterResize(Resize);
-    RegisterKeyboard(KeyButton);
+    const char *recordPath = nullptr, *replayPath = nullptr;
+    for (int i = 1; i < ac; i++) {
+        bool hasValue = i + 1 < ac;
+        if (strcmp(av[i], "--record") == 0 && hasValue) {
+            recordPath = av[++i];
+        } else if (strcmp(av[i], "--replay") == 0 && hasValue) {
+            replayPath = av[++i];
+        } else if (strcmp(av[i], "--nullgl") == 0 && hasValue) {
+            NULL_GL_FRAMES = max(1, atoi(av[++i]));
+        } else if (strcmp(av[i], "--bench-csv") == 0 && hasValue) {
+            RENDER_BENCH_PATH = av[++i];
+        } else if (strcmp(av[i], "--bench-max") == 0 && hasValue) {
+            RENDER_BENCH_MAX_PATH = av[++i];
+        } else if (strcmp(av[i], "--sim-thread") == 0) {
+            NULL_GL_SIM_THREAD = true;
+        } else if (strcmp(av[i], "--render-stress") == 0) {
+            RENDER_STRESS = true;
+        }
+    }
+    if (NULL_GL_FRAMES > 0) {
+        // No Window Or GPU, the stubs answer every GL call the game makes
+        LoadNullGL();
+        Resize(APP_WIDTH, APP_HEIGHT);
+    } else {
+        w = InitGLFW(100, 100, APP_WIDTH, APP_HEIGHT, "RoadRealm");
+        RegisterMouseButton(MouseButton);
+        RegisterMouseMove(MouseMove);
+        RegisterResize(Resize);
+        RegisterKeyboard(KeyButton);
+    }
+
+    // UI Images Come From The Packed Atlas, decoding them in the background only if the bundle was not built
+    struct {
+        Sprite *sprite;
+        const char *region, *file;
+    } uiImages[] = {{&myResetButton,  "resetButton",  "RoadNet/Images/resetButton.png"},
+                    {&myExitButton,   "exitButton",   "RoadNet/Images/exitButton.png"},
+                    {&myStartButton,  "startButton",  "RoadNet/Images/startButton.png"},
+                    {&myQuitButton,   "quitButton",   "RoadNet/Images/quitButton.png"},
+                    {&backGround,     "background",   "RoadNet/Images/background.jpg"},
+                    {&myPauseButton,  "pauseButton",  "RoadNet/Images/pauseButton.png"},
+                    {&myResumeButton, "resumeButton", "RoadNet/Images/resumeButton.png"},
+                    {&myClearButton,  "clearButton",  "RoadNet/Images/clearButton.png"}};
+    UI_ATLAS.Load(UI_ATLAS_BUNDLE);
+    for (auto &image: uiImages) {
+        if (!UI_ATLAS.Apply(*image.sprite, image.region)) {
+            ASSETS.Load(*image.sprite, image.file);
+        }
+    }
 
     // Starting Menu Buttons Transformation
     myStartButton.SetScale(vec2(.2f, .2f));
@@ -634,24 +1239,72 @@ int main(int ac, char **av) {
     myClearButton.SetScale(vec2(.1f, .1f));
     myClearButton.SetPosition(vec2(.7f, -.25f));
 
-    INIT_FPS_TIME = glfwGetTime();
-    PlaySound(TEXT("RoadNet/Sounds/program_start.wav"), NULL, SND_FILENAME | SND_ASYNC);
-    GridPrimitive gridPrimitive;
-    while (!glfwWindowShouldClose(w)) {
-        Update(gridPrimitive);
-
-        FRAMES_PER_SECONDS = NUM_OF_FRAMES / (glfwGetTime() - INIT_FPS_TIME);
+    if (w != nullptr) {
+        INIT_FPS_TIME = glfwGetTime();
+    }
+    AUDIO.Start();
+    AUDIO.Play(SOUND_PROGRAM_START);
+
+    // Seed And Clock Origin Come From The Recording When Replaying, so the game unfolds identically
+    uint32_t gameSeed = random_device()(), startTimeUs = InputTimestamp();
+    if (replayPath != nullptr && INPUT_REPLAY.Open(replayPath)) {
+        gameSeed = INPUT_REPLAY.Header().seed;
+        startTimeUs = INPUT_REPLAY.Header().startTimeUs;
+    }
+    if (recordPath != nullptr) {
+        INPUT_RECORDER.Open(recordPath, gameSeed, startTimeUs);
+    }
+    GAME_RNG.seed(gameSeed);
+    RECORDS.Load();
+    // Drag State Sized For A Road Across Every Cell, so dragging never allocates mid-game
+    PREV_DRAGGED_CELLS.reserve(NROWS * NCOLS);
+    DRAG_PREVIEW_PATH.reserve(NROWS * NCOLS);
+    DRAG_BLOCKED_CELLS.reserve(NROWS * NCOLS);
+    DRAG_PLANNER.Reserve(NROWS * NCOLS);
+    TRAFFIC.Reserve(SNAPSHOT_MAX_TRAFFIC_DOTS);
+
+    PROFILE_THREAD("Render");
+    ALLOC_THREAD(ALLOC_THREAD_RENDER);
+    thread simulationThread;
+    bool benchPassed = true;
+    if (NULL_GL_FRAMES > 0) {
+        benchPassed = RunNullGLBench(NULL_GL_FRAMES, startTimeUs);
+    } else {
+        simulationThread = thread(SimulationLoop, startTimeUs);
+    }
+    while (w != nullptr && !glfwWindowShouldClose(w)) {
+        FRAMES_PER_SECONDS.store(NUM_OF_FRAMES / (glfwGetTime() - INIT_FPS_TIME), memory_order_relaxed);
 
-        Display(gridPrimitive);
+        // Renderer Only Reads The Latest Published Snapshot, never the live grid
+        ASSETS.Pump();
+        const RenderSnapshot &snapshot = RENDER_SNAPSHOTS.Acquire();
+        RENDER_APP_STATE = snapshot.appState;
+        Display(snapshot);
 
         NUM_OF_FRAMES += 1;
 
-        if (APPLICATION_STATE == GAME_STATE) {
-            ToggleDraggedCellsStates(gridPrimitive);
-            ResetGameState(gridPrimitive);
+        // Fence This Frame's Streamed Vertices, the next frame writes another segment
+        VertexStream().EndFrame();
+        {
+            PROFILE_ZONE("SwapBuffers");
+            glfwSwapBuffers(w);
         }
-
-        glfwSwapBuffers(w);
         glfwPollEvents();
+        PROFILE_END_FRAME();
+        ALLOC_TELEMETRY_END_FRAME();
+    }
+    SIM_RUNNING = false;
+    if (simulationThread.joinable()) {
+        simulationThread.join();
     }
-}
\ No newline at end of file
+    ASSETS.Stop();
+    RECORDS.Stop();
+    AUDIO.Stop();
+#ifdef ROADREALM_ALLOC_TELEMETRY
+    // Headless Runs Fail When A Steady-State Tick Allocated, so a test catches a new per-tick allocation
+    if (NULL_GL_FRAMES > 0 && AllocTelemetry::BudgetViolations() > 0) {
+        return 1;
+    }
+#endif
+    return benchPassed ? 0 : 1;
+}
@@ -7,12 +7,22 @@
 #ifndef ROADREALM_ROADNETSHARED_H
 #define ROADREALM_ROADNETSHARED_H
 
+#include <array>
+#include <charconv>
+#include <cstring>
 #include <iostream>
+#include <span>
+#include <string_view>
 #include <vector>
 #include "Draw.h"
+#include "DrawList.h"
 #include <string>
 #include <random>
 #include "GLXtras.h"
+#include "AllocTelemetry.h"
+#include "FrameProfiler.h"
+#include "PathCodec.h"
+#include "FrameArena.h"
 
 using namespace std;
 
@@ -20,7 +30,8 @@ using namespace std;
 #define NCOLS 14
 #define H_EDGE_BUFFER 40
 #define W_EDGE_BUFFER 100
-#define INFO_MSG_SIZE 12
+#define INFO_MSG_SIZE 15
+#define INFO_MSG_CAPACITY 48
 #define NUM_OF_RND_VAL 5
 #define PAIR_GENERATION_RETRY 4
 
@@ -48,7 +59,10 @@ enum InfoLabelsIndex {
     ERROR_MSG_LABEL = 8,
     RUNNERS_COUNT_LABEL = 9,
     COUNTDOWN = 10,
-    EVT_MSG_LABEL = 11
+    EVT_MSG_LABEL = 11,
+    TRAFFIC_LABEL = 12,
+    ALLOC_LABEL = 13,
+    SIM_TICK_LABEL = 14
 };
 
 int APP_WIDTH = 1000, APP_HEIGHT = 800, X_POS = 20, Y_POS = 20,
@@ -66,6 +80,25 @@ GameplayState GLOBAL_GAMEPLAY_STATE = DRAW_STATE;
 ApplicationStates APPLICATION_STATE = STARTING_MENU;
 string GLOBAL_EVENT_LABEL;
 bool REDUCE_DIAMETER = true;
+// Gameplay Randomness, seeded once so a recorded input stream replays the same game
+mt19937 GAME_RNG;
+
+/**
+ * @struct LabelFixed
+ * @details Fixed-Point Label Argument, formatted with the given number of decimals
+ */
+struct LabelFixed {
+    double value;
+    int precision;
+};
+
+/**
+ * @struct LabelDuration
+ * @details Duration Label Argument, formatted as 00H00M00S
+ */
+struct LabelDuration {
+    int totalSeconds;
+};
 
 /**
  * @class InfoPanel
@@ -76,54 +109,112 @@ private:
 
     /**
      * @struct Message
-     * @details An Information System's Message Representation
+     * @details An Information System's Message Representation, held inline so updating a label never allocates
      */
     struct Message {
-        string msgInfo;
+        char msgInfo[INFO_MSG_CAPACITY] = {};
+        uint8_t msgLength = 0;
         vec3 msgColor = WHITE;
+        // Bumped Whenever The Text Or Color Changes
+        uint32_t msgRevision = 0;
 
         /**
-         * Message() Default  Struct Constructor For Message Instance
-         * @param info String Information
-         * @param color Vec3 Color
+         * Info() View Of The Message Text
+         * @return String View
          */
-        Message(string info, const vec3 &color) {
-            this->msgInfo = info;
-            this->msgColor = color;
-        }
+        string_view Info() const { return {msgInfo, msgLength}; }
     };
 
     // Message Collection
-    vector<Message> generalMsgInfo = {};
+    array<Message, INFO_MSG_SIZE> generalMsgInfo = {};
 
-public:
     /**
-     * InfoPanel() Default Constructor For a InfoPanel Instance.
+     * AppendPart() Append A Label Argument To A Character Buffer, arguments which do not fit are dropped
+     *
+     * @param out Char Pointer Write Position
+     * @param end Char Pointer Buffer End
+     * @param part Label Argument
+     * @return Char Pointer Next Write Position
      */
-    InfoPanel() {
-        for (int i = 0; i < INFO_MSG_SIZE; i++) {
-            generalMsgInfo.push_back(Message("", WHITE));
+    static char *AppendPart(char *out, char *end, string_view part) {
+        size_t count = min(part.size(), (size_t) (end - out));
+        memcpy(out, part.data(), count);
+        return out + count;
+    }
+
+    template<typename T> requires is_integral_v<T>
+    static char *AppendPart(char *out, char *end, T part) {
+        to_chars_result result = to_chars(out, end, part);
+        return result.ec == errc() ? result.ptr : out;
+    }
+
+    static char *AppendPart(char *out, char *end, LabelFixed part) {
+        to_chars_result result = to_chars(out, end, part.value, chars_format::fixed, part.precision);
+        return result.ec == errc() ? result.ptr : out;
+    }
+
+    static char *AppendPart(char *out, char *end, LabelDuration part) {
+        int fields[3] = {(part.totalSeconds / 3600) % 100, (part.totalSeconds % 3600) / 60, part.totalSeconds % 60};
+        const char units[3] = {'H', 'M', 'S'};
+        for (int i = 0; i < 3 && end - out >= 3; i++) {
+            *out++ = (char) ('0' + fields[i] / 10);
+            *out++ = (char) ('0' + fields[i] % 10);
+            *out++ = units[i];
         }
+        return out;
     }
 
     /**
-     * InfoDisplay() Display Function For InfoPanel
+     * StoreMessage() Replace A Label, bumping its revision only if its text or color changed
      *
+     * @param labelsIndex Type Of Message Label
+     * @param msg String View Information
+     * @param msgColor Vec3 Color
+     * @return Boolean Condition, true if the label changed
+     */
+    bool StoreMessage(InfoLabelsIndex labelsIndex, string_view msg, const vec3 &msgColor) {
+        Message &message = generalMsgInfo.at(labelsIndex);
+        msg = msg.substr(0, INFO_MSG_CAPACITY - 1);
+        bool sameColor = message.msgColor.x == msgColor.x && message.msgColor.y == msgColor.y &&
+                         message.msgColor.z == msgColor.z;
+        if (sameColor && message.Info() == msg) {
+            return false;
+        }
+        memcpy(message.msgInfo, msg.data(), msg.size());
+        message.msgInfo[msg.size()] = '\0';
+        message.msgLength = (uint8_t) msg.size();
+        message.msgColor = msgColor;
+        message.msgRevision++;
+        return true;
+    }
+
+public:
+    /**
+     * InfoPanel() Default Constructor For a InfoPanel Instance.
+     */
+    InfoPanel() {}
+
+    /**
+     * InfoDisplay() Display Function For InfoPanel, labels are added to a batch drawn by the caller
+     *
+     * @param texts TextBatch Receiving The Labels
      * @param fontScale Float Font Size
+     * @param appState ApplicationStates State The Panel Is Drawn For
      */
-    void InfoDisplay(float fontScale) {
+    void InfoDisplay(TextBatch &texts, float fontScale, ApplicationStates appState) const {
+        ALLOC_ZONE(ALLOC_ZONE_INFO_PANEL);
         int maxHeight = GLOBAL_H;
-        if (APPLICATION_STATE != STARTING_MENU) {
-            for (Message &message: generalMsgInfo) {
-                Text(DISP_W + 5, maxHeight, message.msgColor, fontScale, message.msgInfo.c_str());
+        if (appState != STARTING_MENU) {
+            for (const Message &message: generalMsgInfo) {
+                Text(texts, DISP_W + 5, maxHeight, message.msgColor, fontScale, "%s", message.msgInfo);
 
                 maxHeight -= 20;
             }
         } else {
-            Text(DISP_W + 5, maxHeight, generalMsgInfo.at(FPS_LABEL).msgColor, fontScale,
-                 generalMsgInfo.at(FPS_LABEL).msgInfo.c_str());
-            Text(DISP_W + 5, maxHeight - 20, generalMsgInfo.at(APPLICATION_STATE_LABEL).msgColor, fontScale,
-                 generalMsgInfo.at(APPLICATION_STATE_LABEL).msgInfo.c_str());
+            Text(texts, DISP_W + 5, maxHeight, generalMsgInfo.at(FPS_LABEL).msgColor, fontScale, "%s",
+                 generalMsgInfo.at(FPS_LABEL).msgInfo);
+            Text(texts, DISP_W + 5, maxHeight - 20, generalMsgInfo.at(APPLICATION_STATE_LABEL).msgColor, fontScale, "%s",
+                 generalMsgInfo.at(APPLICATION_STATE_LABEL).msgInfo);
         }
 
     }
@@ -136,15 +227,50 @@ public:
      * @param msgColor Vec3 Color
      * @return Boolean Condition
      */
-    bool AddMessage(InfoLabelsIndex labelsIndex, const string &msg, const vec3 &msgColor) {
+    bool AddMessage(InfoLabelsIndex labelsIndex, string_view msg, const vec3 &msgColor) {
         if (!msg.empty()) {
-            // Add Message To Vector
-            generalMsgInfo.at(labelsIndex).msgInfo = msg;
-            generalMsgInfo.at(labelsIndex).msgColor = msgColor;
+            StoreMessage(labelsIndex, msg, msgColor);
             return true;
         }
         return false;
     }
+
+    /**
+     * SetLabel() Format A Label From Text, Integers, LabelFixed And LabelDuration Parts
+     *
+     * @param labelsIndex Type Of Message Label
+     * @param msgColor Vec3 Color
+     * @param parts Label Arguments, concatenated in order
+     * @return Boolean Condition, true if the label changed
+     */
+    template<typename... Parts>
+    bool SetLabel(InfoLabelsIndex labelsIndex, const vec3 &msgColor, const Parts &... parts) {
+        ALLOC_ZONE(ALLOC_ZONE_INFO_PANEL);
+        char buffer[INFO_MSG_CAPACITY];
+        char *out = buffer, *end = buffer + INFO_MSG_CAPACITY - 1;
+        ((out = AppendPart(out, end, parts)), ...);
+        return StoreMessage(labelsIndex, string_view(buffer, out - buffer), msgColor);
+    }
+
+    /**
+     * ChangedSince() Validate If A Label Changed Since A Panel The Reader Last Saw. Compared by revision rather than
+     * by flags cleared on publish, so changes in snapshots the renderer skipped are still seen.
+     *
+     * @param labelsIndex Type Of Message Label
+     * @param seen InfoPanel Copy Last Seen By The Reader
+     * @return Boolean Condition
+     */
+    bool ChangedSince(InfoLabelsIndex labelsIndex, const InfoPanel &seen) const {
+        return generalMsgInfo.at(labelsIndex).msgRevision != seen.generalMsgInfo.at(labelsIndex).msgRevision;
+    }
+
+    /**
+     * Revision() Change Counter Of A Label, usable as a cache key for its text geometry
+     *
+     * @param labelsIndex Type Of Message Label
+     * @return Unsigned Revision
+     */
+    uint32_t Revision(InfoLabelsIndex labelsIndex) const { return generalMsgInfo.at(labelsIndex).msgRevision; }
 };
 
 /**
@@ -232,18 +358,20 @@ struct NodePosition {
 
 /**
  * DrawBorders() Draw Layout Border
+ *
+ * @param list DrawList Batch To Append To
  */
-void DrawBorders() {
+void DrawBorders(DrawList &list) {
     // Top Line, (Top-Right -> Top-Left)
-    Line(vec2(GLOBAL_W, GLOBAL_H + (H_EDGE_BUFFER / 2) + 1), vec2(5, GLOBAL_H + (H_EDGE_BUFFER / 2) + 1), 1, WHITE);
+    list.Line(vec2(GLOBAL_W, GLOBAL_H + (H_EDGE_BUFFER / 2) + 1), vec2(5, GLOBAL_H + (H_EDGE_BUFFER / 2) + 1), 1, WHITE);
     // Left Line (Bottom-Left -> Top-Left)
-    Line(vec2(5, 5), vec2(5, GLOBAL_H + (H_EDGE_BUFFER / 2) + 1), 1, WHITE);
+    list.Line(vec2(5, 5), vec2(5, GLOBAL_H + (H_EDGE_BUFFER / 2) + 1), 1, WHITE);
     // Right Line (Top-Right -> Bottom-Right)
-    Line(vec2(GLOBAL_W, GLOBAL_H + (H_EDGE_BUFFER / 2) + 1), vec2(GLOBAL_W, 5), 1, WHITE);
+    list.Line(vec2(GLOBAL_W, GLOBAL_H + (H_EDGE_BUFFER / 2) + 1), vec2(GLOBAL_W, 5), 1, WHITE);
     // Mid Line, (Mid-Right, Mid-Left)
-    Line(vec2(DISP_W, GLOBAL_H + (H_EDGE_BUFFER / 2) + 1), vec2(DISP_W, 5), 1, WHITE);
+    list.Line(vec2(DISP_W, GLOBAL_H + (H_EDGE_BUFFER / 2) + 1), vec2(DISP_W, 5), 1, WHITE);
     // Bottom Line (Bottom-Left -> Bottom-Right)
-    Line(vec2(5, 5), vec2(GLOBAL_W, 5), 1, WHITE);
+    list.Line(vec2(5, 5), vec2(GLOBAL_W, 5), 1, WHITE);
 }
 
 /**
@@ -291,7 +419,7 @@ int GetDistance(const vec2 &firstPoint, const vec2 &secondPoint) {
  * @param dist Integer Distance
  * @param potentialLocations Locations Collection
  */
-void FindNeighbors(const vec2 &startingPoint, int dist, vector<vec2> &potentialLocations) {
+void FindNeighbors(const vec2 &startingPoint, int dist, pmr::vector<vec2> &potentialLocations) {
     for (int i = (int) startingPoint.y - dist; i <= (int) startingPoint.y + dist; i++) {
         for (int j = (int) startingPoint.x - dist; j <= (int) startingPoint.x + dist; j++) {
             if ((!(i == (int) startingPoint.y && j == (int) startingPoint.x))) {
@@ -309,12 +437,11 @@ void FindNeighbors(const vec2 &startingPoint, int dist, vector<vec2> &potentialL
  * @param numOfRndValues Integer Number Of Random Values
  * @param distribRndPlacement Vector Collective Holder
  */
-void GetRandomDistribution(int distribLimit, int numOfRndValues, vector<int> &distribRndPlacement) {
-    random_device generator;
+void GetRandomDistribution(int distribLimit, int numOfRndValues, pmr::vector<int> &distribRndPlacement) {
     uniform_int_distribution<int> distribution(0, distribLimit);
 
     for (int i = 0; i < numOfRndValues; i++) {
-        distribRndPlacement.push_back(distribution(generator));
+        distribRndPlacement.push_back(distribution(GAME_RNG));
     }
 }
 
@@ -326,17 +453,17 @@ void GetRandomDistribution(int distribLimit, int numOfRndValues, vector<int> &di
  * @param potentialVal Vector Collective Potential Values
  * @return Vec2 Point
  */
-vec2 GetRandomPoint(int numOfRndValues = NUM_OF_RND_VAL, int rndIndex = 0, const vector<vec2> &potentialVal = {}) {
-    vector<int> rndNodePoint = {};
+vec2 GetRandomPoint(int numOfRndValues = NUM_OF_RND_VAL, int rndIndex = 0, span<const vec2> potentialVal = {}) {
+    pmr::vector<int> rndNodePoint(FRAME_ARENA.Resource());
     GetRandomDistribution((NROWS * numOfRndValues), numOfRndValues, rndNodePoint);
 
     if (!potentialVal.empty()) {
         int getRndIndex = rndNodePoint.at(rndIndex) % potentialVal.size();
-        return potentialVal.at(getRndIndex);
+        return potentialVal[getRndIndex];
     }
 
-    vec2 rndPoint = vec2((rndNodePoint.at(rand() % (rndNodePoint.size() - 1)) % NCOLS),
-                         (rndNodePoint.at(rand() % (rndNodePoint.size() - 1)) % NROWS));
+    vec2 rndPoint = vec2((rndNodePoint.at(GAME_RNG() % (rndNodePoint.size() - 1)) % NCOLS),
+                         (rndNodePoint.at(GAME_RNG() % (rndNodePoint.size() - 1)) % NROWS));
     return rndPoint;
 }
 
@@ -349,7 +476,7 @@ vec2 GetRandomPoint(int numOfRndValues = NUM_OF_RND_VAL, int rndIndex = 0, const
 vec3 GetRandomColor(int stride = 1) {
     int maxColorShades = 255;
 
-    vector<int> rndDistribColors = {};
+    pmr::vector<int> rndDistribColors(FRAME_ARENA.Resource());
 
     GetRandomDistribution(maxColorShades, 3, rndDistribColors);
 
@@ -363,84 +490,102 @@ vec3 GetRandomColor(int stride = 1) {
 /**
  * DrawVertex() Draw a Vertex
  *
+ * @param list DrawList Batch To Append To
  * @param row Integer Row
  * @param col Integer Column
  */
-void DrawVertex(float row, float col) {
-    Disk(vec2(X_POS + (col + .5) * DX, Y_POS + (row + .5) * DY), 6, BLUE);
+void DrawVertex(DrawList &list, float row, float col) {
+    list.Disk(vec2(X_POS + (col + .5) * DX, Y_POS + (row + .5) * DY), 6, BLUE);
 }
 
 /**
  * DrawSegment() Draw a Segment
  *
+ * @param list DrawList Batch To Append To
  * @param i1 NodePosition Struct
  * @param i2 NodePosition Struct
  * @param width Float Width
  * @param col Vec3 Color
  */
-void DrawSegment(NodePosition i1, NodePosition i2, float width, vec3 col) {
-    Line(i1.Point(), i2.Point(), width, col, col);
+void DrawSegment(DrawList &list, NodePosition i1, NodePosition i2, float width, vec3 col) {
+    list.Line(i1.Point(), i2.Point(), width, col, col);
 }
 
 /**
  * DrawPath() Draw A Path
  *
+ * @param list DrawList Batch To Append To
  * @param path vector Collective Path
  * @param width Float Width
  * @param color Vec3 Color
  */
-void DrawPath(vector<NodePosition> &path, float width, vec3 color) {
+void DrawPath(DrawList &list, const vector<NodePosition> &path, float width, vec3 color) {
     for (size_t i = 1; i < path.size(); i++)
-        DrawSegment(path.at(i - 1), path.at(i), width, color);
+        DrawSegment(list, path.at(i - 1), path.at(i), width, color);
 }
 
 /**
  * DrawRectangle() Draw A Rectangle
  *
+ * @param list DrawList Batch To Append To
  * @param x Integer x
  * @param y Integer y
  * @param w Integer w
  * @param h Integer h
  * @param col vec3 Color
  */
-void DrawRectangle(int x, int y, int w, int h, vec3 col) {
-    Quad(x, y, x, y + h, x + w, y + h, x + w, y, true, col);
+void DrawRectangle(DrawList &list, int x, int y, int w, int h, vec3 col) {
+    list.Rectangle((float) x, (float) y, (float) w, (float) h, col);
+}
+
+/**
+ * DrawPath() Draw An Encoded Path, one segment per straight stretch
+ *
+ * @param list DrawList Batch To Append To
+ * @param path PathView Encoded Path
+ * @param width Float Width
+ * @param color Vec3 Color
+ */
+void DrawPath(DrawList &list, const PathView &path, float width, vec3 color) {
+    path.ForEachRun([&](int fromRow, int fromCol, int toRow, int toCol, int /*steps*/) {
+        DrawSegment(list, NodePosition(fromRow, fromCol), NodePosition(toRow, toCol), width, color);
+    });
 }
 
 /**
  * PathLength() Find Path length
  *
- * @param path vector collective path
+ * @param path PathView Encoded Path
  * @return Float Length
  */
-float PathLength(vector<NodePosition> &path) {
-    float len = 0;
-    for (size_t i = 1; i < path.size(); i++)
-        len += path[i].DistanceTo(path[i - 1]);
-    return len;
+float PathLength(const PathView &path) {
+    // Encoded Paths Only Hold Unit Steps
+    return path.empty() ? 0 : (float) (path.size() - 1);
 }
 
 /**
  * PointOnPath() Find Point On Path
  *
  * @param dist Float Dist
- * @param path vector collective path
+ * @param path PathView Encoded Path
  * @return vec2 Point
  */
-vec2 PointOnPath(float dist, vector<NodePosition> &path) {
+vec2 PointOnPath(float dist, const PathView &path) {
     float accumDist = 0;
-    NodePosition i1 = path[0];
-    for (size_t i = 1; i < path.size(); i++) {
-        NodePosition i2 = path[i];
-        float d = i1.DistanceTo(i2);
-        accumDist += d;
+    bool found = false;
+    vec2 point = vec2(path.endCol, path.endRow);
+    path.ForEachRun([&](int fromRow, int fromCol, int toRow, int toCol, int steps) {
+        if (found) {
+            return;
+        }
+        accumDist += (float) steps;
         if (accumDist >= dist) {
-            float alpha = (accumDist - dist) / d;
-            return vec2(i2.col + alpha * (i1.col - i2.col), i2.row + alpha * (i1.row - i2.row));
+            float alpha = (accumDist - dist) / (float) steps;
+            point = vec2(toCol + alpha * (fromCol - toCol), toRow + alpha * (fromRow - toRow));
+            found = true;
         }
-        i1 = i2;
-    }
-    return vec2(i1.col, i1.row);
+    });
+    return point;
 }
 
 /**
@@ -597,7 +742,9 @@ struct Node {
 struct Vehicle {
     float speed = -.5, t = 1;
     vec3 overlayColor;
-    vector<NodePosition> runnerPath;
+    PackedPath runnerPath;
+    // Given When The Road Is Linked, never reused, so the renderer can keep the path on the GPU under it
+    uint32_t pathId = 0;
 
     /**
      * Vehicle() Default Vehicle Constructor
@@ -621,15 +768,22 @@ struct Vehicle {
      * @param s Float S
      * @param tt Float tt
      * @param color Vec3 Color
-     * @param path Vector Path Collection
+     * @param path PackedPath Encoded Path, moved into the vehicle
      */
-    Vehicle(float s, float tt, const vec3 &color, const vector<NodePosition> &path) {
+    Vehicle(float s, float tt, const vec3 &color, PackedPath &&path) : runnerPath(std::move(path)) {
         this->speed = s;
         this->t = tt;
         this->overlayColor = color;
-        this->runnerPath = path;
     }
 
+    Vehicle(const Vehicle &) = delete;
+
+    Vehicle &operator=(const Vehicle &) = delete;
+
+    Vehicle(Vehicle &&) noexcept = default;
+
+    Vehicle &operator=(Vehicle &&) noexcept = default;
+
     /**
      * Update() Update Time And Speed derivative
      * @param dt Float DT
@@ -639,27 +793,6 @@ struct Vehicle {
         if (t < 0 || t > 1) speed = -speed;
         t = t < 0 ? 0 : t > 1 ? 1 : t;
     }
-
-    /**
-     * Draw() Vehicle Draw Function
-     *
-     * @param drawLogs String Draw Log Information
-     */
-    void Draw(string &drawLogs) {
-
-        if (!runnerPath.empty()) {
-            // Draw Path Using Vehicle Color
-            DrawPath(runnerPath, 2.5f, overlayColor);
-
-            float dist = t * PathLength(runnerPath);
-            vec2 p = PointOnPath(dist, runnerPath);
-
-            // Draw Disk Dot
-            Disk(vec2(X_POS + (p.x + .5) * DX, Y_POS + (p.y + .5) * DY), (MAX_DIAMETER_SIZE * 0.5f), overlayColor);
-
-            drawLogs = "runner pos: " + to_string(p.x) + " " + to_string(p.y);
-        }
-    }
 };
 
 /**
@@ -667,21 +800,24 @@ struct Vehicle {
  * @details Vehicle And Destination Linker
  */
 struct RoadRunnerLinker {
-    string hashedId;
+    pmr::string hashedId;
     bool isLinked = false;
     Vehicle vehicleRunner;
 
     /**
      * RoadRunnerLinker() Default Constructor with initial variables
      * @param hashedVal String hash value
-     * @param runner Vehicle Structure
+     * @param runner Vehicle Structure, moved into the linker
      * @param linkStatus Boolean Linking Status
      */
-    RoadRunnerLinker(string hashedVal, const Vehicle &runner, bool linkStatus) {
-        this->hashedId = hashedVal;
-        this->vehicleRunner = runner;
+    RoadRunnerLinker(const pmr::string &hashedVal, Vehicle &&runner, bool linkStatus)
+            : hashedId(hashedVal, GAME_ARENA.Resource()), vehicleRunner(std::move(runner)) {
         this->isLinked = linkStatus;
     }
+
+    RoadRunnerLinker(const RoadRunnerLinker &) = delete;
+
+    RoadRunnerLinker &operator=(const RoadRunnerLinker &) = delete;
 };
 
 #endif //ROADREALM_ROADNETSHARED_H
@@ -0,0 +1,441 @@
+/**
+ * @file RunnerPaths.h
+ * @author Team 8: Edwin Kaburu, Vincent Marklynn, Yong Long Tan
+ * @date 10/19/2026
+ */
+
+#ifndef ROADREALM_RUNNERPATHS_H
+#define ROADREALM_RUNNERPATHS_H
+
+#include <glad.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stddef.h>
+#include <unordered_map>
+#include <vector>
+#include "GLState.h"
+#include "GLXtras.h"
+#include "PathCodec.h"
+#include "StreamBuffer.h"
+#include "VecMat.h"
+
+using namespace std;
+
+// Path Corners The Shared Buffer Starts With, it doubles when full
+#define RUNNER_PATHS_INITIAL_CORNERS 4096
+
+/**
+ * @struct RunnerPathCorner
+ * @details One Corner Of An Uploaded Path: its cell, the path length up to it and the path color as RGBA8. The same
+ * buffer feeds the road lines as vertices and the dot shader as an RGBA32F buffer texture, whose z is the length.
+ */
+struct RunnerPathCorner {
+    float col = 0, row = 0, distance = 0;
+    uint32_t color = 0;
+};
+
+/**
+ * @struct RunnerDotInstance
+ * @details Per-Frame Record Of One Runner Dot, its path's corners and how far along it the runner is
+ */
+struct RunnerDotInstance {
+    int32_t first = 0, count = 0;
+    float t = 0;
+    uint32_t color = 0;
+};
+
+/**
+ * @class RunnerPathRenderer
+ * @details Runner roads live on the GPU: a path is uploaded once, when its runner is first seen, into a shared buffer
+ * of corners, and its corners are freed once a frame goes by without it (the road was wiped). Every road is drawn by
+ * one glMultiDrawArrays of line strips, and every dot by one instanced draw whose vertex shader finds the dot on its
+ * path by binary search of the cumulative lengths, so per runner and frame the CPU only writes t and the slot.
+ */
+class RunnerPathRenderer {
+private:
+    /**
+     * @struct Slot
+     * @details Corners Owned By One Path, and the frame it was last seen in
+     */
+    struct Slot {
+        int first = 0, count = 0;
+        uint32_t seenFrame = 0;
+    };
+
+    unordered_map<uint32_t, Slot> slots;
+    // Free Corner Ranges (first, count), kept sorted and merged
+    vector<pair<int, int>> freeRanges;
+    // CPU Copy Of The Buffer, re-sent whole only when the buffer grows
+    vector<RunnerPathCorner> corners;
+    int usedCorners = 0;
+    uint32_t frame = 1;
+    bool slotsChanged = true;
+
+    vector<GLint> firsts;
+    vector<GLsizei> counts;
+    vector<RunnerDotInstance> dots;
+
+    GLuint cornerBuffer = 0, cornerTexture = 0, lineVao = 0, dotVao = 0;
+    GLuint lineProgram = 0, dotProgram = 0;
+    int dotGeneration = 0;
+
+    /**
+     * Initialize() Build The Shaders, Buffer And Vertex Arrays On First Use
+     */
+    void Initialize() {
+        static const char *lineVertexCode = R"(
+            #version 410 core
+            in vec2 cell;
+            in vec4 color;
+            out vec4 vColor;
+            uniform mat4 view;
+            uniform vec2 origin, cellSize;
+            void main() {
+                gl_Position = view * vec4(origin + (cell + .5) * cellSize, 0, 1);
+                vColor = color;
+            }
+        )";
+        static const char *linePixelCode = R"(
+            #version 410 core
+            in vec4 vColor;
+            out vec4 pColor;
+            void main() {
+                pColor = vColor;
+            }
+        )";
+        static const char *dotVertexCode = R"(
+            #version 410 core
+            in ivec2 range;
+            in float t;
+            in vec4 color;
+            out vec4 vColor;
+            out vec2 vPixel;
+            uniform samplerBuffer corners;
+            uniform mat4 view;
+            uniform vec2 origin, cellSize, pixelToClip;
+            uniform float radius;
+            vec2 PointOnPath(int first, int count, float t) {
+                if (count < 2)
+                    return texelFetch(corners, first).xy;
+                float d = t * texelFetch(corners, first + count - 1).z;
+                int lo = first + 1, hi = first + count - 1;
+                while (lo < hi) {
+                    int mid = (lo + hi) / 2;
+                    if (texelFetch(corners, mid).z < d) lo = mid + 1; else hi = mid;
+                }
+                vec4 a = texelFetch(corners, lo - 1), b = texelFetch(corners, lo);
+                return mix(a.xy, b.xy, b.z > a.z ? clamp((d - a.z) / (b.z - a.z), 0, 1) : 1);
+            }
+            void main() {
+                vec2 cell = PointOnPath(range.x, range.y, clamp(t, 0, 1));
+                vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1) * 2 - 1;
+                vPixel = corner * (radius + 1);
+                vec4 c = view * vec4(origin + (cell + .5) * cellSize, 0, 1);
+                gl_Position = c + vec4(vPixel * pixelToClip * c.w, 0, 0);
+                vColor = color;
+            }
+        )";
+        static const char *dotPixelCode = R"(
+            #version 410 core
+            in vec4 vColor;
+            in vec2 vPixel;
+            out vec4 pColor;
+            uniform float radius;
+            void main() {
+                float o = clamp(radius - length(vPixel) + .5, 0, 1);
+                if (o <= 0)
+                    discard;
+                pColor = vec4(vColor.rgb, o);
+            }
+        )";
+        lineProgram = LinkProgramViaCode(&lineVertexCode, &linePixelCode);
+        dotProgram = LinkProgramViaCode(&dotVertexCode, &dotPixelCode);
+        UseProgram(dotProgram);
+        SetUniform(dotProgram, "corners", 0);
+
+        glGenBuffers(1, &cornerBuffer);
+        corners.resize(RUNNER_PATHS_INITIAL_CORNERS);
+        BindBuffer(GL_ARRAY_BUFFER, cornerBuffer);
+        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr) (corners.size() * sizeof(RunnerPathCorner)), nullptr,
+                     GL_DYNAMIC_DRAW);
+        glGenTextures(1, &cornerTexture);
+        BindTexture(0, GL_TEXTURE_BUFFER, cornerTexture);
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, cornerBuffer);
+
+        // Line Vertices Read The Corner Buffer In Place, it never changes name so the attributes are set once
+        glGenVertexArrays(1, &lineVao);
+        BindVertexArray(lineVao);
+        GLint cell = AttribLocation(lineProgram, "cell"), color = AttribLocation(lineProgram, "color");
+        glEnableVertexAttribArray(cell);
+        glVertexAttribPointer(cell, 2, GL_FLOAT, GL_FALSE, sizeof(RunnerPathCorner),
+                              (void *) offsetof(RunnerPathCorner, col));
+        glEnableVertexAttribArray(color);
+        glVertexAttribPointer(color, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(RunnerPathCorner),
+                              (void *) offsetof(RunnerPathCorner, color));
+        glGenVertexArrays(1, &dotVao);
+    }
+
+    /**
+     * Allocate() Find Room For A Path's Corners, first fit among freed ranges or else at the end
+     *
+     * @param count Integer Corners
+     * @return Integer First Corner
+     */
+    int Allocate(int count) {
+        for (size_t i = 0; i < freeRanges.size(); i++) {
+            if (freeRanges[i].second >= count) {
+                int first = freeRanges[i].first;
+                freeRanges[i].first += count;
+                freeRanges[i].second -= count;
+                if (freeRanges[i].second == 0) {
+                    freeRanges.erase(freeRanges.begin() + (ptrdiff_t) i);
+                }
+                return first;
+            }
+        }
+        int first = usedCorners;
+        usedCorners += count;
+        if (usedCorners > (int) corners.size()) {
+            size_t capacity = corners.size();
+            while ((int) capacity < usedCorners) {
+                capacity *= 2;
+            }
+            corners.resize(capacity);
+            BindBuffer(GL_ARRAY_BUFFER, cornerBuffer);
+            glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr) (capacity * sizeof(RunnerPathCorner)), corners.data(),
+                         GL_DYNAMIC_DRAW);
+        }
+        return first;
+    }
+
+    /**
+     * Free() Return A Path's Corners, merging with neighbouring free ranges
+     *
+     * @param slot Slot
+     */
+    void Free(const Slot &slot) {
+        auto at = lower_bound(freeRanges.begin(), freeRanges.end(), make_pair(slot.first, 0));
+        at = freeRanges.insert(at, make_pair(slot.first, slot.count));
+        if (at + 1 != freeRanges.end() && at->first + at->second == (at + 1)->first) {
+            at->second += (at + 1)->second;
+            freeRanges.erase(at + 1);
+        }
+        if (at != freeRanges.begin() && (at - 1)->first + (at - 1)->second == at->first) {
+            (at - 1)->second += at->second;
+            freeRanges.erase(at);
+        }
+    }
+
+    /**
+     * Upload() Lay A Path Out As Corners, one per straight stretch end, and send them to the GPU
+     *
+     * @param path PathView Runner Road
+     * @param color Uint32 RGBA8 Color
+     * @return Slot
+     */
+    Slot Upload(const PathView &path, uint32_t color) {
+        Slot slot;
+        slot.count = path.codeCount + 1;
+        slot.first = Allocate(slot.count);
+        RunnerPathCorner *c = &corners[slot.first];
+        c->col = path.startCol;
+        c->row = path.startRow;
+        c->distance = 0;
+        c->color = color;
+        float distance = 0;
+        path.ForEachRun([&](int /*fromRow*/, int /*fromCol*/, int toRow, int toCol, int steps) {
+            distance += (float) steps;
+            ++c;
+            c->col = (float) toCol;
+            c->row = (float) toRow;
+            c->distance = distance;
+            c->color = color;
+        });
+        BindBuffer(GL_ARRAY_BUFFER, cornerBuffer);
+        glBufferSubData(GL_ARRAY_BUFFER, (GLintptr) (slot.first * sizeof(RunnerPathCorner)),
+                        (GLsizeiptr) (slot.count * sizeof(RunnerPathCorner)), &corners[slot.first]);
+        return slot;
+    }
+
+    /**
+     * PackColor() Color As RGBA8 Bytes In Memory Order
+     *
+     * @param color Vec3 Color
+     * @return Uint32
+     */
+    static uint32_t PackColor(const vec3 &color) {
+        uint8_t rgba[4] = {(uint8_t) (clamp(color.x, 0.0f, 1.0f) * 255.0f + 0.5f),
+                           (uint8_t) (clamp(color.y, 0.0f, 1.0f) * 255.0f + 0.5f),
+                           (uint8_t) (clamp(color.z, 0.0f, 1.0f) * 255.0f + 0.5f), 255};
+        uint32_t packed;
+        memcpy(&packed, rgba, sizeof(packed));
+        return packed;
+    }
+
+public:
+    RunnerPathRenderer() {}
+
+    RunnerPathRenderer(const RunnerPathRenderer &) = delete;
+
+    RunnerPathRenderer &operator=(const RunnerPathRenderer &) = delete;
+
+    ~RunnerPathRenderer() { Release(); }
+
+    /**
+     * Add() Queue A Runner For The Next Draw(), uploading its path the first time its id is seen
+     *
+     * @param pathId Uint32 Id Given When The Road Was Linked, never reused
+     * @param path PathView Runner Road
+     * @param color Vec3 Color
+     * @param t Float Position Along The Road, 0 to 1
+     */
+    void Add(uint32_t pathId, const PathView &path, const vec3 &color, float t) {
+        if (path.empty()) {
+            return;
+        }
+        if (lineProgram == 0) {
+            Initialize();
+        }
+        auto found = slots.find(pathId);
+        if (found == slots.end()) {
+            found = slots.emplace(pathId, Upload(path, PackColor(color))).first;
+            slotsChanged = true;
+        }
+        Slot &slot = found->second;
+        slot.seenFrame = frame;
+        RunnerDotInstance dot;
+        dot.first = slot.first;
+        dot.count = slot.count;
+        dot.t = t;
+        dot.color = corners[slot.first].color;
+        dots.push_back(dot);
+    }
+
+    /**
+     * Draw() Free Paths Not Added Since The Last Draw, then draw every road and, if asked, every dot
+     *
+     * @param view Mat4 Pixel-To-Clip Transform, as from ScreenMode()
+     * @param origin Vec2 Pixel Position Of Cell (0, 0)
+     * @param cellSize Vec2 Cell Pitch In Pixels
+     * @param lineWidth Float Road Width In Pixels
+     * @param dotDiameter Float Dot Diameter In Pixels
+     * @param drawDots Boolean Draw The Runner Dots
+     * @return Integer Draw Calls Issued
+     */
+    int Draw(mat4 view, vec2 origin, vec2 cellSize, float lineWidth, float dotDiameter, bool drawDots) {
+        for (auto it = slots.begin(); it != slots.end();) {
+            if (it->second.seenFrame != frame) {
+                Free(it->second);
+                it = slots.erase(it);
+                slotsChanged = true;
+            } else {
+                ++it;
+            }
+        }
+        frame++;
+        if (slots.empty()) {
+            dots.clear();
+            return 0;
+        }
+        if (slotsChanged) {
+            firsts.clear();
+            counts.clear();
+            for (const auto &entry: slots) {
+                firsts.push_back(entry.second.first);
+                counts.push_back(entry.second.count);
+            }
+            slotsChanged = false;
+        }
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+        // Roads: One Line Strip Per Path, one call for all of them
+        UseProgram(lineProgram);
+        SetUniform(lineProgram, "view", view);
+        SetUniform(lineProgram, "origin", origin);
+        SetUniform(lineProgram, "cellSize", cellSize);
+        BindVertexArray(lineVao);
+        glLineWidth(lineWidth);
+        glMultiDrawArrays(GL_LINE_STRIP, firsts.data(), counts.data(), (GLsizei) firsts.size());
+        int nDraws = 1;
+
+        // Dots: One Instance Per Runner, placed on its path by the vertex shader
+        if (drawDots && !dots.empty()) {
+            GLsizei stride = sizeof(RunnerDotInstance);
+            StreamBuffer &stream = VertexStream();
+            GLintptr offset = 0;
+            memcpy(stream.Map(dots.size() * stride, stride, offset), dots.data(), dots.size() * stride);
+            stream.Unmap();
+            UseProgram(dotProgram);
+            BindVertexArray(dotVao);
+            // Without Base Instance (before GL 4.2) the attributes are re-pointed at this frame's records
+            bool baseInstance = glDrawArraysInstancedBaseInstance != nullptr;
+            if (dotGeneration != stream.Generation() || !baseInstance) {
+                GLintptr base = baseInstance ? 0 : offset;
+                BindBuffer(GL_ARRAY_BUFFER, stream.Buffer());
+                GLint range = AttribLocation(dotProgram, "range"), t = AttribLocation(dotProgram, "t");
+                GLint color = AttribLocation(dotProgram, "color");
+                glEnableVertexAttribArray(range);
+                glVertexAttribIPointer(range, 2, GL_INT, stride, (void *) (base + offsetof(RunnerDotInstance, first)));
+                glVertexAttribDivisor(range, 1);
+                glEnableVertexAttribArray(t);
+                glVertexAttribPointer(t, 1, GL_FLOAT, GL_FALSE, stride, (void *) (base + offsetof(RunnerDotInstance, t)));
+                glVertexAttribDivisor(t, 1);
+                glEnableVertexAttribArray(color);
+                glVertexAttribPointer(color, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride,
+                                      (void *) (base + offsetof(RunnerDotInstance, color)));
+                glVertexAttribDivisor(color, 1);
+                dotGeneration = stream.Generation();
+            }
+            int vp[4];
+            GetViewport(vp);
+            SetUniform(dotProgram, "view", view);
+            SetUniform(dotProgram, "origin", origin);
+            SetUniform(dotProgram, "cellSize", cellSize);
+            SetUniform(dotProgram, "pixelToClip", vec2(2.0f / (float) vp[2], 2.0f / (float) vp[3]));
+            SetUniform(dotProgram, "radius", 0.5f * dotDiameter);
+            BindTexture(0, GL_TEXTURE_BUFFER, cornerTexture);
+            GLsizei nDots = (GLsizei) dots.size();
+            if (baseInstance) {
+                glDrawArraysInstancedBaseInstance(GL_TRIANGLE_STRIP, 0, 4, nDots, (GLuint) (offset / stride));
+            } else {
+                glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, nDots);
+            }
+            nDraws++;
+        }
+        dots.clear();
+        return nDraws;
+    }
+
+    /**
+     * ResidentPaths() Number Of Paths Uploaded
+     *
+     * @return Integer
+     */
+    int ResidentPaths() const { return (int) slots.size(); }
+
+    /**
+     * Release() Delete The GL Objects And Forget Every Path
+     */
+    void Release() {
+        if (lineProgram != 0) {
+            DeleteTextures(1, &cornerTexture);
+            DeleteBuffers(1, &cornerBuffer);
+            GLuint vaos[2] = {lineVao, dotVao};
+            DeleteVertexArrays(2, vaos);
+            DeleteProgram(lineProgram);
+            DeleteProgram(dotProgram);
+        }
+        lineProgram = dotProgram = cornerBuffer = cornerTexture = lineVao = dotVao = 0;
+        dotGeneration = 0;
+        slots.clear();
+        freeRanges.clear();
+        corners.clear();
+        usedCorners = 0;
+        dots.clear();
+        slotsChanged = true;
+    }
+};
+
+#endif //ROADREALM_RUNNERPATHS_H
@@ -0,0 +1,97 @@
+/**
+ * @file SimClock.h
+ * @author Team 8: Edwin Kaburu, Vincent Marklynn, Yong Long Tan
+ * @date 10/19/2026
+ */
+
+#ifndef ROADREALM_SIMCLOCK_H
+#define ROADREALM_SIMCLOCK_H
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+using namespace std;
+
+// Simulation Ticks Per Second, independent of the render frame rate
+#define SIM_TICK_RATE 60
+// Ticks Kept For Latency Statistics
+#define SIM_STATS_WINDOW 256
+
+/**
+ * @struct TickSummary
+ * @details Latency Statistics Over The Recent Tick Window, in milliseconds
+ */
+struct TickSummary {
+    float meanWorkMs = 0, p99WorkMs = 0, maxWorkMs = 0;
+    float p99LateMs = 0;
+    uint32_t ticks = 0;
+};
+
+/**
+ * @class TickStats
+ * @details Rolling record of how long each simulation tick took and how late it started against its schedule. Tick
+ * work staying flat while the renderer is saturated is the evidence that drawing no longer delays gameplay.
+ */
+class TickStats {
+private:
+    array<float, SIM_STATS_WINDOW> workMs = {}, lateMs = {};
+    uint32_t ticksRecorded = 0;
+
+    /**
+     * Percentile() Percentile Of A Sample Window
+     *
+     * @param samples Float Sample Window, copied so the record keeps its order
+     * @param count Integer Valid Samples
+     * @param fraction Float Percentile, 0 to 1
+     * @return Float Sample Value
+     */
+    static float Percentile(array<float, SIM_STATS_WINDOW> samples, int count, float fraction) {
+        if (count == 0) {
+            return 0;
+        }
+        int rank = min(count - 1, (int) (fraction * (float) count));
+        nth_element(samples.begin(), samples.begin() + rank, samples.begin() + count);
+        return samples[rank];
+    }
+
+public:
+    /**
+     * Record() Add A Finished Tick
+     *
+     * @param work Duration Spent Inside The Tick
+     * @param late Duration The Tick Started After Its Scheduled Time
+     */
+    void Record(chrono::steady_clock::duration work, chrono::steady_clock::duration late) {
+        int slot = (int) (ticksRecorded % SIM_STATS_WINDOW);
+        workMs[slot] = chrono::duration<float, milli>(work).count();
+        lateMs[slot] = max(0.0f, chrono::duration<float, milli>(late).count());
+        ticksRecorded++;
+    }
+
+    /**
+     * Summary() Statistics Over The Recent Tick Window
+     *
+     * @return TickSummary
+     */
+    TickSummary Summary() const {
+        TickSummary summary;
+        int count = (int) min<uint32_t>(ticksRecorded, SIM_STATS_WINDOW);
+        summary.ticks = ticksRecorded;
+        if (count == 0) {
+            return summary;
+        }
+        float total = 0;
+        for (int i = 0; i < count; i++) {
+            total += workMs[i];
+            summary.maxWorkMs = max(summary.maxWorkMs, workMs[i]);
+        }
+        summary.meanWorkMs = total / (float) count;
+        summary.p99WorkMs = Percentile(workMs, count, 0.99f);
+        summary.p99LateMs = Percentile(lateMs, count, 0.99f);
+        return summary;
+    }
+};
+
+#endif //ROADREALM_SIMCLOCK_H
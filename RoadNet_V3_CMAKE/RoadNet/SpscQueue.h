@@ -0,0 +1,77 @@
+/**
+ * @file SpscQueue.h
+ * @author Team 8: Edwin Kaburu, Vincent Marklynn, Yong Long Tan
+ * @date 10/19/2026
+ */
+
+#ifndef ROADREALM_SPSCQUEUE_H
+#define ROADREALM_SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+using namespace std;
+
+/**
+ * @class SpscQueue
+ * @details Bounded lock-free ring for exactly one producer thread and one consumer thread. Each side only writes its
+ * own index, so pushing and popping never block and never allocate.
+ *
+ * @tparam T Trivially Copyable Element Type
+ * @tparam CAPACITY Ring Size, a power of two
+ */
+template<typename T, size_t CAPACITY>
+class SpscQueue {
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+private:
+    T ring[CAPACITY];
+    // Separate Cache Lines, so the two threads do not contend on each other's index
+    alignas(64) atomic<size_t> head{0};
+    alignas(64) atomic<size_t> tail{0};
+    atomic<uint32_t> dropped{0};
+
+public:
+    /**
+     * Push() Append An Element, producer thread only
+     *
+     * @param value Element
+     * @return Boolean Condition, false if the ring was full and the element was dropped
+     */
+    bool Push(const T &value) {
+        size_t writeIndex = tail.load(memory_order_relaxed);
+        if (writeIndex - head.load(memory_order_acquire) == CAPACITY) {
+            dropped.fetch_add(1, memory_order_relaxed);
+            return false;
+        }
+        ring[writeIndex & (CAPACITY - 1)] = value;
+        tail.store(writeIndex + 1, memory_order_release);
+        return true;
+    }
+
+    /**
+     * Pop() Remove The Oldest Element, consumer thread only
+     *
+     * @param value Element Output
+     * @return Boolean Condition, false if the ring was empty
+     */
+    bool Pop(T &value) {
+        size_t readIndex = head.load(memory_order_relaxed);
+        if (readIndex == tail.load(memory_order_acquire)) {
+            return false;
+        }
+        value = ring[readIndex & (CAPACITY - 1)];
+        head.store(readIndex + 1, memory_order_release);
+        return true;
+    }
+
+    /**
+     * Dropped() Number Of Elements Rejected Because The Ring Was Full
+     *
+     * @return Unsigned Count
+     */
+    uint32_t Dropped() const { return dropped.load(memory_order_relaxed); }
+};
+
+#endif //ROADREALM_SPSCQUEUE_H
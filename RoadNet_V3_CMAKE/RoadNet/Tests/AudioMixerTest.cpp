@@ -0,0 +1,219 @@
+// AudioMixerTest.cpp - sound decoding, voice mixing and non-blocking Play checks for the audio mixer
+// Team 8 (Edwin Kaburu, Vincent Marklynn, Yong Long Tan)
+// Usage: RoadRealmAudioTest out.wav
+//        Run from the source tree so the game's sounds decode. Mixes two overlapping voices into out.wav through the
+//        WAV file backend and fails if the file does not hold one sample per frame of the run, if the mix is silent or
+//        is not the sum of the two sounds, or if Play from another thread waits on the mixer.
+
+#include "../AudioMixer.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Checked-In Sounds, a 16-bit file already at the mixer rate and an 8-bit one that is resampled
+#define TEST_LONG_SOUND SOUND_ERROR
+#define TEST_SHORT_SOUND SOUND_CLICK
+#define TEST_LONG_FRAMES 10487
+// Blocks Of Silence Played After Both Sounds End, before the mixer is stopped
+#define TEST_TAIL_BLOCKS 8
+// Plays Pushed In One Burst, enough to fill the command queue 64 times over
+#define TEST_BURST_PLAYS (64 * AUDIO_COMMAND_CAPACITY)
+// Most A Play Or A Whole Burst May Take, ten mixed blocks; the mixer drains the queue once a block, so a burst
+//   waiting on it would take over 60
+#define TEST_PLAY_MAX_MS (10 * 1000.0 * AUDIO_BLOCK_FRAMES / AUDIO_SAMPLE_RATE)
+
+using TestClock = chrono::steady_clock;
+
+int failures = 0;
+
+/**
+ * Check() Report A Failed Condition
+ * @param ok condition
+ * @param what failure description
+ */
+void Check(bool ok, const char *what) {
+    if (!ok) {
+        printf("FAIL: %s\n", what);
+        failures++;
+    }
+}
+
+/**
+ * Milliseconds() Length Of A Duration
+ */
+double Milliseconds(TestClock::duration d) { return chrono::duration<double, milli>(d).count(); }
+
+/**
+ * SelectBackend() Point CreateBackend At An Output, as ROADREALM_AUDIO does for the game
+ * @param choice "null" or "wav:<file>"
+ */
+void SelectBackend(const string &choice) {
+#ifdef _WIN32
+    _putenv_s("ROADREALM_AUDIO", choice.c_str());
+#else
+    setenv("ROADREALM_AUDIO", choice.c_str(), 1);
+#endif
+}
+
+/**
+ * ReadDataBytes() Size The RIFF Header Of A Written WAV File Gives Its Samples, -1 if it disagrees with the file
+ */
+long ReadDataBytes(const char *path) {
+    FILE *file = fopen(path, "rb");
+    if (file == nullptr) {
+        return -1;
+    }
+    uint8_t header[44];
+    size_t got = fread(header, 1, sizeof(header), file);
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fclose(file);
+    if (got != sizeof(header) || memcmp(header + 36, "data", 4) != 0) {
+        return -1;
+    }
+    long dataBytes = (long) ReadLE(header + 40, 4);
+    return dataBytes == size - (long) sizeof(header) ? dataBytes : -1;
+}
+
+/**
+ * MixMatches() Whether The Output Is Silence, then the long sound from a start block, the short one from a later block
+ * @param out mixed samples
+ * @param a long sound
+ * @param b short sound
+ * @param start first sample of the long sound
+ * @param delay samples between the two starts
+ */
+bool MixMatches(const vector<int16_t> &out, const vector<int16_t> &a, const vector<int16_t> &b, size_t start,
+                size_t delay) {
+    for (size_t i = 0; i < out.size(); i++) {
+        int32_t expected = 0;
+        if (i >= start && i - start < a.size()) {
+            expected += a[i - start];
+        }
+        if (i >= start + delay && i - start - delay < b.size()) {
+            expected += b[i - start - delay];
+        }
+        if (out[i] != (int16_t) clamp<int32_t>(expected, INT16_MIN, INT16_MAX)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * TestDecode() Checked-In Sounds Decode To Stereo At The Mixer Rate
+ */
+void TestDecode(vector<int16_t> &longSound, vector<int16_t> &shortSound) {
+    Check(DecodeWav(SoundPath(TEST_LONG_SOUND), longSound), "long sound did not decode");
+    Check(longSound.size() == (size_t) TEST_LONG_FRAMES * AUDIO_CHANNELS, "long sound decoded to the wrong length");
+    Check(DecodeWav(SoundPath(TEST_SHORT_SOUND), shortSound), "short sound did not decode");
+    Check(!shortSound.empty() && shortSound.size() % AUDIO_CHANNELS == 0, "short sound decoded to partial frames");
+    vector<int16_t> missing;
+    Check(!DecodeWav("RoadNet/Sounds/missing.wav", missing), "missing file decoded");
+}
+
+/**
+ * TestOverlap() Two Voices Played From Another Thread Mix Into The WAV File Backend
+ */
+void TestOverlap(const char *outPath, const vector<int16_t> &longSound, const vector<int16_t> &shortSound) {
+    SelectBackend(string("wav:") + outPath);
+    AudioMixer mixer;
+    // Output Starts Somewhere Inside Start(), after the sounds decode
+    TestClock::time_point beforeStart = TestClock::now();
+    Check(mixer.Start(), "WAV file backend did not open");
+    TestClock::time_point afterStart = TestClock::now();
+
+    double playMs = 0;
+    thread game([&]() {
+        TestClock::time_point playStart = TestClock::now();
+        mixer.Play(TEST_LONG_SOUND);
+        mixer.Play(TEST_SHORT_SOUND);
+        playMs = Milliseconds(TestClock::now() - playStart);
+    });
+    game.join();
+    size_t longest = max(longSound.size(), shortSound.size()) / AUDIO_CHANNELS;
+    this_thread::sleep_for(chrono::microseconds(
+            (long long) (longest + TEST_TAIL_BLOCKS * AUDIO_BLOCK_FRAMES) * 1000000 / AUDIO_SAMPLE_RATE));
+    mixer.Stop();
+    TestClock::time_point stopped = TestClock::now();
+    double fewestFrames = chrono::duration<double>(stopped - afterStart).count() * AUDIO_SAMPLE_RATE;
+    double mostFrames = chrono::duration<double>(stopped - beforeStart).count() * AUDIO_SAMPLE_RATE;
+    Check(playMs <= TEST_PLAY_MAX_MS, "two Plays waited on the mixer");
+
+    // One Whole Block Per Write, paced in real time
+    long dataBytes = ReadDataBytes(outPath);
+    Check(dataBytes >= 0, "WAV header does not match the samples written");
+    long blockBytes = AUDIO_BLOCK_FRAMES * AUDIO_CHANNELS * (long) sizeof(int16_t);
+    Check(dataBytes % blockBytes == 0, "mix is not a whole number of blocks");
+    double written = (double) dataBytes / (AUDIO_CHANNELS * sizeof(int16_t));
+    Check(written >= fewestFrames - AUDIO_DEVICE_BLOCKS * AUDIO_BLOCK_FRAMES &&
+          written <= mostFrames + AUDIO_BLOCK_FRAMES, "mix does not hold one frame per frame of the run");
+
+    vector<int16_t> mixed;
+    Check(DecodeWav(outPath, mixed), "mix did not decode");
+    Check(mixed.size() * sizeof(int16_t) == (size_t) max(dataBytes, 0L), "mix decoded to the wrong length");
+    int peak = 0;
+    for (int16_t sample: mixed) {
+        peak = max(peak, abs((int) sample));
+    }
+    Check(peak > INT16_MAX / 16, "mix is silent");
+
+    // Each Voice Starts On A Block, the short one no earlier than the long one
+    size_t blockSamples = AUDIO_BLOCK_FRAMES * AUDIO_CHANNELS;
+    bool matched = false;
+    for (size_t first = 0; !matched && first < mixed.size(); first += blockSamples) {
+        for (size_t delay = 0; !matched && first + delay < mixed.size(); delay += blockSamples) {
+            matched = MixMatches(mixed, longSound, shortSound, first, delay);
+        }
+        // Output Before The First Voice Is Silence, stop once a block of it is not
+        for (size_t i = first; i < first + blockSamples && i < mixed.size(); i++) {
+            if (mixed[i] != 0) {
+                first = mixed.size();
+                break;
+            }
+        }
+    }
+    Check(matched, "mix is not the sum of the two sounds");
+}
+
+/**
+ * TestBurst() Plays Past A Full Command Queue Are Dropped, not waited on
+ */
+void TestBurst() {
+    SelectBackend("null");
+    AudioMixer mixer;
+    mixer.Start();
+    double burstMs = 0;
+    thread game([&]() {
+        TestClock::time_point burstStart = TestClock::now();
+        for (int i = 0; i < TEST_BURST_PLAYS; i++) {
+            mixer.Play(TEST_SHORT_SOUND, 0.1f);
+        }
+        burstMs = Milliseconds(TestClock::now() - burstStart);
+    });
+    game.join();
+    mixer.Stop();
+    Check(burstMs <= TEST_PLAY_MAX_MS, "a burst of Plays waited on the mixer");
+    printf("%d Plays from another thread took %.3f ms\n", TEST_BURST_PLAYS, burstMs);
+}
+
+int main(int ac, char **av) {
+    if (ac < 2) {
+        printf("usage: %s out.wav\n", av[0]);
+        return 2;
+    }
+    vector<int16_t> longSound, shortSound;
+    TestDecode(longSound, shortSound);
+    if (failures == 0) {
+        TestOverlap(av[1], longSound, shortSound);
+    }
+    TestBurst();
+    printf("%s\n", failures ? "FAILED" : "passed");
+    return failures ? 1 : 0;
+}
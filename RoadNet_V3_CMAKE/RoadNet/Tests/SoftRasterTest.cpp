@@ -0,0 +1,218 @@
+// SoftRasterTest.cpp - software rasterizer coverage checks and golden image comparison
+// Team 8 (Edwin Kaburu, Vincent Marklynn, Yong Long Tan)
+// Usage: RoadRealmSoftRasterTest golden.png [--update]
+//        Fails if triangles sharing an edge leave a seam or blend a pixel twice, if the result depends on the thread
+//        count, or if the scene differs from the golden image; --update rewrites the golden image instead.
+
+#define STB_IMAGE_IMPLEMENTATION
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "STB_Image.h"
+#include "STB_Image_Write.h"
+#include "SoftRaster.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace std;
+
+#define TEST_SIZE 120 // not a power of two, so the view transform rounds like a game frame's
+#define TEST_CELL 15
+#define TEST_TOLERANCE 1
+
+// Polygon Around The Fan Center, at offsets whose spokes run through pixel centers
+const vec2 FAN_OFFSETS[] = {{40, 0}, {36, 18}, {28, 28}, {18, 36}, {0, 40}, {-18, 36}, {-28, 28}, {-36, 18},
+                            {-40, 0}, {-36, -18}, {-28, -28}, {-18, -36}, {0, -40}, {18, -36}, {28, -28}, {36, -18}};
+const int FAN_SIDES = sizeof(FAN_OFFSETS) / sizeof(FAN_OFFSETS[0]);
+const vec2 FAN_CENTER(64.5f, 64.5f);
+
+int failures = 0;
+
+/**
+ * Check() Report A Failed Condition
+ * @param ok condition
+ * @param what failure description
+ */
+void Check(bool ok, const char *what) {
+    if (!ok) {
+        printf("FAIL: %s\n", what);
+        failures++;
+    }
+}
+
+/**
+ * PixelAt() RGBA Of A Pixel, Row 0 At The Bottom
+ */
+const unsigned char *PixelAt(const unsigned char *pixels, int x, int y) {
+    return pixels + 4 * (y * TEST_SIZE + x);
+}
+
+/**
+ * CellColor() Distinct Opaque Color Of A Checker Cell
+ */
+vec4 CellColor(int col, int row) {
+    return vec4((float) (col * 32 + 16) / 255, (float) (row * 32 + 16) / 255, (float) ((col + row) % 2 ? 200 : 60) / 255, 1);
+}
+
+/**
+ * DrawChecker() Opaque Cells As GridRenderer Draws Them, Alternating Diagonal And Winding
+ * @param target SoftTarget
+ */
+void DrawChecker(SoftTarget &target) {
+    for (int row = 0; row < TEST_SIZE / TEST_CELL; row++) {
+        for (int col = 0; col < TEST_SIZE / TEST_CELL; col++) {
+            float x0 = (float) (col * TEST_CELL), y0 = (float) (row * TEST_CELL);
+            float x1 = x0 + TEST_CELL, y1 = y0 + TEST_CELL;
+            if ((col + row) % 2) {
+                target.Quad(vec3(x0, y0, 0), vec3(x0, y1, 0), vec3(x1, y1, 0), vec3(x1, y0, 0), CellColor(col, row));
+            } else {
+                target.Quad(vec3(x1, y0, 0), vec3(x1, y1, 0), vec3(x0, y1, 0), vec3(x0, y0, 0), CellColor(col, row));
+            }
+        }
+    }
+}
+
+/**
+ * DrawFan() Translucent Triangle Fan; Every Spoke Is An Edge Shared By Two Triangles
+ * @param target SoftTarget
+ * @param clockwise submit each triangle clockwise instead of counter-clockwise
+ */
+void DrawFan(SoftTarget &target, bool clockwise) {
+    for (int i = 0; i < FAN_SIDES; i++) {
+        vec2 a = FAN_CENTER + FAN_OFFSETS[i], b = FAN_CENTER + FAN_OFFSETS[(i + 1) % FAN_SIDES];
+        vec3 p1(FAN_CENTER, 0), p2(a, 0), p3(b, 0);
+        if (clockwise) {
+            target.Triangle(p1, p3, p2, vec4(1, 1, 1, .5f));
+        } else {
+            target.Triangle(p1, p2, p3, vec4(1, 1, 1, .5f));
+        }
+    }
+}
+
+/**
+ * DrawScene() Checker, Fan, Lines And Disks Of The Golden Image
+ * @param target SoftTarget
+ */
+void DrawScene(SoftTarget &target) {
+    target.SetView(Orthographic(0, TEST_SIZE, 0, TEST_SIZE));
+    target.Clear(vec3(0, 0, 0));
+    DrawChecker(target);
+    DrawFan(target, false);
+    for (int i = 0; i < 8; i++) {
+        float t = (float) i / 8;
+        target.Line(vec3(4, 4 + 15 * (float) i, 0), vec3(116, 116 - 13 * (float) i, 0), 1 + t * 4,
+                    vec4(1, t, 0, 1), vec4(0, 1 - t, 1, .7f));
+    }
+    for (int i = 0; i < 12; i++) {
+        target.Disk(vec3(10.3f + 9.7f * (float) i, 20 + 7.1f * (float) (i % 5), 0), 3 + (float) i, vec4(1, 1, 0, .8f), i % 3 == 0);
+    }
+}
+
+/**
+ * TestChecker() Opaque Quads Cover Their Cells Exactly, With No Seam On Any Diagonal
+ */
+void TestChecker() {
+    SoftTarget target;
+    target.Resize(TEST_SIZE, TEST_SIZE);
+    target.SetView(Orthographic(0, TEST_SIZE, 0, TEST_SIZE));
+    target.Clear(vec3(0, 0, 0));
+    DrawChecker(target);
+    const unsigned char *pixels = target.Pixels();
+    int wrong = 0;
+    for (int y = 0; y < TEST_SIZE; y++) {
+        for (int x = 0; x < TEST_SIZE; x++) {
+            vec4 c = CellColor(x / TEST_CELL, y / TEST_CELL);
+            const unsigned char *p = PixelAt(pixels, x, y);
+            for (int i = 0; i < 3; i++) {
+                wrong += p[i] != (unsigned char) (c[i] * 255.f + .5f);
+            }
+        }
+    }
+    Check(wrong == 0, "checker cells are not covered exactly (seam or overlap on a shared edge)");
+}
+
+/**
+ * TestFan() Translucent Fan Blends Each Interior Pixel Once, Whatever The Winding
+ */
+void TestFan() {
+    for (int clockwise = 0; clockwise < 2; clockwise++) {
+        SoftTarget target;
+        target.Resize(TEST_SIZE, TEST_SIZE);
+        target.SetView(Orthographic(0, TEST_SIZE, 0, TEST_SIZE));
+        target.Clear(vec3(0, 0, 0));
+        DrawFan(target, clockwise == 1);
+        const unsigned char *pixels = target.Pixels();
+        int gaps = 0, doubles = 0;
+        for (int y = 0; y < TEST_SIZE; y++) {
+            for (int x = 0; x < TEST_SIZE; x++) {
+                vec2 d = vec2((float) x + .5f, (float) y + .5f) - FAN_CENTER;
+                if (length(d) > 35) {
+                    continue; // inside the inscribed circle only, away from the outer edges
+                }
+                unsigned char v = PixelAt(pixels, x, y)[0];
+                gaps += v == 0;
+                doubles += v > 128;
+            }
+        }
+        Check(gaps == 0, clockwise ? "clockwise fan leaves a gap" : "fan leaves a gap");
+        Check(doubles == 0, clockwise ? "clockwise fan blends a pixel twice" : "fan blends a pixel twice");
+    }
+}
+
+/**
+ * RenderScene() Golden Scene Drawn With A Given Number Of Threads
+ * @param threads SoftTarget thread count
+ * @param resolves how many times the scene is drawn and resolved, reusing the target's threads
+ * @return RGBA pixels, row 0 at the bottom
+ */
+vector<unsigned char> RenderScene(int threads, int resolves) {
+    SoftTarget target;
+    target.Resize(TEST_SIZE, TEST_SIZE);
+    target.SetThreads(threads);
+    const unsigned char *pixels = NULL;
+    for (int i = 0; i < resolves; i++) {
+        DrawScene(target);
+        pixels = target.Pixels();
+    }
+    return vector<unsigned char>(pixels, pixels + 4 * TEST_SIZE * TEST_SIZE);
+}
+
+int main(int ac, char **av) {
+    if (ac < 2) {
+        printf("usage: %s golden.png [--update]\n", av[0]);
+        return 2;
+    }
+    const char *golden = av[1];
+    bool update = ac > 2 && !strcmp(av[2], "--update");
+
+    TestChecker();
+    TestFan();
+    vector<unsigned char> scene = RenderScene(1, 1);
+    Check(RenderScene(4, 3) == scene, "4 threads render differently from 1");
+    Check(RenderScene(3, 2) == scene, "3 threads render differently from 1");
+
+    if (update) {
+        stbi_write_png(golden, TEST_SIZE, TEST_SIZE, 4, scene.data() + 4 * TEST_SIZE * (TEST_SIZE - 1), -4 * TEST_SIZE);
+        printf("wrote %s\n", golden);
+    } else {
+        int w, h, n;
+        stbi_set_flip_vertically_on_load(true);
+        unsigned char *data = stbi_load(golden, &w, &h, &n, 4);
+        Check(data != NULL, "golden image missing (run with --update)");
+        if (data) {
+            Check(w == TEST_SIZE && h == TEST_SIZE, "golden image has the wrong size");
+            int wrong = 0;
+            for (int i = 0; w == TEST_SIZE && h == TEST_SIZE && i < 4 * TEST_SIZE * TEST_SIZE; i++) {
+                wrong += abs((int) data[i] - (int) scene[i]) > TEST_TOLERANCE;
+            }
+            if (wrong) {
+                printf("%d channels differ from %s\n", wrong, golden);
+            }
+            Check(wrong == 0, "scene differs from the golden image");
+            stbi_image_free(data);
+        }
+    }
+    printf(failures ? "%d failed\n" : "ok\n", failures);
+    return failures ? 1 : 0;
+}
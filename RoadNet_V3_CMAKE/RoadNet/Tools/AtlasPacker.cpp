@@ -0,0 +1,282 @@
+// AtlasPacker.cpp - offline packer combining UI images into one pre-mipped RGBA8 atlas bundle
+// Team 8 (Edwin Kaburu, Vincent Marklynn, Yong Long Tan)
+// Usage: RoadRealmAtlasPacker [--max-edge N] -o <bundle> <image>...
+//        Region names are the image file names without directory or extension.
+
+#define STB_IMAGE_IMPLEMENTATION
+
+#include "STB_Image.h"
+#include "../AtlasFormat.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Transparent Border Around Each Region, filled by extruding its edge so mip levels do not bleed
+#define ATLAS_PADDING 4
+// Largest Atlas Edge Tried
+#define ATLAS_MAX_SIZE 8192
+// Default Longest Image Edge, leaves room for padding inside a 2048 atlas
+#define ATLAS_DEFAULT_MAX_EDGE 2040
+
+/**
+ * @struct PackImage
+ * @details Decoded Image Waiting To Be Placed
+ */
+struct PackImage {
+    string name;
+    int width = 0, height = 0;
+    vector<uint8_t> pixels;
+    int x = 0, y = 0;
+};
+
+/**
+ * RegionName() File Name Without Directory Or Extension
+ *
+ * @param path String File Path
+ * @return String Name
+ */
+string RegionName(const string &path) {
+    size_t slash = path.find_last_of("/\\");
+    string name = slash == string::npos ? path : path.substr(slash + 1);
+    size_t dot = name.find_last_of('.');
+    return dot == string::npos ? name : name.substr(0, dot);
+}
+
+/**
+ * Downscale() Area-Average An Image So Its Longest Edge Fits
+ *
+ * @param image PackImage
+ * @param maxEdge Integer Longest Edge Allowed
+ */
+void Downscale(PackImage &image, int maxEdge) {
+    int longest = max(image.width, image.height);
+    if (longest <= maxEdge) {
+        return;
+    }
+    int width = max(1, image.width * maxEdge / longest), height = max(1, image.height * maxEdge / longest);
+    vector<uint8_t> scaled(width * height * 4);
+    for (int y = 0; y < height; y++) {
+        int y0 = y * image.height / height, y1 = max(y0 + 1, (y + 1) * image.height / height);
+        for (int x = 0; x < width; x++) {
+            int x0 = x * image.width / width, x1 = max(x0 + 1, (x + 1) * image.width / width);
+            unsigned sum[4] = {};
+            for (int sy = y0; sy < y1; sy++) {
+                for (int sx = x0; sx < x1; sx++) {
+                    for (int c = 0; c < 4; c++) {
+                        sum[c] += image.pixels[(sy * image.width + sx) * 4 + c];
+                    }
+                }
+            }
+            int count = (y1 - y0) * (x1 - x0);
+            for (int c = 0; c < 4; c++) {
+                scaled[(y * width + x) * 4 + c] = (uint8_t) (sum[c] / count);
+            }
+        }
+    }
+    image.width = width;
+    image.height = height;
+    image.pixels.swap(scaled);
+}
+
+/**
+ * ShelfPack() Place Images On Shelves, tallest first
+ *
+ * @param images PackImage Collection, sorted by height
+ * @param atlasWidth Integer Atlas Width
+ * @return Integer Height Used, or -1 if an image is wider than the atlas
+ */
+int ShelfPack(vector<PackImage> &images, int atlasWidth) {
+    int shelfX = 0, shelfY = 0, shelfHeight = 0;
+    for (PackImage &image: images) {
+        int w = image.width + 2 * ATLAS_PADDING, h = image.height + 2 * ATLAS_PADDING;
+        if (w > atlasWidth) {
+            return -1;
+        }
+        if (shelfX + w > atlasWidth) {
+            shelfY += shelfHeight;
+            shelfX = shelfHeight = 0;
+        }
+        image.x = shelfX + ATLAS_PADDING;
+        image.y = shelfY + ATLAS_PADDING;
+        shelfX += w;
+        shelfHeight = max(shelfHeight, h);
+    }
+    return shelfY + shelfHeight;
+}
+
+int NextPowerOfTwo(int value) {
+    int power = 1;
+    while (power < value) {
+        power *= 2;
+    }
+    return power;
+}
+
+/**
+ * Blit() Copy An Image Into The Atlas And Extrude Its Edges Into The Padding
+ *
+ * @param atlas Byte Collection RGBA8
+ * @param atlasWidth Integer Atlas Width
+ * @param atlasHeight Integer Atlas Height
+ * @param image PackImage
+ */
+void Blit(vector<uint8_t> &atlas, int atlasWidth, int atlasHeight, const PackImage &image) {
+    for (int y = -ATLAS_PADDING; y < image.height + ATLAS_PADDING; y++) {
+        int ty = image.y + y, sy = clamp(y, 0, image.height - 1);
+        if (ty < 0 || ty >= atlasHeight) {
+            continue;
+        }
+        for (int x = -ATLAS_PADDING; x < image.width + ATLAS_PADDING; x++) {
+            int tx = image.x + x, sx = clamp(x, 0, image.width - 1);
+            if (tx < 0 || tx >= atlasWidth) {
+                continue;
+            }
+            memcpy(&atlas[(ty * atlasWidth + tx) * 4], &image.pixels[(sy * image.width + sx) * 4], 4);
+        }
+    }
+}
+
+/**
+ * HalveLevel() Box-Filter A Mip Level Into The Next One
+ *
+ * @param source Byte Pointer RGBA8
+ * @param width Integer Source Width
+ * @param height Integer Source Height
+ * @param target Byte Collection Output
+ */
+void HalveLevel(const uint8_t *source, int width, int height, vector<uint8_t> &target) {
+    int halfWidth = max(1, width / 2), halfHeight = max(1, height / 2);
+    target.assign(halfWidth * halfHeight * 4, 0);
+    for (int y = 0; y < halfHeight; y++) {
+        int y0 = min(2 * y, height - 1), y1 = min(2 * y + 1, height - 1);
+        for (int x = 0; x < halfWidth; x++) {
+            int x0 = min(2 * x, width - 1), x1 = min(2 * x + 1, width - 1);
+            for (int c = 0; c < 4; c++) {
+                int sum = source[(y0 * width + x0) * 4 + c] + source[(y0 * width + x1) * 4 + c] +
+                          source[(y1 * width + x0) * 4 + c] + source[(y1 * width + x1) * 4 + c];
+                target[(y * halfWidth + x) * 4 + c] = (uint8_t) ((sum + 2) / 4);
+            }
+        }
+    }
+}
+
+int main(int ac, char **av) {
+    string outPath;
+    int maxEdge = ATLAS_DEFAULT_MAX_EDGE;
+    vector<string> inputs;
+    for (int i = 1; i < ac; i++) {
+        if (strcmp(av[i], "-o") == 0 && i + 1 < ac) {
+            outPath = av[++i];
+        } else if (strcmp(av[i], "--max-edge") == 0 && i + 1 < ac) {
+            maxEdge = max(1, atoi(av[++i]));
+        } else {
+            inputs.push_back(av[i]);
+        }
+    }
+    if (outPath.empty() || inputs.empty()) {
+        fprintf(stderr, "usage: %s [--max-edge N] -o <bundle> <image>...\n", av[0]);
+        return 1;
+    }
+
+    // Decode Everything As RGBA8, bottom row first like ReadTexture
+    stbi_set_flip_vertically_on_load(true);
+    vector<PackImage> images;
+    for (const string &path: inputs) {
+        PackImage image;
+        int channels = 0;
+        uint8_t *data = stbi_load(path.c_str(), &image.width, &image.height, &channels, 4);
+        if (data == nullptr) {
+            fprintf(stderr, "can't open %s (%s)\n", path.c_str(), stbi_failure_reason());
+            return 1;
+        }
+        image.pixels.assign(data, data + image.width * image.height * 4);
+        stbi_image_free(data);
+        image.name = RegionName(path);
+        if (image.name.size() >= ATLAS_REGION_NAME_SIZE) {
+            fprintf(stderr, "region name too long: %s\n", image.name.c_str());
+            return 1;
+        }
+        Downscale(image, maxEdge);
+        images.push_back(move(image));
+    }
+    sort(images.begin(), images.end(), [](const PackImage &a, const PackImage &b) { return a.height > b.height; });
+
+    // Smallest Power-Of-Two Atlas That Holds Every Image
+    int bestWidth = 0, bestHeight = 0;
+    for (int width = 64; width <= ATLAS_MAX_SIZE; width *= 2) {
+        int used = ShelfPack(images, width);
+        if (used < 0) {
+            continue;
+        }
+        int height = NextPowerOfTwo(used);
+        if (height <= ATLAS_MAX_SIZE && (bestWidth == 0 || (long long) width * height < (long long) bestWidth * bestHeight)) {
+            bestWidth = width;
+            bestHeight = height;
+        }
+    }
+    if (bestWidth == 0) {
+        fprintf(stderr, "images do not fit in a %dx%d atlas\n", ATLAS_MAX_SIZE, ATLAS_MAX_SIZE);
+        return 1;
+    }
+    ShelfPack(images, bestWidth);
+
+    vector<uint8_t> atlas(bestWidth * bestHeight * 4, 0);
+    vector<AtlasRegion> regions;
+    for (const PackImage &image: images) {
+        Blit(atlas, bestWidth, bestHeight, image);
+        AtlasRegion region;
+        strncpy(region.name, image.name.c_str(), ATLAS_REGION_NAME_SIZE - 1);
+        region.u0 = (float) image.x / bestWidth;
+        region.v0 = (float) image.y / bestHeight;
+        region.u1 = (float) (image.x + image.width) / bestWidth;
+        region.v1 = (float) (image.y + image.height) / bestHeight;
+        region.width = image.width;
+        region.height = image.height;
+        regions.push_back(region);
+    }
+
+    // Full Mip Chain, stored back to back
+    vector<AtlasMipLevel> mips;
+    vector<uint8_t> pixels = atlas, level = atlas, nextLevel;
+    int width = bestWidth, height = bestHeight;
+    mips.push_back({0, (uint32_t) width, (uint32_t) height});
+    while (width > 1 || height > 1) {
+        HalveLevel(level.data(), width, height, nextLevel);
+        width = max(1, width / 2);
+        height = max(1, height / 2);
+        mips.push_back({(uint32_t) pixels.size(), (uint32_t) width, (uint32_t) height});
+        pixels.insert(pixels.end(), nextLevel.begin(), nextLevel.end());
+        level.swap(nextLevel);
+    }
+
+    AtlasBundleHeader header;
+    header.width = bestWidth;
+    header.height = bestHeight;
+    header.mipCount = (uint32_t) mips.size();
+    header.regionCount = (uint32_t) regions.size();
+    size_t tableEnd = sizeof(header) + regions.size() * sizeof(AtlasRegion) + mips.size() * sizeof(AtlasMipLevel);
+    header.pixelOffset = (uint32_t) ((tableEnd + ATLAS_PIXEL_ALIGNMENT - 1) / ATLAS_PIXEL_ALIGNMENT *
+                                     ATLAS_PIXEL_ALIGNMENT);
+    header.pixelBytes = (uint32_t) pixels.size();
+
+    FILE *out = fopen(outPath.c_str(), "wb");
+    if (out == nullptr) {
+        fprintf(stderr, "can't write %s\n", outPath.c_str());
+        return 1;
+    }
+    const uint8_t zeros[ATLAS_PIXEL_ALIGNMENT] = {};
+    fwrite(&header, sizeof(header), 1, out);
+    fwrite(regions.data(), sizeof(AtlasRegion), regions.size(), out);
+    fwrite(mips.data(), sizeof(AtlasMipLevel), mips.size(), out);
+    fwrite(zeros, 1, header.pixelOffset - tableEnd, out);
+    fwrite(pixels.data(), 1, pixels.size(), out);
+    fclose(out);
+
+    printf("packed %zu images into %dx%d (%u mips, %u bytes)\n", images.size(), bestWidth, bestHeight,
+           header.mipCount, header.pixelOffset + header.pixelBytes);
+    return 0;
+}
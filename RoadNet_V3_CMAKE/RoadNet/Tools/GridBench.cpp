@@ -0,0 +1,147 @@
+// GridBench.cpp - grid drawing cost from 14x14 up to 4096x4096 cells
+// Team 8 (Edwin Kaburu, Vincent Marklynn, Yong Long Tan)
+// Usage: RoadRealmGridBench [frames]
+//        Compares per-cell quads (immediate Quad and a DrawList batch) with the single-quad GridRenderer.
+//        Per-cell paths are skipped on grids where a frame would take seconds.
+
+#include <glad.h>
+#include <GLFW/glfw3.h>
+#include "Draw.h"
+#include "DrawList.h"
+#include "GLState.h"
+#include "GLXtras.h"
+#include "StreamBuffer.h"
+#include "../GridRenderer.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+using namespace std;
+
+#define BENCH_VIEWPORT 1024
+// Cells Changed Per Steady Frame, about what a player's drag touches
+#define BENCH_DIRTY_CELLS 16
+// Largest Grids The Per-Cell Paths Run On
+#define BENCH_IMMEDIATE_MAX 256
+#define BENCH_DRAWLIST_MAX 1024
+
+using BenchClock = chrono::steady_clock;
+
+double Milliseconds(BenchClock::duration d) { return chrono::duration<double, milli>(d).count(); }
+
+/**
+ * @struct FrameCost
+ * @details Mean Per-Frame Cost, CPU submission alone and until the GPU has finished
+ */
+struct FrameCost {
+    double cpuMs = 0, totalMs = 0;
+};
+
+/**
+ * Measure() Run A Frame Function Repeatedly
+ *
+ * @param frames Integer Frame Count
+ * @param frame Callable Drawing One Frame
+ * @return FrameCost
+ */
+template<typename Frame>
+FrameCost Measure(int frames, Frame frame) {
+    FrameCost cost;
+    glFinish();
+    for (int i = 0; i < frames; i++) {
+        BenchClock::time_point start = BenchClock::now();
+        frame(i);
+        VertexStream().EndFrame();
+        BenchClock::time_point submitted = BenchClock::now();
+        glFinish();
+        cost.cpuMs += Milliseconds(submitted - start);
+        cost.totalMs += Milliseconds(BenchClock::now() - start);
+    }
+    cost.cpuMs /= frames;
+    cost.totalMs /= frames;
+    return cost;
+}
+
+void PrintCost(const char *label, int size, FrameCost cost) {
+    printf("%-12s %5dx%-5d %10.3f %10.3f\n", label, size, size, cost.cpuMs, cost.totalMs);
+}
+
+int main(int ac, char **av) {
+    int frames = ac > 1 ? max(1, atoi(av[1])) : 60;
+    glfwInit();
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    GLFWwindow *window = InitGLFW(0, 0, BENCH_VIEWPORT, BENCH_VIEWPORT, "RoadRealm Grid Bench", false);
+    if (window == nullptr) {
+        fprintf(stderr, "no OpenGL context\n");
+        return 1;
+    }
+    glfwSwapInterval(0);
+    SetViewport(0, 0, BENCH_VIEWPORT, BENCH_VIEWPORT);
+    glDisable(GL_DEPTH_TEST);
+    mat4 view = ScreenMode();
+    UseDrawShader(view);
+
+    const vec3 colors[] = {vec3(1, 1, 1), vec3(1, .5f, 0), vec3(.5f, .5f, .5f), vec3(0, 0, 1), vec3(1, 0, 0)};
+    const int nColors = sizeof(colors) / sizeof(colors[0]);
+    mt19937 rng(7);
+
+    printf("%-12s %-11s %10s %10s   (mean per frame over %d frames)\n", "path", "grid", "cpu ms", "total ms", frames);
+    GridRenderer grid;
+    DrawList list;
+    for (int size: {14, 64, 256, 1024, 4096}) {
+        // Cells Never Smaller Than 2 Pixels, larger grids run past the viewport and are clipped like a scrolled map
+        float pitch = max((float) BENCH_VIEWPORT / (float) size, 2.0f);
+        vector<uint8_t> cells((size_t) size * size);
+        for (uint8_t &cell: cells) {
+            cell = (uint8_t) (rng() % nColors);
+        }
+        uniform_int_distribution<int> anyCell(0, size * size - 1);
+
+        if (size <= BENCH_IMMEDIATE_MAX) {
+            PrintCost("immediate", size, Measure(max(1, frames / 10), [&](int) {
+                for (int i = 0; i < size * size; i++) {
+                    float x = (float) (i % size) * pitch, y = (float) (i / size) * pitch, w = pitch - 1;
+                    Quad(x, y, x, y + w, x + w, y + w, x + w, y, true, colors[cells[i]]);
+                }
+            }));
+        }
+        if (size <= BENCH_DRAWLIST_MAX) {
+            PrintCost("drawlist", size, Measure(frames, [&](int) {
+                for (int i = 0; i < size * size; i++) {
+                    list.Rectangle((float) (i % size) * pitch, (float) (i / size) * pitch, pitch - 1, pitch - 1,
+                                   colors[cells[i]]);
+                }
+                list.Flush(view);
+            }));
+        }
+
+        BenchClock::time_point start = BenchClock::now();
+        grid.Resize(size, size);
+        for (int i = 0; i < size * size; i++) {
+            grid.SetCellColor(i, colors[cells[i]]);
+        }
+        grid.Draw(view, vec2(0, 0), vec2(pitch, pitch));
+        glFinish();
+        printf("%-12s %5dx%-5d %10s %10.3f\n", "grid upload", size, size, "", Milliseconds(BenchClock::now() - start));
+
+        ResetGLStats();
+        PrintCost("grid", size, Measure(frames, [&](int) {
+            grid.Draw(view, vec2(0, 0), vec2(pitch, pitch));
+        }));
+        const GLStateCounters &stats = GLStats();
+        printf("%-12s %5dx%-5d %6.1f issued %6.1f skipped %d queries per frame\n", "grid gl", size, size,
+               (float) stats.Issued() / frames, (float) stats.Skipped() / frames, stats.queries);
+        PrintCost("grid+dirty", size, Measure(frames, [&](int frame) {
+            for (int i = 0; i < BENCH_DIRTY_CELLS; i++) {
+                grid.SetCellColor(anyCell(rng), colors[(frame + i) % nColors]);
+            }
+            grid.Draw(view, vec2(0, 0), vec2(pitch, pitch));
+        }));
+    }
+    grid.Release();
+    list.Release();
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return 0;
+}
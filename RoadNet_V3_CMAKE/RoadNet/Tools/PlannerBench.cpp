@@ -0,0 +1,186 @@
+// PlannerBench.cpp - drag preview update latency of the D* Lite planner on a large grid
+// Team 8 (Edwin Kaburu, Vincent Marklynn, Yong Long Tan)
+// Usage: RoadRealmPlannerBench [size] [updates]
+//        Drags a cursor across a size x size grid with scattered closed cells, closing each cell it leaves as the game
+//        does, and times every update. The cursor moves on every update, following the last settled preview while a
+//        repair carries over or heading for the factory once off it, so repairs are measured in updates to settle as
+//        well as time per update. A new drag starts when the cursor boxes itself in. Fails if the p99 update takes
+//        longer than the 1 ms target.
+//        Build with CMAKE_BUILD_TYPE=Release; unoptimized timings mean little.
+
+#include <glad.h>
+#include "Text.h"
+#include "../PathPlanner.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+using namespace std;
+
+#define BENCH_SIZE 1024
+#define BENCH_UPDATES 2000
+// Share Of Cells Closed Before A Drag, well under the point where the grid falls apart into islands
+#define BENCH_BLOCKED_PERCENT 25
+// Every Nth Move The Cursor Leaves The Previewed Path, so the planner has something to repair
+#define BENCH_DETOUR_EVERY 3
+#define BENCH_TARGET_MS 1.0
+
+using BenchClock = chrono::steady_clock;
+
+double Milliseconds(BenchClock::duration d) { return chrono::duration<double, milli>(d).count(); }
+
+/**
+ * OpenStepToward() Open Neighbour Of A Cell Closest To A Target
+ *
+ * @param from NodePosition Cell
+ * @param target NodePosition Target Cell
+ * @param blocked Byte Collection, one entry per cell
+ * @param size Integer Grid Size
+ * @param step NodePosition Output
+ * @return Boolean Condition, false if every neighbour is closed
+ */
+bool OpenStepToward(NodePosition from, NodePosition target, const vector<uint8_t> &blocked, int size,
+                    NodePosition &step) {
+    const int dRows[4] = {-1, 1, 0, 0}, dCols[4] = {0, 0, -1, 1};
+    int best = -1;
+    for (int i = 0; i < 4; i++) {
+        NodePosition cell(from.row + dRows[i], from.col + dCols[i]);
+        if (cell.row < 0 || cell.row >= size || cell.col < 0 || cell.col >= size || blocked[cell.row * size + cell.col]) {
+            continue;
+        }
+        int distance = abs(target.row - cell.row) + abs(target.col - cell.col);
+        if (best < 0 || distance < best) {
+            best = distance;
+            step = cell;
+        }
+    }
+    return best >= 0;
+}
+
+/**
+ * Percentile() Value Below Which A Share Of Sorted Samples Fall
+ *
+ * @param sorted Double Collection, ascending
+ * @param percent Integer Share
+ * @return Double Sample
+ */
+double Percentile(const vector<double> &sorted, int percent) {
+    return sorted[min(sorted.size() - 1, sorted.size() * percent / 100)];
+}
+
+int main(int ac, char **av) {
+    int size = ac > 1 ? max(16, atoi(av[1])) : BENCH_SIZE;
+    int updates = ac > 2 ? max(1, atoi(av[2])) : BENCH_UPDATES;
+
+    mt19937 rng(7);
+    vector<uint8_t> obstacles((size_t) size * size);
+    for (uint8_t &cell: obstacles) {
+        cell = (int) (rng() % 100) < BENCH_BLOCKED_PERCENT;
+    }
+
+    DStarLitePlanner planner;
+    vector<uint8_t> blocked;
+    vector<NodePosition> path;
+    vector<double> updateMs, firstPlanMs, settleUpdates;
+    updateMs.reserve(updates);
+    long long expanded = 0;
+    int drags = 0, moves = 0, staleMoves = 0, boxedIn = 0;
+    while ((int) updateMs.size() < updates) {
+        // House Near One Corner, Factory Near The Other
+        int margin = size / 8 + (int) (rng() % (size / 16));
+        NodePosition cursor(margin, margin), factory(size - margin, size - margin);
+        blocked = obstacles;
+        BenchClock::time_point start = BenchClock::now();
+        planner.Begin(size, size, cursor, factory, blocked);
+        planner.ComputeShortestPath();
+        planner.ExtractPath(path);
+        firstPlanMs.push_back(Milliseconds(BenchClock::now() - start));
+        drags++;
+
+        // Step Of The Cursor Along The Last Settled Preview, and updates spent on the repair in progress
+        size_t pathStep = 1;
+        int unsettled = 0;
+        while ((int) updateMs.size() < updates) {
+            bool settled = planner.IsSettled();
+            if (settled && path.size() < 2) {
+                // Reached The Factory, or no way out of the cells the drag closed behind it
+                boxedIn += path.empty();
+                break;
+            }
+            // Next Cell Along The Preview, or an open side step off it; without a usable preview the cursor heads
+            // for the factory on its own, as a player would
+            NodePosition next = cursor;
+            bool onPath = pathStep < path.size() && !blocked[path[pathStep].row * size + path[pathStep].col];
+            bool offPath = !onPath, move = onPath || OpenStepToward(cursor, factory, blocked, size, next);
+            if (onPath) {
+                next = path[pathStep];
+                if (moves % BENCH_DETOUR_EVERY == 0) {
+                    int dRow = next.col != cursor.col, dCol = next.row != cursor.row;
+                    int side = rng() % 2 ? 1 : -1;
+                    NodePosition detour(cursor.row + dRow * side, cursor.col + dCol * side);
+                    if (detour.row >= 0 && detour.row < size && detour.col >= 0 && detour.col < size &&
+                        !blocked[detour.row * size + detour.col]) {
+                        next = detour;
+                        offPath = true;
+                    }
+                }
+            }
+            if (!move) {
+                // Every Side Closed, the player gives up on this drag
+                boxedIn++;
+                break;
+            }
+            moves++;
+            staleMoves += !settled;
+
+            // One Update, as RefreshDragPreview() runs it each tick
+            start = BenchClock::now();
+            planner.SetBlocked(cursor, true);
+            planner.MoveStart(next);
+            expanded += planner.ComputeShortestPath(PLANNER_EXPANSION_BUDGET);
+            if (planner.IsSettled()) {
+                planner.ExtractPath(path);
+            }
+            updateMs.push_back(Milliseconds(BenchClock::now() - start));
+
+            blocked[cursor.row * size + cursor.col] = 1;
+            cursor = next;
+            // Off The Preview After A Side Step, so the rest of it is no use until the repair settles
+            pathStep = offPath ? path.size() : pathStep + 1;
+            if (!planner.IsSettled()) {
+                unsettled++;
+            } else {
+                pathStep = 1;
+                if (unsettled > 0) {
+                    settleUpdates.push_back(unsettled + 1);
+                    unsettled = 0;
+                }
+            }
+        }
+        planner.End();
+    }
+
+    sort(updateMs.begin(), updateMs.end());
+    sort(firstPlanMs.begin(), firstPlanMs.end());
+    sort(settleUpdates.begin(), settleUpdates.end());
+    double total = 0;
+    for (double ms: updateMs) {
+        total += ms;
+    }
+    printf("%dx%d grid, %d%% closed, %d drags (%d boxed in), first plan median %.2f ms\n", size, size,
+           BENCH_BLOCKED_PERCENT, drags, boxedIn, Percentile(firstPlanMs, 50));
+    printf("%zu updates: mean %.4f ms, p99 %.4f ms, max %.4f ms, %.1f cells expanded per update\n", updateMs.size(),
+           total / (double) updateMs.size(), Percentile(updateMs, 99), updateMs.back(),
+           (double) expanded / (double) updateMs.size());
+    printf("%d moves, %d of them made while the preview was still being repaired\n", moves, staleMoves);
+    if (!settleUpdates.empty()) {
+        printf("%zu repairs carried over: median %.0f, p99 %.0f, max %.0f updates to settle\n", settleUpdates.size(),
+               Percentile(settleUpdates, 50), Percentile(settleUpdates, 99), settleUpdates.back());
+    } else {
+        printf("every repair settled within its update\n");
+    }
+    bool ok = Percentile(updateMs, 99) <= BENCH_TARGET_MS;
+    printf("p99 update %s the %.1f ms target\n", ok ? "meets" : "misses", BENCH_TARGET_MS);
+    return ok ? 0 : 1;
+}
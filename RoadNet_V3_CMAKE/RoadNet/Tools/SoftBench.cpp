@@ -0,0 +1,108 @@
+// SoftBench.cpp - board frames drawn by the CPU software rasterizer, no GPU or GL context needed
+// Team 8 (Edwin Kaburu, Vincent Marklynn, Yong Long Tan)
+// Usage: RoadRealmSoftBench [frames] [image.png]
+//        Draws a board of cells, depots, roads, runner dots and labels into a SoftTarget with 1, 2, 4... threads,
+//        then saves the last frame.
+
+#include <glad.h>
+#include "Draw.h"
+#include "DrawList.h"
+#include "IO.h"
+#include "Letters.h"
+#include "SoftRaster.h"
+#include "../GridRenderer.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+
+using namespace std;
+
+#define BENCH_WIDTH 1000
+#define BENCH_HEIGHT 800
+#define BENCH_GRID 32
+#define BENCH_ROADS 64
+#define BENCH_DOTS 2000
+
+using BenchClock = chrono::steady_clock;
+
+/**
+ * @struct BenchRoad
+ * @details Random Walk Between Two Cells, drawn as a polyline with a dot on it
+ */
+struct BenchRoad {
+    vector<vec2> cells;
+    vec3 color;
+};
+
+int main(int ac, char **av) {
+    int frames = ac > 1 ? max(1, atoi(av[1])) : 60;
+    const char *imageFile = ac > 2 ? av[2] : "softbench.png";
+    SoftTarget target;
+    target.Resize(BENCH_WIDTH, BENCH_HEIGHT);
+    SetSoftTarget(&target);
+
+    const vec3 colors[] = {vec3(1, 1, 1), vec3(1, .5f, 0), vec3(.5f, .5f, .5f), vec3(0, 0, 1), vec3(1, 0, 0)};
+    const int nColors = sizeof(colors) / sizeof(colors[0]);
+    mt19937 rng(7);
+    float pitch = (float) BENCH_HEIGHT / BENCH_GRID;
+    vec2 origin(20, 0);
+
+    GridRenderer grid;
+    grid.Resize(BENCH_GRID, BENCH_GRID);
+    for (int i = 0; i < BENCH_GRID * BENCH_GRID; i++) {
+        grid.SetCellColor(i, colors[rng() % nColors]);
+    }
+    vector<BenchRoad> roads(BENCH_ROADS);
+    for (BenchRoad &road: roads) {
+        vec2 cell((float) (rng() % BENCH_GRID), (float) (rng() % BENCH_GRID));
+        for (int step = 0; step < 24; step++) {
+            road.cells.push_back(cell);
+            vec2 move = rng() % 2 ? vec2(rng() % 2 ? 1.f : -1.f, 0.f) : vec2(0.f, rng() % 2 ? 1.f : -1.f);
+            cell = vec2(clamp(cell.x + move.x, 0.f, BENCH_GRID - 1.f), clamp(cell.y + move.y, 0.f, BENCH_GRID - 1.f));
+        }
+        road.color = vec3((float) (rng() % 256) / 255, (float) (rng() % 256) / 255, (float) (rng() % 256) / 255);
+    }
+
+    mat4 view = ScreenMode();
+    DrawList list;
+    TextBatch labels;
+    int maxThreads = max(1, (int) thread::hardware_concurrency());
+    printf("%-8s %10s   (mean per frame over %d frames, %dx%d)\n", "threads", "ms", frames, BENCH_WIDTH, BENCH_HEIGHT);
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        target.SetThreads(threads);
+        BenchClock::time_point start = BenchClock::now();
+        for (int frame = 0; frame < frames; frame++) {
+            target.Clear(vec3(0, 0, 0));
+            grid.Draw(view, origin, vec2(pitch, pitch));
+            for (size_t r = 0; r < roads.size(); r++) {
+                const BenchRoad &road = roads[r];
+                for (size_t i = 1; i < road.cells.size(); i++) {
+                    list.Line(origin + (road.cells[i - 1] + vec2(.5f, .5f)) * pitch,
+                              origin + (road.cells[i] + vec2(.5f, .5f)) * pitch, 2.5f, road.color);
+                }
+                float t = (float) ((frame + r * 7) % 100) / 100 * (float) (road.cells.size() - 1);
+                int i = (int) t;
+                vec2 a = road.cells[i], b = road.cells[min(i + 1, (int) road.cells.size() - 1)];
+                list.Disk(origin + (a + (t - (float) i) * (b - a) + vec2(.5f, .5f)) * pitch, pitch * .5f, road.color);
+            }
+            for (int i = 0; i < BENCH_DOTS; i++) {
+                list.Disk(vec2((float) (i * 37 % BENCH_HEIGHT) + origin.x, (float) (i * 53 % BENCH_HEIGHT)), 6,
+                          colors[i % nColors], 1, i % 3 == 0);
+            }
+            list.Flush(view);
+            for (int i = 0; i < 10; i++) {
+                labels.Add(BENCH_HEIGHT + 30, BENCH_HEIGHT - 20 * (i + 1), "Frame 123 Runners 64", vec3(1, 1, 0), 10);
+            }
+            labels.Flush(view);
+            target.Resolve();
+        }
+        double ms = chrono::duration<double, milli>(BenchClock::now() - start).count() / frames;
+        printf("%-8d %10.3f\n", threads, ms);
+    }
+    SavePng(imageFile);
+    printf("saved %s\n", imageFile);
+    SetSoftTarget(nullptr);
+    return 0;
+}
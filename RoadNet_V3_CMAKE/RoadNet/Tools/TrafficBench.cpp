@@ -0,0 +1,105 @@
+// TrafficBench.cpp - traffic mode tick cost with 100k+ vehicles on a large grid
+// Team 8 (Edwin Kaburu, Vincent Marklynn, Yong Long Tan)
+// Usage: RoadRealmTrafficBench [agents] [ticks]
+//        Links enough random L-shaped roads across a 1024x1024 grid to carry the requested number of vehicles, lets
+//        the houses dispatch until that many are on the roads, then times fixed ticks against the traffic tick rate.
+//        Build with CMAKE_BUILD_TYPE=Release; unoptimized timings mean little.
+
+#include <glad.h>
+#include "Text.h"
+#include "../Traffic.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+using namespace std;
+
+#define BENCH_GRID 1024
+#define BENCH_AGENTS 100000
+#define BENCH_TICKS 300
+// Shortest And Longest Road, in cells
+#define BENCH_ROAD_MIN 20
+#define BENCH_ROAD_MAX 60
+// Ticks Allowed For The Houses To Fill The Roads, each dispatches one vehicle every TRAFFIC_DISPATCH_TICKS
+#define BENCH_WARMUP_MAX (4 * TRAFFIC_DISPATCH_TICKS * TRAFFIC_MAX_AGENTS_PER_ROAD)
+
+using BenchClock = chrono::steady_clock;
+
+double Milliseconds(BenchClock::duration d) { return chrono::duration<double, milli>(d).count(); }
+
+/**
+ * RandomRoad() Cells Of An L-Shaped Road, a horizontal stretch then a vertical one
+ *
+ * @param rng Random Engine
+ * @return NodePosition Collection, house first
+ */
+vector<NodePosition> RandomRoad(mt19937 &rng) {
+    int length = BENCH_ROAD_MIN + (int) (rng() % (BENCH_ROAD_MAX - BENCH_ROAD_MIN + 1));
+    int across = 1 + (int) (rng() % (length - 1));
+    int colStep = rng() % 2 ? 1 : -1, rowStep = rng() % 2 ? 1 : -1;
+    int row = (int) (rng() % (BENCH_GRID - 2 * BENCH_ROAD_MAX)) + BENCH_ROAD_MAX;
+    int col = (int) (rng() % (BENCH_GRID - 2 * BENCH_ROAD_MAX)) + BENCH_ROAD_MAX;
+    vector<NodePosition> cells;
+    cells.push_back(NodePosition(row, col));
+    for (int i = 1; i < length; i++) {
+        i < across ? col += colStep : row += rowStep;
+        cells.push_back(NodePosition(row, col));
+    }
+    return cells;
+}
+
+int main(int ac, char **av) {
+    int agentTarget = ac > 1 ? max(1, atoi(av[1])) : BENCH_AGENTS;
+    int ticks = ac > 2 ? max(1, atoi(av[2])) : BENCH_TICKS;
+    // A Fifth More Roads Than Full Roads Would Need, as depots and lanes hold some houses back
+    int roadCount = agentTarget * 6 / 5 / TRAFFIC_MAX_AGENTS_PER_ROAD + 1;
+
+    mt19937 rng(7);
+    GAME_RNG.seed(7);
+    TrafficSimulator traffic(BENCH_GRID, BENCH_GRID);
+    vector<PackedPath> paths;
+    paths.reserve(roadCount);
+    for (int i = 0; i < roadCount; i++) {
+        paths.push_back(PackedPath::Encode(RandomRoad(rng)));
+        pmr::string key(to_string(i).c_str(), GAME_ARENA.Resource());
+        traffic.AddRoad(key, paths.back(), vec3((float) (rng() % 256) / 255, (float) (rng() % 256) / 255, 1));
+    }
+
+    const float tickLength = 1.0f / TRAFFIC_TICK_RATE;
+    int warmup = 0;
+    BenchClock::time_point start = BenchClock::now();
+    while (traffic.AgentCount() < agentTarget && warmup < BENCH_WARMUP_MAX) {
+        traffic.Update(tickLength);
+        warmup++;
+    }
+    printf("%d roads on a %dx%d grid, %d vehicles after %d warm-up ticks (%.1f s)\n", roadCount, BENCH_GRID,
+           BENCH_GRID, traffic.AgentCount(), warmup, chrono::duration<double>(BenchClock::now() - start).count());
+
+    vector<double> tickMs;
+    tickMs.reserve(ticks);
+    int lowestAgents = traffic.AgentCount();
+    long long tripsBefore = traffic.CompletedTrips();
+    for (int i = 0; i < ticks; i++) {
+        start = BenchClock::now();
+        traffic.Update(tickLength);
+        tickMs.push_back(Milliseconds(BenchClock::now() - start));
+        lowestAgents = min(lowestAgents, traffic.AgentCount());
+    }
+
+    sort(tickMs.begin(), tickMs.end());
+    double total = 0;
+    for (double ms: tickMs) {
+        total += ms;
+    }
+    double p99 = tickMs[min(tickMs.size() - 1, tickMs.size() * 99 / 100)], budgetMs = 1000.0 / TRAFFIC_TICK_RATE;
+    printf("%d ticks, at least %d vehicles: mean %.3f ms, p99 %.3f ms, max %.3f ms per tick\n", ticks, lowestAgents,
+           total / ticks, p99, tickMs.back());
+    printf("congestion %.0f%%, %lld trips completed while timing\n", traffic.CongestionIndex() * 100,
+           traffic.CompletedTrips() - tripsBefore);
+    bool ok = lowestAgents >= agentTarget && p99 <= budgetMs;
+    printf("%s the %d Hz tick rate (%.1f ms) with %d vehicles\n", ok ? "keeps" : "misses", TRAFFIC_TICK_RATE,
+           budgetMs, agentTarget);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,642 @@
+/**
+ * @file Traffic.h
+ * @author Team 8: Edwin Kaburu, Vincent Marklynn, Yong Long Tan
+ * @date 10/19/2026
+ */
+
+#ifndef ROADREALM_TRAFFIC_H
+#define ROADREALM_TRAFFIC_H
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <memory_resource>
+#include <unordered_map>
+#include <vector>
+#include "RoadNetShared.h"
+
+// Ticks Per Second Of The Traffic Simulation
+#define TRAFFIC_TICK_RATE 30
+// Maximum Ticks Caught Up In One Frame
+#define TRAFFIC_MAX_TICKS_PER_FRAME 8
+// Vehicles Allowed Per Lane Of A Road Cell
+#define TRAFFIC_LANE_CAPACITY 2
+// Vehicles Allowed Per Lane Of A House Or Factory Cell
+#define TRAFFIC_DEPOT_CAPACITY 1
+// Ticks A Vehicle Spends Unloading At A Factory
+#define TRAFFIC_SERVICE_TICKS 20
+// Ticks Between Two Departures From The Same House
+#define TRAFFIC_DISPATCH_TICKS 25
+// Vehicles Alive On One Road At Once
+#define TRAFFIC_MAX_AGENTS_PER_ROAD 12
+// Base Speed In Cells Per Second
+#define TRAFFIC_BASE_SPEED 2.5f
+// Ticks Reserved Ahead In The Space-Time Reservation Table
+#define TRAFFIC_RESERVATION_HORIZON 4
+
+/**
+ * @class ReservationTable
+ * @details Space-Time Reservation Table, one slice of lane-cell counters per future tick. Only touched counters are
+ * cleared when a slice is recycled, so the cost of a tick follows the number of moving vehicles, not the grid size.
+ */
+class ReservationTable {
+private:
+    struct Slice {
+        long long tick = -1;
+        vector<uint16_t> counts;
+        vector<int> touched;
+    };
+
+    Slice slices[TRAFFIC_RESERVATION_HORIZON];
+
+    /**
+     * SliceFor() Slice Holding A Given Tick, recycling an expired slice when needed
+     *
+     * @param tick Long Tick
+     * @return Slice Reference
+     */
+    Slice &SliceFor(long long tick) {
+        Slice &slice = slices[tick % TRAFFIC_RESERVATION_HORIZON];
+        if (slice.tick != tick) {
+            for (int laneCell: slice.touched) {
+                slice.counts[laneCell] = 0;
+            }
+            slice.touched.clear();
+            slice.tick = tick;
+        }
+        return slice;
+    }
+
+public:
+    /**
+     * Resize() Allocate Counters For Every Lane Cell
+     *
+     * @param laneCellCount Integer Number Of Lane Cells
+     */
+    void Resize(int laneCellCount) {
+        for (Slice &slice: slices) {
+            slice.counts.assign(laneCellCount, 0);
+            slice.touched.clear();
+            slice.tick = -1;
+        }
+    }
+
+    /**
+     * ReserveTouched() Room For Every Vehicle To Claim A Lane Cell In Every Slice
+     *
+     * @param agentCapacity Integer Most Vehicles Expected
+     */
+    void ReserveTouched(int agentCapacity) {
+        for (Slice &slice: slices) {
+            slice.touched.reserve(agentCapacity);
+        }
+    }
+
+    /**
+     * Reserved() Number Of Vehicles Holding A Lane Cell At A Tick
+     *
+     * @param laneCell Integer Lane Cell
+     * @param tick Long Tick
+     * @return Integer Count
+     */
+    int Reserved(int laneCell, long long tick) {
+        return SliceFor(tick).counts[laneCell];
+    }
+
+    /**
+     * Reserve() Claim A Lane Cell At A Tick
+     *
+     * @param laneCell Integer Lane Cell
+     * @param tick Long Tick
+     */
+    void Reserve(int laneCell, long long tick) {
+        Slice &slice = SliceFor(tick);
+        if (slice.counts[laneCell]++ == 0) {
+            slice.touched.push_back(laneCell);
+        }
+    }
+};
+
+/**
+ * @class SpatialHash
+ * @details Vehicles bucketed by lane cell with a counting sort into a power-of-two table sized by vehicle count,
+ * rebuilt every tick. Neighbour queries only visit the bucket of the queried lane cell.
+ */
+class SpatialHash {
+private:
+    uint32_t bucketMask = 0;
+    vector<int> bucketStart, bucketCursor, bucketItems, itemKeys;
+
+    /**
+     * Bucket() Hash A Lane Cell To A Bucket
+     *
+     * @param laneCell Integer Lane Cell
+     * @return Unsigned Bucket
+     */
+    uint32_t Bucket(int laneCell) const {
+        return ((uint32_t) laneCell * 2654435761u) & bucketMask;
+    }
+
+    /**
+     * BucketCount() Buckets For A Number Of Items, a power of two at least twice the items
+     *
+     * @param itemCount Size Items
+     * @return Unsigned Bucket Count
+     */
+    static uint32_t BucketCount(size_t itemCount) {
+        uint32_t bucketCount = 16;
+        while (bucketCount < itemCount * 2) {
+            bucketCount <<= 1;
+        }
+        return bucketCount;
+    }
+
+public:
+    /**
+     * Reserve() Size The Table For A Number Of Items Up Front, so rebuilds up to that many do not allocate
+     *
+     * @param itemCount Integer Most Items Expected
+     */
+    void Reserve(int itemCount) {
+        uint32_t bucketCount = BucketCount(itemCount);
+        bucketStart.reserve(bucketCount + 1);
+        bucketCursor.reserve(bucketCount);
+        bucketItems.reserve(itemCount);
+        itemKeys.reserve(itemCount);
+    }
+
+    /**
+     * Build() Rebuild The Table From The Lane Cell Of Every Item
+     *
+     * @param keys Integer Collection, lane cell per item
+     */
+    void Build(const vector<int> &keys) {
+        uint32_t bucketCount = BucketCount(keys.size());
+        bucketMask = bucketCount - 1;
+        bucketStart.assign(bucketCount + 1, 0);
+        bucketItems.resize(keys.size());
+        itemKeys = keys;
+
+        for (int key: keys) {
+            bucketStart[Bucket(key) + 1]++;
+        }
+        for (uint32_t i = 0; i < bucketCount; i++) {
+            bucketStart[i + 1] += bucketStart[i];
+        }
+        bucketCursor.assign(bucketStart.begin(), bucketStart.end() - 1);
+        for (int item = 0; item < (int) keys.size(); item++) {
+            bucketItems[bucketCursor[Bucket(keys[item])]++] = item;
+        }
+    }
+
+    /**
+     * ForEachInCell() Visit Every Item Stored Under A Lane Cell
+     *
+     * @tparam F Visitor Type
+     * @param laneCell Integer Lane Cell
+     * @param visit Visitor, called with the item index
+     */
+    template<typename F>
+    void ForEachInCell(int laneCell, F visit) const {
+        if (bucketStart.empty()) {
+            return;
+        }
+        uint32_t bucket = Bucket(laneCell);
+        for (int i = bucketStart[bucket]; i < bucketStart[bucket + 1]; i++) {
+            if (itemKeys[bucketItems[i]] == laneCell) {
+                visit(bucketItems[i]);
+            }
+        }
+    }
+};
+
+/**
+ * @struct TrafficAgent
+ * @details A Vehicle Moving Cell By Cell Along A Road
+ */
+struct TrafficAgent {
+    int roadIndex = 0;
+    PathCursor cursor;
+    int direction = 1;
+    float progress = 0;
+    float speedScale = 1;
+    int serviceTicks = 0;
+    bool waiting = false;
+    bool finished = false;
+};
+
+/**
+ * @struct TrafficRoad
+ * @details A Linked Road And Its Dispatch State
+ */
+struct TrafficRoad {
+    PathView path;
+    vec3 color;
+    int dispatchTicks = 0;
+    int agentCount = 0;
+    bool alive = false;
+};
+
+/**
+ * @struct TrafficDot
+ * @details Drawable Position Of A Vehicle, in fractional grid cells
+ */
+struct TrafficDot {
+    float row = 0, col = 0;
+    vec3 color;
+};
+
+/**
+ * DrawTrafficDots() Draw Vehicles Collected From A Traffic Simulator
+ *
+ * @param list DrawList Batch To Append To
+ * @param dots TrafficDot Collection
+ * @param diameter Float Dot Diameter
+ */
+void DrawTrafficDots(DrawList &list, const vector<TrafficDot> &dots, float diameter) {
+    for (const TrafficDot &dot: dots) {
+        list.Disk(vec2(X_POS + (dot.col + .5f) * DX, Y_POS + (dot.row + .5f) * DY), diameter, dot.color);
+    }
+}
+
+/**
+ * @class TrafficSimulator
+ * @details Optional traffic mode: vehicles leave their house, queue behind each other, unload at the factory and
+ * return. Lane cells are claimed through the reservation table and neighbours are found through the spatial hash.
+ */
+class TrafficSimulator {
+private:
+    // Road Bookkeeping Lives In The Game Arena, so linking a road stays off the heap
+    pmr::vector<TrafficRoad> roads{GAME_ARENA.Resource()};
+    pmr::vector<int> freeRoads{GAME_ARENA.Resource()};
+    pmr::unordered_map<pmr::string, int> roadIndexByKey{GAME_ARENA.Resource()};
+    vector<TrafficAgent> agents;
+
+    vector<uint16_t> laneOccupancy;
+    vector<int> agentLaneCells;
+    vector<pair<int, int>> pendingLaneMoves;
+    ReservationTable reservations;
+    SpatialHash agentHash;
+
+    int gridRows = 0, gridCols = 0;
+    long long currentTick = 0;
+    float tickAccumulator = 0;
+    double congestionIndex = 0;
+    long long completedTrips = 0;
+
+    /**
+     * LaneCell() Lane Cell Of A Path Step, vehicles heading out and heading home use separate lanes
+     *
+     * @param pos NodePosition
+     * @param direction Integer Direction Along The Path
+     * @return Integer Lane Cell
+     */
+    int LaneCell(NodePosition pos, int direction) const {
+        return (pos.row * gridCols + pos.col) * 2 + (direction > 0 ? 0 : 1);
+    }
+
+    /**
+     * LaneCell() Lane Cell Under A Path Cursor
+     *
+     * @param cursor PathCursor
+     * @param direction Integer Direction Along The Path
+     * @return Integer Lane Cell
+     */
+    int LaneCell(const PathCursor &cursor, int direction) const {
+        return LaneCell(NodePosition(cursor.row, cursor.col), direction);
+    }
+
+    /**
+     * LaneCapacity() Capacity Of A Path Step
+     *
+     * @param cursor PathCursor
+     * @return Integer Capacity
+     */
+    int LaneCapacity(const PathCursor &cursor) const {
+        bool isDepot = cursor.IsFirst() || cursor.IsLast();
+        return isDepot ? TRAFFIC_DEPOT_CAPACITY : TRAFFIC_LANE_CAPACITY;
+    }
+
+    /**
+     * TryEnter() Claim The Next Lane Cell For The Following Tick
+     *
+     * @param cursor PathCursor On The Next Cell
+     * @param direction Integer Direction
+     * @return Boolean Condition
+     */
+    bool TryEnter(const PathCursor &cursor, int direction) {
+        int laneCell = LaneCell(cursor, direction);
+        int held = laneOccupancy[laneCell] + reservations.Reserved(laneCell, currentTick + 1);
+        if (held >= LaneCapacity(cursor)) {
+            return false;
+        }
+        reservations.Reserve(laneCell, currentTick + 1);
+        return true;
+    }
+
+    /**
+     * LeaderLimit() Furthest Progress Allowed Behind Vehicles Ahead In The Same Lane Cell
+     *
+     * @param agentIndex Integer Agent Index
+     * @return Float Progress Limit
+     */
+    float LeaderLimit(int agentIndex) const {
+        const TrafficAgent &agent = agents[agentIndex];
+        float limit = 1.0f, spacing = 1.0f / TRAFFIC_LANE_CAPACITY;
+        agentHash.ForEachInCell(agentLaneCells[agentIndex], [&](int other) {
+            if (other != agentIndex && agents[other].progress > agent.progress) {
+                limit = min(limit, agents[other].progress - spacing);
+            }
+        });
+        return limit < agent.progress ? agent.progress : limit;
+    }
+
+    /**
+     * MoveLane() Transfer A Vehicle Between Lane Cells once the current tick finished, so occupancy always describes
+     * the start of the tick and vehicles entering during the tick are counted through their reservation
+     *
+     * @param fromLane Integer Lane Cell
+     * @param toLane Integer Lane Cell
+     */
+    void MoveLane(int fromLane, int toLane) {
+        pendingLaneMoves.push_back({fromLane, toLane});
+    }
+
+    /**
+     * Dispatch() Release New Vehicles From Every House Whose Timer Expired
+     */
+    void Dispatch() {
+        uniform_real_distribution<float> speedSpread(0.7f, 1.3f);
+        for (int roadIndex = 0; roadIndex < (int) roads.size(); roadIndex++) {
+            TrafficRoad &road = roads[roadIndex];
+            if (!road.alive || road.path.size() < 2 || --road.dispatchTicks > 0 ||
+                road.agentCount >= TRAFFIC_MAX_AGENTS_PER_ROAD) {
+                continue;
+            }
+            road.dispatchTicks = TRAFFIC_DISPATCH_TICKS;
+            int laneCell = LaneCell(road.path.begin(), 1);
+            if (laneOccupancy[laneCell] >= TRAFFIC_DEPOT_CAPACITY) {
+                continue;
+            }
+            TrafficAgent agent;
+            agent.roadIndex = roadIndex;
+            agent.cursor = road.path.begin();
+            agent.speedScale = speedSpread(GAME_RNG);
+            agents.push_back(agent);
+            laneOccupancy[laneCell]++;
+            road.agentCount++;
+        }
+    }
+
+    /**
+     * RemoveAgent() Swap-Remove A Vehicle
+     *
+     * @param agentIndex Integer Agent Index
+     */
+    void RemoveAgent(int agentIndex) {
+        TrafficAgent &agent = agents[agentIndex];
+        TrafficRoad &road = roads[agent.roadIndex];
+        laneOccupancy[LaneCell(agent.cursor, agent.direction)]--;
+        road.agentCount--;
+        agents[agentIndex] = agents.back();
+        agents.pop_back();
+    }
+
+    /**
+     * Tick() Advance Every Vehicle By One Fixed Step
+     */
+    void Tick() {
+        currentTick++;
+        Dispatch();
+
+        agentLaneCells.resize(agents.size());
+        for (size_t i = 0; i < agents.size(); i++) {
+            const TrafficAgent &agent = agents[i];
+            agentLaneCells[i] = LaneCell(agent.cursor, agent.direction);
+        }
+        agentHash.Build(agentLaneCells);
+
+        float baseStep = TRAFFIC_BASE_SPEED / TRAFFIC_TICK_RATE;
+        int waitingCount = 0, agentCount = (int) agents.size();
+        for (int i = 0; i < agentCount; i++) {
+            TrafficAgent &agent = agents[i];
+            agent.waiting = false;
+
+            // Unloading At The Factory
+            if (agent.serviceTicks > 0) {
+                agent.serviceTicks--;
+                continue;
+            }
+
+            float target = min(agent.progress + baseStep * agent.speedScale, LeaderLimit(i));
+            if (target < 1.0f) {
+                agent.waiting = target <= agent.progress;
+                agent.progress = target;
+            } else {
+                int currentLane = LaneCell(agent.cursor, agent.direction);
+                if (agent.direction < 0 && agent.cursor.IsFirst()) {
+                    // Trip Completed Back At The House
+                    completedTrips++;
+                    agent.finished = true;
+                    continue;
+                }
+                PathCursor next = agent.cursor;
+                if (agent.direction > 0 && agent.cursor.IsLast()) {
+                    // Turn Around At The Factory
+                    int returnLane = LaneCell(agent.cursor, -1);
+                    if (laneOccupancy[returnLane] + reservations.Reserved(returnLane, currentTick + 1) <
+                        TRAFFIC_DEPOT_CAPACITY) {
+                        reservations.Reserve(returnLane, currentTick + 1);
+                        MoveLane(currentLane, returnLane);
+                        agent.direction = -1;
+                        agent.progress = 0;
+                        agent.serviceTicks = TRAFFIC_SERVICE_TICKS;
+                    } else {
+                        agent.progress = 1.0f;
+                        agent.waiting = true;
+                    }
+                } else if (TryEnter(agent.direction > 0 ? ++next : --next, agent.direction)) {
+                    MoveLane(currentLane, LaneCell(next, agent.direction));
+                    agent.cursor = next;
+                    agent.progress = 0;
+                } else {
+                    agent.progress = 1.0f;
+                    agent.waiting = true;
+                }
+            }
+            waitingCount += agent.waiting;
+        }
+
+        for (const pair<int, int> &laneMove: pendingLaneMoves) {
+            laneOccupancy[laneMove.first]--;
+            laneOccupancy[laneMove.second]++;
+        }
+        pendingLaneMoves.clear();
+
+        // Hash Indices Stay Valid Until Every Vehicle Moved, so finished trips are dropped afterwards
+        for (int i = 0; i < (int) agents.size(); i++) {
+            if (agents[i].finished) {
+                RemoveAgent(i);
+                i--;
+            }
+        }
+
+        // Exponential Moving Average Of The Share Of Vehicles Held Up, About One Second Long
+        double sample = agentCount > 0 ? (double) waitingCount / agentCount : 0;
+        congestionIndex += (sample - congestionIndex) / TRAFFIC_TICK_RATE;
+    }
+
+public:
+    /**
+     * TrafficSimulator() Default Constructor For A Traffic Simulator
+     *
+     * @param rows Integer Grid Rows
+     * @param cols Integer Grid Columns
+     */
+    TrafficSimulator(int rows = NROWS, int cols = NCOLS) {
+        gridRows = rows;
+        gridCols = cols;
+        laneOccupancy.assign(rows * cols * 2, 0);
+        reservations.Resize(rows * cols * 2);
+    }
+
+    /**
+     * Reserve() Size The Per-Vehicle Storage Up Front, so traffic up to that many vehicles ticks without allocating
+     *
+     * @param agentCapacity Integer Most Vehicles Expected
+     */
+    void Reserve(int agentCapacity) {
+        agents.reserve(agentCapacity);
+        agentLaneCells.reserve(agentCapacity);
+        pendingLaneMoves.reserve(agentCapacity);
+        reservations.ReserveTouched(agentCapacity);
+        agentHash.Reserve(agentCapacity);
+    }
+
+    /**
+     * AddRoad() Register A Linked Road
+     *
+     * @param key String Road Hash Key
+     * @param path PathView Encoded Path, house first and factory last; the codes must outlive the road
+     * @param color Vec3 Road Color
+     */
+    void AddRoad(const pmr::string &key, const PathView &path, const vec3 &color) {
+        RemoveRoad(key);
+        int roadIndex = (int) roads.size();
+        if (!freeRoads.empty()) {
+            roadIndex = freeRoads.back();
+            freeRoads.pop_back();
+        } else {
+            roads.emplace_back();
+        }
+        TrafficRoad &road = roads[roadIndex];
+        road.path = path;
+        road.color = color;
+        road.dispatchTicks = 1;
+        road.agentCount = 0;
+        road.alive = true;
+        roadIndexByKey[key] = roadIndex;
+    }
+
+    /**
+     * RemoveRoad() Unregister A Wiped Road Along With Its Vehicles
+     *
+     * @param key String Road Hash Key
+     */
+    void RemoveRoad(const pmr::string &key) {
+        auto findRoad = roadIndexByKey.find(key);
+        if (findRoad == roadIndexByKey.end()) {
+            return;
+        }
+        int roadIndex = findRoad->second;
+        for (int i = 0; i < (int) agents.size(); i++) {
+            if (agents[i].roadIndex == roadIndex) {
+                RemoveAgent(i);
+                i--;
+            }
+        }
+        roads[roadIndex].alive = false;
+        roads[roadIndex].path = PathView();
+        freeRoads.push_back(roadIndex);
+        roadIndexByKey.erase(findRoad);
+    }
+
+    /**
+     * Clear() Remove Every Road And Vehicle, arena-backed storage is handed back so the arena can be released
+     */
+    void Clear() {
+        pmr::vector<TrafficRoad>(GAME_ARENA.Resource()).swap(roads);
+        pmr::vector<int>(GAME_ARENA.Resource()).swap(freeRoads);
+        pmr::unordered_map<pmr::string, int>(GAME_ARENA.Resource()).swap(roadIndexByKey);
+        agents.clear();
+        laneOccupancy.assign(laneOccupancy.size(), 0);
+        reservations.Resize((int) laneOccupancy.size());
+        tickAccumulator = 0;
+        congestionIndex = 0;
+        completedTrips = 0;
+    }
+
+    /**
+     * Update() Run As Many Fixed Ticks As The Elapsed Time Requires
+     *
+     * @param dt Float Elapsed Seconds
+     */
+    void Update(float dt) {
+        float tickLength = 1.0f / TRAFFIC_TICK_RATE;
+        tickAccumulator += dt;
+        int ticks = 0;
+        while (tickAccumulator >= tickLength && ticks < TRAFFIC_MAX_TICKS_PER_FRAME) {
+            Tick();
+            tickAccumulator -= tickLength;
+            ticks++;
+        }
+        if (ticks == TRAFFIC_MAX_TICKS_PER_FRAME) {
+            tickAccumulator = 0;
+        }
+    }
+
+    /**
+     * CollectDots() Position Of Every Vehicle Between Its Current And Next Cell
+     *
+     * @param dots TrafficDot Collection Output, cleared first
+     */
+    void CollectDots(vector<TrafficDot> &dots) const {
+        dots.clear();
+        for (const TrafficAgent &agent: agents) {
+            const TrafficRoad &road = roads[agent.roadIndex];
+            PathCursor next = agent.cursor;
+            bool atEnd = agent.direction > 0 ? agent.cursor.IsLast() : agent.cursor.IsFirst();
+            if (!atEnd) {
+                agent.direction > 0 ? ++next : --next;
+            }
+            TrafficDot dot;
+            dot.col = agent.cursor.col + agent.progress * (next.col - agent.cursor.col);
+            dot.row = agent.cursor.row + agent.progress * (next.row - agent.cursor.row);
+            dot.color = agent.waiting ? road.color * 0.5f : road.color;
+            dots.push_back(dot);
+        }
+    }
+
+    /**
+     * CongestionIndex() Smoothed Share Of Vehicles Currently Held Up, between 0 and 1
+     *
+     * @return Double Congestion
+     */
+    double CongestionIndex() const { return congestionIndex; }
+
+    /**
+     * AgentCount() Number Of Vehicles On The Roads
+     *
+     * @return Integer Count
+     */
+    int AgentCount() const { return (int) agents.size(); }
+
+    /**
+     * CompletedTrips() Number Of House-Factory-House Trips Finished
+     *
+     * @return Long Count
+     */
+    long long CompletedTrips() const { return completedTrips; }
+};
+
+#endif //ROADREALM_TRAFFIC_H